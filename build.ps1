@@ -24,7 +24,7 @@ function Require-Command([string]$Name)
 
 $repoRoot = Split-Path -Parent $MyInvocation.MyCommand.Path
 
-$cppFlags = @('-std=c++17')
+$cppFlags = @('-std=c++17','-pthread')
 if ($Config -eq 'Debug')
 {
   $cppFlags += @('-g','-O0')
@@ -36,7 +36,7 @@ else
 
 if ($Target -in @('all','cpp'))
 {
-  Invoke-Step "Build C++ app + tests ($Config)" {
+  Invoke-Step "Build C++ app + tests + apps ($Config)" {
     Require-Command 'g++'
 
     Push-Location (Join-Path $repoRoot 'nm-lib')
@@ -46,13 +46,30 @@ if ($Target -in @('all','cpp'))
       {
         New-Item -ItemType Directory -Force -Path '.\bin\tests' | Out-Null
       }
+      if (-not (Test-Path '.\bin\apps'))
+      {
+        New-Item -ItemType Directory -Force -Path '.\bin\apps' | Out-Null
+      }
+      if (-not (Test-Path '.\bin\bench'))
+      {
+        New-Item -ItemType Directory -Force -Path '.\bin\bench' | Out-Null
+      }
+
+      & g++ @cppFlags -Iinclude -Isrc -o app.exe main.cpp src/core/*.cpp src/linear/*.cpp src/nonlinear/*.cpp src/service/*.cpp src/utils/*.cpp
+
+      & g++ @cppFlags -Iinclude -Isrc -o .\bin\tests\tema1_rootfinding.exe .\tests\tema1_rootfinding.cpp src/core/*.cpp src/linear/*.cpp src/nonlinear/*.cpp src/service/*.cpp src/utils/*.cpp
+      & g++ @cppFlags -Iinclude -Isrc -o .\bin\tests\tema2_gauss.exe .\tests\tema2_gauss.cpp src/core/*.cpp src/linear/*.cpp src/nonlinear/*.cpp src/service/*.cpp src/utils/*.cpp
+      & g++ @cppFlags -Iinclude -Isrc -o .\bin\tests\tema3_iterative.exe .\tests\tema3_iterative.cpp src/core/*.cpp src/linear/*.cpp src/nonlinear/*.cpp src/service/*.cpp src/utils/*.cpp
+      & g++ @cppFlags -Iinclude -Isrc -o .\bin\tests\tema4_newton_systems.exe .\tests\tema4_newton_systems.cpp src/core/*.cpp src/linear/*.cpp src/nonlinear/*.cpp src/service/*.cpp src/utils/*.cpp
 
-      & g++ @cppFlags -Iinclude -Isrc -o app.exe main.cpp src/core/*.cpp src/linear/*.cpp src/nonlinear/*.cpp src/utils/*.cpp
+      & g++ @cppFlags -Iinclude -Isrc -o .\bin\apps\solver_worker.exe .\apps\solver_worker.cpp src/core/*.cpp src/linear/*.cpp src/nonlinear/*.cpp src/service/*.cpp src/utils/*.cpp
+      # Linux-only programs; on Windows they build to a stub that says so.
+      & g++ @cppFlags -Iinclude -Isrc -o .\bin\apps\solve_server.exe .\apps\solve_server.cpp src/core/*.cpp src/linear/*.cpp src/nonlinear/*.cpp src/service/*.cpp src/utils/*.cpp
+      & g++ @cppFlags -Iinclude -o .\bin\apps\solve_loopback.exe .\apps\solve_loopback.cpp
 
-      & g++ @cppFlags -Iinclude -Isrc -o .\bin\tests\tema1_rootfinding.exe .\tests\tema1_rootfinding.cpp src/core/*.cpp src/linear/*.cpp src/nonlinear/*.cpp src/utils/*.cpp
-      & g++ @cppFlags -Iinclude -Isrc -o .\bin\tests\tema2_gauss.exe .\tests\tema2_gauss.cpp src/core/*.cpp src/linear/*.cpp src/nonlinear/*.cpp src/utils/*.cpp
-      & g++ @cppFlags -Iinclude -Isrc -o .\bin\tests\tema3_iterative.exe .\tests\tema3_iterative.cpp src/core/*.cpp src/linear/*.cpp src/nonlinear/*.cpp src/utils/*.cpp
-      & g++ @cppFlags -Iinclude -Isrc -o .\bin\tests\tema4_newton_systems.exe .\tests\tema4_newton_systems.cpp src/core/*.cpp src/linear/*.cpp src/nonlinear/*.cpp src/utils/*.cpp
+      & g++ @cppFlags -Iinclude -Isrc -o .\bin\bench\scalar_types.exe .\bench\scalar_types.cpp src/core/*.cpp src/linear/*.cpp src/utils/*.cpp
+      & g++ @cppFlags -Iinclude -Isrc -o .\bin\bench\solvers.exe .\bench\solvers.cpp src/core/*.cpp src/linear/*.cpp src/nonlinear/*.cpp src/utils/*.cpp
+      & g++ @cppFlags -Iinclude -o .\bin\bench\regressions.exe .\bench\regressions.cpp
     }
     finally
     {
@@ -0,0 +1,352 @@
+#include "nlohmann/json.hpp"
+
+#include <iostream>
+#include <string>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#endif
+
+using nlohmann::json;
+
+// Loopback client for solve_server: a load generator and a protocol check.
+//
+//   solve_loopback [--host 127.0.0.1] [--port 8080] [--connections 8] [--requests 20000]
+//                  [--pipeline 16] [--path "/api/rootfinding/trace?eq=1&interval=1&trace=false"]
+//     keeps `connections` keep-alive connections busy, each sending `pipeline`
+//     requests per write, and prints requests/second; non-200 answers count as failures.
+//   solve_loopback --check [--host ..] [--port ..]
+//     pipelines one request per endpoint (plus rejected ones) on a single
+//     connection and checks the statuses, their order and the payload kinds.
+// Exits 1 when a request fails.
+
+#if defined(__linux__)
+
+namespace
+{
+    struct Reply
+    {
+        int status = 0;
+        std::string body;
+    };
+
+    class Connection {
+    private:
+        int fd;
+        std::string buffer;
+
+    public:
+        Connection(const std::string& host, int port)
+            : fd(socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0))
+        {
+            if (fd < 0)
+            {
+                throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+            }
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(static_cast<std::uint16_t>(port));
+            if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1
+                || connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0)
+            {
+                const std::string error = std::strerror(errno);
+                ::close(fd);
+                throw std::runtime_error("Cannot connect to " + host + ":" + std::to_string(port) + ": " + error);
+            }
+            const int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+
+        ~Connection()
+        {
+            ::close(fd);
+        }
+
+        Connection(const Connection&) = delete;
+        Connection& operator=(const Connection&) = delete;
+
+        void send(const std::string& bytes)
+        {
+            std::size_t sent = 0;
+            while (sent < bytes.size())
+            {
+                const ssize_t n = ::send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+                if (n < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (n <= 0)
+                {
+                    throw std::runtime_error(std::string("send: ") + std::strerror(errno));
+                }
+                sent += static_cast<std::size_t>(n);
+            }
+        }
+
+        // Reads one response (Content-Length framed, as solve_server answers).
+        Reply receive()
+        {
+            for (;;)
+            {
+                const std::size_t headerEnd = buffer.find("\r\n\r\n");
+                if (headerEnd != std::string::npos)
+                {
+                    Reply reply;
+                    reply.status = std::atoi(buffer.c_str() + buffer.find(' ') + 1);
+                    std::size_t length = 0;
+                    const std::size_t at = buffer.find("Content-Length:");
+                    if (at != std::string::npos && at < headerEnd)
+                    {
+                        length = static_cast<std::size_t>(std::strtoull(buffer.c_str() + at + 15, nullptr, 10));
+                    }
+                    if (buffer.size() >= headerEnd + 4 + length)
+                    {
+                        reply.body = buffer.substr(headerEnd + 4, length);
+                        buffer.erase(0, headerEnd + 4 + length);
+                        return reply;
+                    }
+                }
+
+                char chunk[64 * 1024];
+                const ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+                if (n < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (n <= 0)
+                {
+                    throw std::runtime_error("Connection closed by the server.");
+                }
+                buffer.append(chunk, static_cast<std::size_t>(n));
+            }
+        }
+    };
+
+    std::string get(const std::string& path)
+    {
+        return "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    }
+
+    std::string post(const std::string& path, const std::string& body)
+    {
+        return "POST " + path + " HTTP/1.1\r\nHost: localhost\r\nContent-Type: application/json\r\nContent-Length: "
+            + std::to_string(body.size()) + "\r\n\r\n" + body;
+    }
+
+    int runCheck(const std::string& host, int port)
+    {
+        struct Case
+        {
+            std::string request;
+            int status;
+            const char* kind; // expected "kind" of a 200 payload, if any
+            const char* absent = nullptr; // key the payload must not have
+        };
+        // A slow solve first, so quicker ones finish before it and must wait for their turn.
+        const std::vector<Case> cases = {
+            { get("/api/rootfinding/trace?eq=3&interval=1&eps=1e-15&trace=true"), 200, "rootfinding" },
+            { get("/api/health"), 200, nullptr },
+            { get("/api/gauss?system=2&trace=false"), 200, "gauss" },
+            { get("/api/iterative?system=1&iterations=5"), 200, "iterative" },
+            { get("/api/newton-systems?system=2"), 200, "newton_systems" },
+            { post("/api/rootfinding/trace", R"({"eq":4,"interval":2,"trace":false,"mode":"race"})"), 200, "rootfinding" },
+            // Must not start a million threads: the server ignores mode and threads.
+            { get("/api/rootfinding/trace?eq=2&mode=parallel&threads=1000000&trace=false"), 200, "rootfinding", "mode" },
+            { post("/api/rootfinding/batch", R"({"requests":[{"eq":3,"mode":"race","threads":1e12}]})"), 200, nullptr },
+            { post("/api/rootfinding/batch", R"({"requests":[{"eq":1},{"eq":1,"a":-1,"b":1}]})"), 200, nullptr },
+            { get("/api/rootfinding/trace?eq=1&eps=-1"), 400, nullptr },
+            { get("/api/gauss?system=9"), 400, nullptr },
+            { post("/api/newton-systems", "{not json"), 400, nullptr },
+            { get("/api/rootfinding/batch"), 405, nullptr },
+            { get("/nope"), 404, nullptr },
+        };
+
+        Connection c(host, port);
+        std::string pipelined;
+        for (const Case& k : cases)
+        {
+            pipelined += k.request;
+        }
+        c.send(pipelined);
+
+        int failures = 0;
+        for (std::size_t i = 0; i < cases.size(); i++)
+        {
+            const Reply reply = c.receive();
+            std::string problem;
+            json body;
+            try
+            {
+                body = json::parse(reply.body);
+            }
+            catch (const json::exception&)
+            {
+                problem = "body is not JSON";
+            }
+            if (problem.empty() && reply.status != cases[i].status)
+            {
+                problem = "status " + std::to_string(reply.status) + ", expected " + std::to_string(cases[i].status);
+            }
+            if (problem.empty() && cases[i].kind && body.value("kind", std::string()) != cases[i].kind)
+            {
+                problem = std::string("kind is not ") + cases[i].kind;
+            }
+            if (problem.empty() && cases[i].absent && body.contains(cases[i].absent))
+            {
+                problem = std::string("payload has ") + cases[i].absent;
+            }
+            if (problem.empty() && reply.status != 200 && !body.contains("error"))
+            {
+                problem = "no error message";
+            }
+            std::cout << (problem.empty() ? "ok   " : "FAIL ") << reply.status << "  "
+                      << cases[i].request.substr(0, cases[i].request.find(" HTTP/1.1")) << (problem.empty() ? "" : "  (" + problem + ")")
+                      << "\n";
+            failures += problem.empty() ? 0 : 1;
+        }
+
+        std::cout << (failures == 0 ? "CHECK OK" : "CHECK FAILED") << "\n";
+        return failures == 0 ? 0 : 1;
+    }
+
+    int runLoad(const std::string& host, int port, int connections, long requests, int pipeline, const std::string& path)
+    {
+        const std::string request = get(path);
+        std::atomic<long> done{ 0 };
+        std::atomic<long> failed{ 0 };
+        std::atomic<bool> broken{ false };
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < connections; t++)
+        {
+            const long share = requests / connections + (t < requests % connections ? 1 : 0);
+            workers.emplace_back([&, share]() {
+                try
+                {
+                    Connection c(host, port);
+                    std::string burst;
+                    for (long left = share; left > 0;)
+                    {
+                        const int n = static_cast<int>(std::min<long>(left, pipeline));
+                        burst.clear();
+                        for (int i = 0; i < n; i++)
+                        {
+                            burst += request;
+                        }
+                        c.send(burst);
+                        for (int i = 0; i < n; i++)
+                        {
+                            if (c.receive().status != 200)
+                            {
+                                failed++;
+                            }
+                        }
+                        done += n;
+                        left -= n;
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << e.what() << "\n";
+                    broken = true;
+                }
+            });
+        }
+        for (std::thread& w : workers)
+        {
+            w.join();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << done.load() << " requests on " << connections << " connections (pipeline " << pipeline << ") in "
+                  << seconds << " s: " << static_cast<long>(done.load() / seconds) << " req/s, " << failed.load()
+                  << " failed\n";
+        return failed.load() == 0 && !broken ? 0 : 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string host = "127.0.0.1";
+    int port = 8080;
+    int connections = 8;
+    long requests = 20000;
+    int pipeline = 16;
+    std::string path = "/api/rootfinding/trace?eq=1&interval=1&trace=false";
+    bool check = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string flag = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (flag == "--check")
+        {
+            check = true;
+        }
+        else if (flag == "--host" && hasValue)
+        {
+            host = argv[++i];
+        }
+        else if (flag == "--port" && hasValue)
+        {
+            port = std::atoi(argv[++i]);
+        }
+        else if (flag == "--connections" && hasValue)
+        {
+            connections = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (flag == "--requests" && hasValue)
+        {
+            requests = std::max(1L, std::atol(argv[++i]));
+        }
+        else if (flag == "--pipeline" && hasValue)
+        {
+            pipeline = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (flag == "--path" && hasValue)
+        {
+            path = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Usage: solve_loopback [--check] [--host <ip>] [--port <n>] [--connections <n>] "
+                         "[--requests <n>] [--pipeline <n>] [--path <target>]\n";
+            return 2;
+        }
+    }
+
+    try
+    {
+        return check ? runCheck(host, port) : runLoad(host, port, connections, requests, pipeline, path);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}
+
+#else
+
+int main()
+{
+    std::cerr << "solve_loopback needs Linux sockets.\n";
+    return 1;
+}
+
+#endif
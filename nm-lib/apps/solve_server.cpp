@@ -0,0 +1,1065 @@
+#include "service/LinearSystemsService.h"
+#include "service/NewtonSystemsService.h"
+#include "service/RootFindingService.h"
+
+#include "utils/Exceptions.h"
+#include "utils/JsonWriter.h"
+#include "utils/ThreadPool.h"
+
+#include "nlohmann/json.hpp"
+
+#include <iostream>
+#include <string>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#endif
+
+using nlohmann::json;
+
+// Standalone HTTP/1.1 solve service (Linux, epoll), for deployments without Node.
+//
+//   solve_server [--host 127.0.0.1] [--port 8080] [--threads <n>]
+//
+// One thread runs the epoll loop: it accepts connections, parses requests and
+// writes responses. Solves run on a fixed ThreadPool (--threads, default one
+// per hardware thread). Connections are kept alive (HTTP/1.1 default, or
+// "Connection: keep-alive" from HTTP/1.0) and may pipeline requests; responses
+// go out in request order even when the solves finish out of order.
+//
+// Endpoints answer JSON. Parameters come from the query string (GET) or a JSON
+// object body (POST); query values are read as numbers, true/false or strings.
+//   GET  /api/health
+//   /api/rootfinding/trace      RootFindingService keys    = tema1_rootfinding --json
+//   POST /api/rootfinding/batch { "requests": [...] }       = tema1_rootfinding --batch
+//   /api/gauss                  system, trace, significantDigits = tema2_gauss --json
+//   /api/iterative              system, trace, iterations  = tema3_iterative --json
+//   /api/newton-systems         system, trace, eps         = tema4_newton_systems --json
+// Rejected parameters and solver failures answer 400 { "error": "..." }.
+// SIGINT / SIGTERM stop the loop; solves already queued still finish.
+
+#if defined(__linux__)
+
+namespace
+{
+    constexpr std::size_t kMaxHeaderBytes = 16 * 1024;
+    constexpr std::size_t kMaxBodyBytes = 1024 * 1024;
+    // Requests parsed ahead of their responses on one connection; reading
+    // pauses beyond this so a client cannot queue unbounded work.
+    constexpr std::size_t kMaxPipelined = 64;
+    constexpr std::size_t kMaxBatch = 64;
+    // Unparsed input kept per connection; a read stops early beyond it.
+    constexpr std::size_t kMaxBuffered = 4 * 1024 * 1024;
+
+    struct HttpRequest
+    {
+        std::string method;
+        std::string path;
+        json query = json::object();
+        std::string body;
+        bool keepAlive = true;
+        bool http10 = false;
+    };
+
+    struct HttpResponse
+    {
+        int status = 200;
+        std::string body;
+        bool close = false;
+        // HTTP/1.0 clients only keep the connection when told so.
+        bool announceKeepAlive = false;
+    };
+
+    enum class ParseStatus
+    {
+        Incomplete,
+        Complete,
+        Invalid
+    };
+
+    struct ParseResult
+    {
+        ParseStatus status;
+        std::size_t consumed;
+        int errorStatus;
+        std::string error;
+    };
+
+    const char* statusText(int status)
+    {
+        switch (status)
+        {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 501: return "Not Implemented";
+        case 505: return "HTTP Version Not Supported";
+        default: return "Internal Server Error";
+        }
+    }
+
+    void appendResponse(std::string& out, const HttpResponse& r)
+    {
+        out += "HTTP/1.1 ";
+        out += std::to_string(r.status);
+        out += ' ';
+        out += statusText(r.status);
+        out += "\r\nContent-Type: application/json\r\nContent-Length: ";
+        out += std::to_string(r.body.size());
+        out += "\r\n";
+        if (r.close)
+        {
+            out += "Connection: close\r\n";
+        }
+        else if (r.announceKeepAlive)
+        {
+            out += "Connection: keep-alive\r\n";
+        }
+        out += "\r\n";
+        out += r.body;
+    }
+
+    HttpResponse errorResponse(int status, const std::string& message)
+    {
+        std::ostringstream body;
+        JsonWriter w(body);
+        w.beginObject();
+        w.field("error", message);
+        w.endObject();
+        w.flush();
+        return { status, body.str(), false, false };
+    }
+
+    bool equalsIgnoreCase(const std::string& a, const char* b)
+    {
+        const std::size_t n = std::strlen(b);
+        if (a.size() != n)
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < n; i++)
+        {
+            if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool containsToken(const std::string& value, const char* token)
+    {
+        std::string lower(value);
+        for (char& c : lower)
+        {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return lower.find(token) != std::string::npos;
+    }
+
+    std::string trim(const std::string& s)
+    {
+        std::size_t begin = 0;
+        std::size_t end = s.size();
+        while (begin < end && (s[begin] == ' ' || s[begin] == '\t'))
+        {
+            begin++;
+        }
+        while (end > begin && (s[end - 1] == ' ' || s[end - 1] == '\t' || s[end - 1] == '\r'))
+        {
+            end--;
+        }
+        return s.substr(begin, end - begin);
+    }
+
+    int hexDigit(char c)
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    std::string percentDecode(const std::string& s)
+    {
+        std::string out;
+        out.reserve(s.size());
+        for (std::size_t i = 0; i < s.size(); i++)
+        {
+            if (s[i] == '+')
+            {
+                out += ' ';
+            }
+            else if (s[i] == '%' && i + 2 < s.size() && hexDigit(s[i + 1]) >= 0 && hexDigit(s[i + 2]) >= 0)
+            {
+                out += static_cast<char>(hexDigit(s[i + 1]) * 16 + hexDigit(s[i + 2]));
+                i += 2;
+            }
+            else
+            {
+                out += s[i];
+            }
+        }
+        return out;
+    }
+
+    // Query values have no types: numbers and true/false are recognised, the
+    // rest stays a string (so the services report e.g. "Must be a number").
+    json queryValue(const std::string& text)
+    {
+        if (text == "true")
+        {
+            return true;
+        }
+        if (text == "false")
+        {
+            return false;
+        }
+        if (!text.empty())
+        {
+            char* end = nullptr;
+            const double v = std::strtod(text.c_str(), &end);
+            if (end == text.c_str() + text.size())
+            {
+                return v;
+            }
+        }
+        return text;
+    }
+
+    void parseTarget(const std::string& target, HttpRequest& request)
+    {
+        const std::size_t q = target.find('?');
+        request.path = percentDecode(target.substr(0, q));
+        if (q == std::string::npos)
+        {
+            return;
+        }
+
+        std::size_t start = q + 1;
+        while (start <= target.size())
+        {
+            std::size_t amp = target.find('&', start);
+            if (amp == std::string::npos)
+            {
+                amp = target.size();
+            }
+            const std::string pair = target.substr(start, amp - start);
+            if (!pair.empty())
+            {
+                const std::size_t eq = pair.find('=');
+                const std::string key = percentDecode(pair.substr(0, eq));
+                const std::string value = eq == std::string::npos ? std::string() : percentDecode(pair.substr(eq + 1));
+                request.query[key] = queryValue(value);
+            }
+            start = amp + 1;
+        }
+    }
+
+    // Parses one request starting at `offset`. Complete requests report how
+    // many bytes they used; Invalid ones the status to answer before closing.
+    ParseResult parseHttpRequest(const std::string& in, std::size_t offset, HttpRequest& request)
+    {
+        const std::size_t headerEnd = in.find("\r\n\r\n", offset);
+        if (headerEnd == std::string::npos)
+        {
+            if (in.size() - offset > kMaxHeaderBytes)
+            {
+                return { ParseStatus::Invalid, 0, 431, "Request headers too large." };
+            }
+            return { ParseStatus::Incomplete, 0, 0, {} };
+        }
+        if (headerEnd - offset > kMaxHeaderBytes)
+        {
+            return { ParseStatus::Invalid, 0, 431, "Request headers too large." };
+        }
+
+        std::size_t lineEnd = in.find("\r\n", offset);
+        const std::string requestLine = in.substr(offset, lineEnd - offset);
+        const std::size_t sp1 = requestLine.find(' ');
+        const std::size_t sp2 = sp1 == std::string::npos ? std::string::npos : requestLine.find(' ', sp1 + 1);
+        if (sp2 == std::string::npos)
+        {
+            return { ParseStatus::Invalid, 0, 400, "Malformed request line." };
+        }
+        request.method = requestLine.substr(0, sp1);
+        const std::string target = requestLine.substr(sp1 + 1, sp2 - sp1 - 1);
+        const std::string version = requestLine.substr(sp2 + 1);
+        if (version == "HTTP/1.0")
+        {
+            request.http10 = true;
+            request.keepAlive = false;
+        }
+        else if (version != "HTTP/1.1")
+        {
+            return { ParseStatus::Invalid, 0, 505, "Only HTTP/1.0 and HTTP/1.1 are supported." };
+        }
+        parseTarget(target, request);
+
+        std::size_t contentLength = 0;
+        std::size_t pos = lineEnd + 2;
+        while (pos < headerEnd + 2)
+        {
+            lineEnd = in.find("\r\n", pos);
+            const std::string line = in.substr(pos, lineEnd - pos);
+            pos = lineEnd + 2;
+            const std::size_t colon = line.find(':');
+            if (colon == std::string::npos)
+            {
+                return { ParseStatus::Invalid, 0, 400, "Malformed header line." };
+            }
+            const std::string name = line.substr(0, colon);
+            const std::string value = trim(line.substr(colon + 1));
+            if (equalsIgnoreCase(name, "Content-Length"))
+            {
+                char* end = nullptr;
+                const unsigned long long n = std::strtoull(value.c_str(), &end, 10);
+                if (value.empty() || end != value.c_str() + value.size())
+                {
+                    return { ParseStatus::Invalid, 0, 400, "Invalid Content-Length." };
+                }
+                if (n > kMaxBodyBytes)
+                {
+                    return { ParseStatus::Invalid, 0, 413, "Request body too large." };
+                }
+                contentLength = static_cast<std::size_t>(n);
+            }
+            else if (equalsIgnoreCase(name, "Transfer-Encoding"))
+            {
+                return { ParseStatus::Invalid, 0, 501, "Chunked request bodies are not supported; send Content-Length." };
+            }
+            else if (equalsIgnoreCase(name, "Connection"))
+            {
+                if (containsToken(value, "close"))
+                {
+                    request.keepAlive = false;
+                }
+                else if (containsToken(value, "keep-alive"))
+                {
+                    request.keepAlive = true;
+                }
+            }
+        }
+
+        const std::size_t bodyStart = headerEnd + 4;
+        if (in.size() - bodyStart < contentLength)
+        {
+            return { ParseStatus::Incomplete, 0, 0, {} };
+        }
+        request.body = in.substr(bodyStart, contentLength);
+        return { ParseStatus::Complete, bodyStart + contentLength - offset, 0, {} };
+    }
+
+    enum class Route
+    {
+        Health,
+        RootFinding,
+        RootFindingBatch,
+        Gauss,
+        Iterative,
+        NewtonSystems,
+        NotFound
+    };
+
+    Route routeOf(const std::string& path)
+    {
+        if (path == "/api/health") return Route::Health;
+        if (path == "/api/rootfinding/trace") return Route::RootFinding;
+        if (path == "/api/rootfinding/batch") return Route::RootFindingBatch;
+        if (path == "/api/gauss") return Route::Gauss;
+        if (path == "/api/iterative") return Route::Iterative;
+        if (path == "/api/newton-systems") return Route::NewtonSystems;
+        return Route::NotFound;
+    }
+
+    // The server's pool is the only concurrency: a client cannot make a
+    // request start threads of its own, so mode and threads are ignored.
+    RootFindingRequest serverRequest(RootFindingRequest request)
+    {
+        request.mode = RootFindingMode::Sequential;
+        request.threads = 0;
+        return request;
+    }
+
+    // Runs one solve endpoint (on a pool thread).
+    HttpResponse solveRoute(Route route, const HttpRequest& request)
+    {
+        try
+        {
+            const json params = request.method == "POST" ? json::parse(request.body) : request.query;
+
+            std::ostringstream body;
+            JsonWriter w(body);
+            switch (route)
+            {
+            case Route::RootFinding:
+                RootFindingService::solve(serverRequest(RootFindingService::parseRequest(params)), w);
+                break;
+            case Route::RootFindingBatch:
+            {
+                const auto requests = params.is_object() ? params.find("requests") : params.end();
+                if (requests == params.end() || !requests->is_array() || requests->empty() || requests->size() > kMaxBatch)
+                {
+                    return errorResponse(400, "Expected { requests: [...] } with 1.." + std::to_string(kMaxBatch) + " parameter sets.");
+                }
+                std::vector<RootFindingRequest> batch = RootFindingService::parseBatch(*requests);
+                for (RootFindingRequest& entry : batch)
+                {
+                    entry = serverRequest(std::move(entry));
+                }
+                w.beginObject();
+                w.key("results");
+                // Already on a pool thread: the batch runs here rather than on
+                // a pool of its own.
+                RootFindingService::solveBatch(batch, w, 1);
+                w.endObject();
+                break;
+            }
+            case Route::Gauss:
+                LinearSystemsService::solveGauss(LinearSystemsService::parseGaussRequest(params), w);
+                break;
+            case Route::Iterative:
+                LinearSystemsService::solveIterative(LinearSystemsService::parseIterativeRequest(params), w);
+                break;
+            case Route::NewtonSystems:
+                NewtonSystemsService::solve(NewtonSystemsService::parseRequest(params), w);
+                break;
+            default:
+                return errorResponse(404, "Not found.");
+            }
+            w.flush();
+            return { 200, body.str(), false, false };
+        }
+        catch (const json::exception& e)
+        {
+            return errorResponse(400, std::string("Malformed JSON body: ") + e.what());
+        }
+        catch (const std::invalid_argument& e)
+        {
+            return errorResponse(400, e.what());
+        }
+        catch (const NumericalException& e)
+        {
+            return errorResponse(400, e.what());
+        }
+        catch (const std::exception& e)
+        {
+            return errorResponse(500, e.what());
+        }
+    }
+
+    class SolveServer {
+    private:
+        static constexpr std::uint64_t kListenId = 0;
+        static constexpr std::uint64_t kWakeId = 1;
+        static constexpr std::uint64_t kSignalId = 2;
+
+        struct Connection
+        {
+            int fd = -1;
+            std::uint32_t events = 0;
+            std::string in;
+            std::string out;
+            std::size_t outOffset = 0;
+            std::uint64_t nextSeq = 0;
+            std::uint64_t nextToSend = 0;
+            // Responses finished ahead of an earlier request on the same connection.
+            std::map<std::uint64_t, HttpResponse> ready;
+            std::size_t inFlight = 0;
+            bool closing = false;        // no more requests are parsed
+            bool closeAfterWrite = false;
+            bool peerClosed = false;
+        };
+
+        struct Completion
+        {
+            std::uint64_t connection;
+            std::uint64_t seq;
+            HttpResponse response;
+        };
+
+        int listenFd;
+        int epollFd;
+        int wakeFd;
+        int signalFd;
+        // Held open so that a connection can still be accepted (and closed) when
+        // the process runs out of descriptors; see acceptAll.
+        int reserveFd;
+        // The listener is unwatched while no descriptor can be freed for it.
+        bool listenerPaused = false;
+        std::uint64_t nextId = 3;
+        std::unordered_map<std::uint64_t, Connection> connections;
+
+        std::mutex completionsMutex;
+        std::vector<Completion> completions;
+
+        // Declared last, so its workers are joined before the completion queue
+        // goes away. The destructor drains it explicitly before closing wakeFd,
+        // which the solves still in the queue write to.
+        ThreadPool pool;
+
+        void watch(int fd, std::uint64_t id, std::uint32_t events)
+        {
+            epoll_event ev{};
+            ev.events = events;
+            ev.data.u64 = id;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0)
+            {
+                throw std::runtime_error(std::string("epoll_ctl: ") + std::strerror(errno));
+            }
+        }
+
+        void acceptAll()
+        {
+            for (;;)
+            {
+                const int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0)
+                {
+                    if (errno == EINTR || errno == ECONNABORTED)
+                    {
+                        continue;
+                    }
+                    if (errno == EMFILE || errno == ENFILE)
+                    {
+                        // The listener is level-triggered: leaving the connection
+                        // pending would wake epoll_wait again at once. Shed it
+                        // through the reserve descriptor, or stop listening until
+                        // a connection closes if there is none to spare.
+                        if (reserveFd >= 0)
+                        {
+                            ::close(reserveFd);
+                            const int shed = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+                            if (shed >= 0)
+                            {
+                                ::close(shed);
+                            }
+                            reserveFd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+                            if (shed >= 0)
+                            {
+                                continue;
+                            }
+                        }
+                        pauseListener(true);
+                    }
+                    // EAGAIN: backlog drained.
+                    return;
+                }
+                const int one = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+                const std::uint64_t id = nextId++;
+                Connection& c = connections[id];
+                c.fd = fd;
+                c.events = EPOLLIN;
+                watch(fd, id, c.events);
+            }
+        }
+
+        void pauseListener(bool paused)
+        {
+            if (paused == listenerPaused)
+            {
+                return;
+            }
+            epoll_event ev{};
+            ev.events = paused ? 0u : static_cast<std::uint32_t>(EPOLLIN);
+            ev.data.u64 = kListenId;
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, listenFd, &ev);
+            listenerPaused = paused;
+        }
+
+        void closeConnection(std::uint64_t id)
+        {
+            const auto it = connections.find(id);
+            if (it == connections.end())
+            {
+                return;
+            }
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, it->second.fd, nullptr);
+            ::close(it->second.fd);
+            connections.erase(it);
+            if (listenerPaused)
+            {
+                if (reserveFd < 0)
+                {
+                    reserveFd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+                }
+                pauseListener(false);
+            }
+        }
+
+        void updateInterest(std::uint64_t id, Connection& c)
+        {
+            const bool reading = !c.peerClosed && !c.closing && c.inFlight < kMaxPipelined;
+            const bool writing = c.outOffset < c.out.size();
+            const std::uint32_t events = (reading ? EPOLLIN : 0u) | (writing ? EPOLLOUT : 0u);
+            if (events != c.events)
+            {
+                epoll_event ev{};
+                ev.events = events;
+                ev.data.u64 = id;
+                epoll_ctl(epollFd, EPOLL_CTL_MOD, c.fd, &ev);
+                c.events = events;
+            }
+        }
+
+        // Writes what is pending; returns false when the connection was closed.
+        bool flush(std::uint64_t id, Connection& c)
+        {
+            while (c.outOffset < c.out.size())
+            {
+                const ssize_t n = ::send(c.fd, c.out.data() + c.outOffset, c.out.size() - c.outOffset, MSG_NOSIGNAL);
+                if (n > 0)
+                {
+                    c.outOffset += static_cast<std::size_t>(n);
+                    continue;
+                }
+                if (n < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                {
+                    break;
+                }
+                closeConnection(id);
+                return false;
+            }
+            if (c.outOffset == c.out.size())
+            {
+                c.out.clear();
+                c.outOffset = 0;
+                if (c.closeAfterWrite || (c.peerClosed && c.inFlight == 0))
+                {
+                    closeConnection(id);
+                    return false;
+                }
+            }
+            updateInterest(id, c);
+            return true;
+        }
+
+        // Queues a finished response and moves every response that is now in
+        // request order to the output buffer.
+        void complete(Connection& c, std::uint64_t seq, HttpResponse response)
+        {
+            c.ready.emplace(seq, std::move(response));
+            for (auto it = c.ready.begin(); it != c.ready.end() && it->first == c.nextToSend; it = c.ready.erase(it))
+            {
+                if (!c.closeAfterWrite)
+                {
+                    appendResponse(c.out, it->second);
+                    c.closeAfterWrite = it->second.close;
+                }
+                c.nextToSend++;
+                c.inFlight--;
+            }
+        }
+
+        void dispatch(std::uint64_t id, Connection& c, HttpRequest request)
+        {
+            const std::uint64_t seq = c.nextSeq++;
+            c.inFlight++;
+
+            const Route route = routeOf(request.path);
+            const bool post = request.method == "POST";
+            const bool get = request.method == "GET";
+
+            HttpResponse response;
+            bool answered = true;
+            if (route == Route::NotFound)
+            {
+                response = errorResponse(404, "Not found.");
+            }
+            else if (route == Route::Health)
+            {
+                response = get ? HttpResponse{ 200, "{\"ok\":true}", false, false } : errorResponse(405, "Use GET.");
+            }
+            else if (route == Route::RootFindingBatch && !post)
+            {
+                response = errorResponse(405, "Use POST with a JSON body.");
+            }
+            else if (!get && !post)
+            {
+                response = errorResponse(405, "Use GET or POST.");
+            }
+            else
+            {
+                answered = false;
+            }
+
+            if (answered)
+            {
+                response.close = !request.keepAlive;
+                response.announceKeepAlive = request.http10 && request.keepAlive;
+                complete(c, seq, std::move(response));
+                return;
+            }
+
+            pool.submit([this, id, seq, route, request = std::move(request)]() {
+                HttpResponse response = solveRoute(route, request);
+                response.close = !request.keepAlive;
+                response.announceKeepAlive = request.http10 && request.keepAlive;
+                finish({ id, seq, std::move(response) });
+            });
+        }
+
+        // Parses as many buffered requests as the pipelining limit allows.
+        void parseRequests(std::uint64_t id, Connection& c)
+        {
+            std::size_t offset = 0;
+            while (!c.closing && c.inFlight < kMaxPipelined && offset < c.in.size())
+            {
+                HttpRequest request;
+                const ParseResult parsed = parseHttpRequest(c.in, offset, request);
+                if (parsed.status == ParseStatus::Incomplete)
+                {
+                    break;
+                }
+                if (parsed.status == ParseStatus::Invalid)
+                {
+                    // The rest of the stream cannot be framed any more.
+                    HttpResponse response = errorResponse(parsed.errorStatus, parsed.error);
+                    response.close = true;
+                    c.closing = true;
+                    c.inFlight++;
+                    complete(c, c.nextSeq++, std::move(response));
+                    offset = c.in.size();
+                    break;
+                }
+                offset += parsed.consumed;
+                if (!request.keepAlive)
+                {
+                    c.closing = true;
+                }
+                dispatch(id, c, std::move(request));
+            }
+            c.in.erase(0, offset);
+        }
+
+        void onReadable(std::uint64_t id, Connection& c)
+        {
+            char buffer[64 * 1024];
+            for (;;)
+            {
+                const ssize_t n = ::recv(c.fd, buffer, sizeof(buffer), 0);
+                if (n > 0)
+                {
+                    c.in.append(buffer, static_cast<std::size_t>(n));
+                    if (static_cast<std::size_t>(n) < sizeof(buffer) || c.in.size() >= kMaxBuffered)
+                    {
+                        break;
+                    }
+                    continue;
+                }
+                if (n == 0)
+                {
+                    c.peerClosed = true;
+                    break;
+                }
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    break;
+                }
+                closeConnection(id);
+                return;
+            }
+
+            parseRequests(id, c);
+            flush(id, c);
+        }
+
+        void finish(Completion done)
+        {
+            bool wake = false;
+            {
+                std::lock_guard<std::mutex> lock(completionsMutex);
+                wake = completions.empty();
+                completions.push_back(std::move(done));
+            }
+            if (wake)
+            {
+                const std::uint64_t one = 1;
+                ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+                (void)ignored;
+            }
+        }
+
+        void drainCompletions()
+        {
+            std::uint64_t counter = 0;
+            ssize_t ignored = ::read(wakeFd, &counter, sizeof(counter));
+            (void)ignored;
+
+            std::vector<Completion> done;
+            {
+                std::lock_guard<std::mutex> lock(completionsMutex);
+                done.swap(completions);
+            }
+
+            // Group by connection so each one is flushed once per wake-up.
+            std::vector<std::uint64_t> touched;
+            for (Completion& d : done)
+            {
+                const auto it = connections.find(d.connection);
+                if (it == connections.end())
+                {
+                    continue; // the client went away
+                }
+                complete(it->second, d.seq, std::move(d.response));
+                touched.push_back(d.connection);
+            }
+            for (const std::uint64_t id : touched)
+            {
+                const auto it = connections.find(id);
+                if (it == connections.end())
+                {
+                    continue;
+                }
+                // Requests held back by the pipelining limit can go now.
+                if (!it->second.in.empty())
+                {
+                    parseRequests(id, it->second);
+                }
+                flush(id, it->second);
+            }
+        }
+
+    public:
+        SolveServer(int listenFd, int signalFd, std::size_t threads)
+            : listenFd(listenFd), epollFd(epoll_create1(EPOLL_CLOEXEC)), wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+              signalFd(signalFd), reserveFd(::open("/dev/null", O_RDONLY | O_CLOEXEC)), pool(threads)
+        {
+            if (epollFd < 0 || wakeFd < 0)
+            {
+                throw std::runtime_error(std::string("epoll/eventfd: ") + std::strerror(errno));
+            }
+            watch(listenFd, kListenId, EPOLLIN);
+            watch(wakeFd, kWakeId, EPOLLIN);
+            watch(signalFd, kSignalId, EPOLLIN);
+        }
+
+        ~SolveServer()
+        {
+            // Queued solves end in finish(), which writes to wakeFd.
+            pool.wait();
+            for (auto& entry : connections)
+            {
+                ::close(entry.second.fd);
+            }
+            if (reserveFd >= 0)
+            {
+                ::close(reserveFd);
+            }
+            ::close(wakeFd);
+            ::close(epollFd);
+        }
+
+        SolveServer(const SolveServer&) = delete;
+        SolveServer& operator=(const SolveServer&) = delete;
+
+        std::size_t threads() const
+        {
+            return pool.size();
+        }
+
+        // Serves until SIGINT / SIGTERM.
+        void run()
+        {
+            epoll_event events[256];
+            for (;;)
+            {
+                const int n = epoll_wait(epollFd, events, 256, -1);
+                if (n < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    throw std::runtime_error(std::string("epoll_wait: ") + std::strerror(errno));
+                }
+                for (int i = 0; i < n; i++)
+                {
+                    const std::uint64_t id = events[i].data.u64;
+                    const std::uint32_t what = events[i].events;
+                    if (id == kListenId)
+                    {
+                        acceptAll();
+                        continue;
+                    }
+                    if (id == kWakeId)
+                    {
+                        drainCompletions();
+                        continue;
+                    }
+                    if (id == kSignalId)
+                    {
+                        return;
+                    }
+
+                    const auto it = connections.find(id);
+                    if (it == connections.end())
+                    {
+                        continue;
+                    }
+                    if ((what & (EPOLLERR | EPOLLHUP)) && !(what & EPOLLIN))
+                    {
+                        closeConnection(id);
+                        continue;
+                    }
+                    if (what & EPOLLIN)
+                    {
+                        onReadable(id, it->second);
+                    }
+                    else if (what & EPOLLOUT)
+                    {
+                        flush(id, it->second);
+                    }
+                }
+            }
+        }
+    };
+
+    int openListener(const std::string& host, int port)
+    {
+        const int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+        {
+            throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+        }
+        const int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<std::uint16_t>(port));
+        if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1)
+        {
+            ::close(fd);
+            throw std::invalid_argument("Invalid --host (expected an IPv4 address): " + host);
+        }
+        if (bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0)
+        {
+            const std::string error = std::strerror(errno);
+            ::close(fd);
+            throw std::runtime_error("Cannot listen on " + host + ":" + std::to_string(port) + ": " + error);
+        }
+        return fd;
+    }
+
+    int boundPort(int fd)
+    {
+        sockaddr_in addr{};
+        socklen_t len = sizeof(addr);
+        getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+        return ntohs(addr.sin_port);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string host = "127.0.0.1";
+    int port = 8080;
+    std::size_t threads = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string flag = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (flag == "--host" && hasValue)
+        {
+            host = argv[++i];
+        }
+        else if (flag == "--port" && hasValue)
+        {
+            port = std::atoi(argv[++i]);
+            if (port < 0 || port > 65535)
+            {
+                std::cerr << "Invalid --port. Use 0..65535 (0 picks a free port).\n";
+                return 2;
+            }
+        }
+        else if (flag == "--threads" && hasValue)
+        {
+            const int n = std::atoi(argv[++i]);
+            if (n <= 0)
+            {
+                std::cerr << "Invalid --threads. Must be positive.\n";
+                return 2;
+            }
+            threads = static_cast<std::size_t>(n);
+        }
+        else
+        {
+            std::cerr << "Usage: solve_server [--host 127.0.0.1] [--port 8080] [--threads <n>]\n";
+            return 2;
+        }
+    }
+
+    // Blocked before the pool starts, so only the signalfd sees them.
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    try
+    {
+        const int listenFd = openListener(host, port);
+        const int signalFd = signalfd(-1, &stopSignals, SFD_NONBLOCK | SFD_CLOEXEC);
+        {
+            SolveServer server(listenFd, signalFd, threads > 0 ? threads : ThreadPool::defaultThreadCount());
+            std::cout << "solve_server listening on http://" << host << ":" << boundPort(listenFd) << " ("
+                      << server.threads() << " threads)" << std::endl;
+            server.run();
+        }
+        ::close(signalFd);
+        ::close(listenFd);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int main()
+{
+    std::cerr << "solve_server needs Linux (epoll). Use the Node server or solver_worker elsewhere.\n";
+    return 1;
+}
+
+#endif
@@ -0,0 +1,114 @@
+#include "service/RootFindingService.h"
+
+#include "utils/Exceptions.h"
+#include "utils/JsonWriter.h"
+
+#include "nlohmann/json.hpp"
+
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using nlohmann::json;
+
+// Long-lived solver process for the web server's worker pool.
+//
+// Protocol (NDJSON): one JSON object per line on stdin, one per line on stdout.
+//   request:  { "id": <any>, "kind": "rootfinding", "params": { "eq": 4, "interval": 1, ... } }
+//             { "id": <any>, "kind": "rootfinding.batch", "params": [ { "eq": 1, ... }, ... ] }
+//             { "id": <any>, "kind": "ping" }
+//   response: { "id": <same>, "ok": true, "result": { ... } }
+//             (for a batch, "result" is [ { "ok": true, "result": { ... } } | { "ok": false, "error": ".." }, ... ])
+//             { "id": <same>, "ok": false, "error": "<message>" }
+// Requests are answered in order. The process exits on EOF.
+
+// Writes the result value for one request.
+static void handleRequest(const json& request, JsonWriter& w)
+{
+    const std::string kind = request.value("kind", std::string());
+    const json params = request.contains("params") ? request["params"] : json::object();
+
+    if (kind == "rootfinding")
+    {
+        RootFindingService::solve(RootFindingService::parseRequest(params), w);
+        return;
+    }
+    if (kind == "rootfinding.batch")
+    {
+        RootFindingService::solveBatch(RootFindingService::parseBatch(params), w);
+        return;
+    }
+    if (kind == "ping")
+    {
+        w.value("pong");
+        return;
+    }
+
+    throw std::invalid_argument("Unknown request kind: " + kind);
+}
+
+int main()
+{
+    std::ios::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+
+    std::string line;
+    std::ostringstream result;
+    while (std::getline(std::cin, line))
+    {
+        if (line.empty() || line == "\r")
+        {
+            continue;
+        }
+
+        // The result is streamed into a buffer first: a solver error halfway
+        // through must still produce exactly one well-formed response line.
+        std::string id = "null";
+        std::string error;
+        bool ok = false;
+        result.str(std::string());
+        try
+        {
+            const json request = json::parse(line);
+            id = request.value("id", json()).dump();
+            try
+            {
+                JsonWriter w(result);
+                handleRequest(request, w);
+                w.flush();
+                ok = true;
+            }
+            catch (const std::exception& e)
+            {
+                error = e.what();
+            }
+        }
+        catch (const json::exception& e)
+        {
+            error = std::string("Malformed request: ") + e.what();
+        }
+
+        JsonWriter response(std::cout);
+        response.beginObject();
+        response.key("id");
+        response.rawValue(id);
+        response.field("ok", ok);
+        if (ok)
+        {
+            response.key("result");
+            response.rawValue(result.str());
+        }
+        else
+        {
+            response.field("error", error);
+        }
+        response.endObject();
+        response.flush();
+        std::cout << '\n';
+        std::cout.flush();
+    }
+
+    return 0;
+}
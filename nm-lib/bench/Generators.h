@@ -0,0 +1,211 @@
+#pragma once
+
+#include "linear/LinearSystem.h"
+#include "nonlinear/NonlinearSystem.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Dense test problems for the benchmarks, reproducible from a seed. Every
+// linear system has the exact solution (1, ..., 1): b = A * 1.
+enum class ProblemKind
+{
+	// Uniform entries in [-1, 1]: what elimination sees in general.
+	Random,
+	// Random, with |a_ii| above the sum of the row: Jacobi and Gauss-Seidel
+	// converge.
+	DiagonallyDominant,
+	// M^T M / n + I for a random M: symmetric positive definite, where
+	// Gauss-Seidel converges without dominance.
+	Spd,
+	// Diagonally dominant with two diagonals on each side of the main one.
+	Banded,
+	// Diagonally dominant with four off-diagonal nonzeros per row at random
+	// columns (stored dense, like every matrix of the library).
+	Sparse
+};
+
+inline const char* problemName(ProblemKind kind)
+{
+	switch (kind)
+	{
+	case ProblemKind::Random:
+		return "random";
+	case ProblemKind::DiagonallyDominant:
+		return "diagonallyDominant";
+	case ProblemKind::Spd:
+		return "spd";
+	case ProblemKind::Banded:
+		return "banded";
+	case ProblemKind::Sparse:
+		return "sparse";
+	}
+	return "";
+}
+
+inline const std::vector<ProblemKind>& allProblemKinds()
+{
+	static const std::vector<ProblemKind> kinds = {
+		ProblemKind::Random, ProblemKind::DiagonallyDominant, ProblemKind::Spd, ProblemKind::Banded, ProblemKind::Sparse
+	};
+	return kinds;
+}
+
+inline ProblemKind parseProblemKind(const std::string& name)
+{
+	for (const ProblemKind kind : allProblemKinds())
+	{
+		if (name == problemName(kind))
+		{
+			return kind;
+		}
+	}
+	throw std::invalid_argument("Unknown problem: " + name);
+}
+
+// Makes row i strictly dominant: a_ii = sum_{j != i} |a_ij| + 1, signed.
+inline void makeDiagonallyDominant(Matrix& A, std::size_t i)
+{
+	double sum = 0.0;
+	for (std::size_t j = 0; j < A.colCount(); j++)
+	{
+		if (j != i)
+		{
+			sum += std::fabs(A(i, j));
+		}
+	}
+	A(i, i) = A(i, i) < 0.0 ? -(sum + 1.0) : sum + 1.0;
+}
+
+inline LinearSystem makeLinearSystem(ProblemKind kind, std::size_t n, std::uint64_t seed)
+{
+	std::mt19937_64 rng(seed * 0x9E3779B97F4A7C15ull + n);
+	std::uniform_real_distribution<double> entry(-1.0, 1.0);
+
+	Matrix A(n, n);
+	switch (kind)
+	{
+	case ProblemKind::Random:
+	case ProblemKind::DiagonallyDominant:
+		for (std::size_t i = 0; i < n; i++)
+		{
+			for (std::size_t j = 0; j < n; j++)
+			{
+				A(i, j) = entry(rng);
+			}
+			if (kind == ProblemKind::DiagonallyDominant)
+			{
+				makeDiagonallyDominant(A, i);
+			}
+		}
+		break;
+	case ProblemKind::Spd:
+	{
+		Matrix M(n, n);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			for (std::size_t j = 0; j < n; j++)
+			{
+				M(i, j) = entry(rng);
+			}
+		}
+		for (std::size_t i = 0; i < n; i++)
+		{
+			for (std::size_t j = 0; j <= i; j++)
+			{
+				double sum = 0.0;
+				for (std::size_t k = 0; k < n; k++)
+				{
+					sum += M(k, i) * M(k, j);
+				}
+				A(i, j) = sum / static_cast<double>(n) + (i == j ? 1.0 : 0.0);
+				A(j, i) = A(i, j);
+			}
+		}
+		break;
+	}
+	case ProblemKind::Banded:
+		for (std::size_t i = 0; i < n; i++)
+		{
+			for (std::size_t j = i >= 2 ? i - 2 : 0; j < n && j <= i + 2; j++)
+			{
+				A(i, j) = entry(rng);
+			}
+			makeDiagonallyDominant(A, i);
+		}
+		break;
+	case ProblemKind::Sparse:
+	{
+		std::uniform_int_distribution<std::size_t> column(0, n - 1);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			for (std::size_t k = 0; k < 4 && n > 1; k++)
+			{
+				std::size_t j = column(rng);
+				while (j == i)
+				{
+					j = column(rng);
+				}
+				A(i, j) = entry(rng);
+			}
+			makeDiagonallyDominant(A, i);
+		}
+		break;
+	}
+	}
+
+	Vector b(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		double sum = 0.0;
+		for (std::size_t j = 0; j < n; j++)
+		{
+			sum += A(i, j);
+		}
+		b[i] = sum;
+	}
+	return LinearSystem(A, b);
+}
+
+// Broyden's tridiagonal function, a standard Newton test of any size:
+// F_i = (3 - 2 x_i) x_i - x_{i-1} - 2 x_{i+1} + 1 (x_0 = x_{n+1} = 0),
+// solved from x = (-1, ..., -1) in a handful of iterations.
+inline NonlinearSystem broydenTridiagonal()
+{
+	auto F = [](const Vector& x)
+	{
+		const std::size_t n = x.size();
+		Vector f(n);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			const double previous = i > 0 ? x[i - 1] : 0.0;
+			const double next = i + 1 < n ? x[i + 1] : 0.0;
+			f[i] = (3.0 - 2.0 * x[i]) * x[i] - previous - 2.0 * next + 1.0;
+		}
+		return f;
+	};
+	auto J = [](const Vector& x)
+	{
+		const std::size_t n = x.size();
+		Matrix jac(n, n);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			jac(i, i) = 3.0 - 4.0 * x[i];
+			if (i > 0)
+			{
+				jac(i, i - 1) = -1.0;
+			}
+			if (i + 1 < n)
+			{
+				jac(i, i + 1) = -2.0;
+			}
+		}
+		return jac;
+	};
+	return NonlinearSystem(F, J);
+}
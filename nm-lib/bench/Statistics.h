@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+// Summary of repeated timings. The median and its confidence interval are
+// what comparisons should use: timing noise is one-sided (preemption, cache
+// and frequency effects only slow a run down), so the mean and the standard
+// deviation are dragged by outliers while the median is not.
+struct SampleSummary
+{
+	std::size_t count = 0;
+	double min = 0.0;
+	double max = 0.0;
+	double mean = 0.0;
+	double stddev = 0.0;
+	double median = 0.0;
+	// Distribution-free 95% interval for the median: the order statistics at
+	// ranks n/2 -+ 1.96 sqrt(n)/2 (normal approximation of the binomial).
+	// Degenerates to [min, max] below eleven samples.
+	double ciLow = 0.0;
+	double ciHigh = 0.0;
+};
+
+inline double sortedMedian(const std::vector<double>& sorted)
+{
+	const std::size_t n = sorted.size();
+	return n % 2 == 1 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+}
+
+inline SampleSummary summarize(std::vector<double> samples)
+{
+	if (samples.empty())
+	{
+		throw std::invalid_argument("summarize: no samples");
+	}
+	std::sort(samples.begin(), samples.end());
+
+	SampleSummary s;
+	const std::size_t n = samples.size();
+	s.count = n;
+	s.min = samples.front();
+	s.max = samples.back();
+	s.median = sortedMedian(samples);
+
+	double sum = 0.0;
+	for (const double v : samples)
+	{
+		sum += v;
+	}
+	s.mean = sum / static_cast<double>(n);
+	double squares = 0.0;
+	for (const double v : samples)
+	{
+		squares += (v - s.mean) * (v - s.mean);
+	}
+	s.stddev = n > 1 ? std::sqrt(squares / static_cast<double>(n - 1)) : 0.0;
+
+	const double half = 1.96 * std::sqrt(static_cast<double>(n)) / 2.0;
+	const double center = static_cast<double>(n) / 2.0;
+	const long low = static_cast<long>(std::floor(center - half));      // 1-based rank
+	const long high = static_cast<long>(std::ceil(center + half)) + 1;  // 1-based rank
+	s.ciLow = samples[static_cast<std::size_t>(std::max(1L, low) - 1)];
+	s.ciHigh = samples[static_cast<std::size_t>(std::min(static_cast<long>(n), high) - 1)];
+	return s;
+}
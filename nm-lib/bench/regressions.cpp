@@ -0,0 +1,472 @@
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Performance regression check against a committed baseline of the benchmark
+// suite (bench/solvers.cpp):
+//
+//   regressions --run ./bin/bench/solvers [--baseline bench/baseline.json]
+//               [--current current.json] [--tolerance 0.10] [--confirm 1]
+//   regressions --current current.json [--baseline ...]   # compare two files
+//   regressions --run ./bin/bench/solvers --update          # record a new baseline
+//
+// With --run, the suite is run with the configuration stored in the baseline
+// (sizes, threads, repetitions, seed, ...) and its results are written to
+// --current. Each case (solver, problem, size, threads) is then compared by
+// its median time per solve:
+//   regression   the current 95% interval of the median lies entirely above
+//                the baseline's, and the median grew by more than --tolerance;
+//   improvement  the same, downwards;
+//   unchanged    otherwise: the intervals overlap (the difference is within
+//                the noise of either run) or the change is below tolerance.
+// Both conditions are needed: on a quiet machine the intervals are narrow
+// enough to separate a 2% change nobody should act on, and on a noisy one a
+// 30% jump in a single median can be a preemption.
+//
+// A regressed case is rerun --confirm times (only the regressed cases) and
+// reported only if it regresses every time. A case that fails in the current
+// run fails the check too, and so does a baseline case with no current result
+// (a renamed or dropped solver) unless --allow-missing is given. Exit status:
+// 0 when nothing regressed, 1 on regressions or failures, 2 on usage or I/O
+// errors. Everything runs locally; the baseline is only meaningful on the
+// machine (and build) that recorded it.
+
+using nlohmann::json;
+
+namespace
+{
+    struct Options
+    {
+        std::string baselinePath = "bench/baseline.json";
+        std::string currentPath = "bench_current.json";
+        std::string runPath;
+        bool currentGiven = false;
+        double tolerance = 0.10;
+        std::size_t confirm = 1;
+        bool update = false;
+        bool allowMissing = false;
+    };
+
+    // solver, problem, size, threads
+    using CaseKey = std::tuple<std::string, std::string, std::size_t, std::size_t>;
+
+    struct Timing
+    {
+        double median = 0.0;
+        double ciLow = 0.0;
+        double ciHigh = 0.0;
+        std::string failure;
+    };
+
+    enum class Verdict
+    {
+        Unchanged,
+        Improvement,
+        Regression,
+        Failed
+    };
+
+    const char* verdictName(Verdict verdict)
+    {
+        switch (verdict)
+        {
+        case Verdict::Unchanged:
+            return "unchanged";
+        case Verdict::Improvement:
+            return "improvement";
+        case Verdict::Regression:
+            return "REGRESSION";
+        case Verdict::Failed:
+            return "FAILED";
+        }
+        return "";
+    }
+
+    json readJson(const std::string& path)
+    {
+        std::ifstream in(path);
+        if (!in)
+        {
+            throw std::runtime_error("Cannot read " + path);
+        }
+        json doc = json::parse(in);
+        if (doc.value("kind", "") != "benchmark" || !doc.contains("results"))
+        {
+            throw std::runtime_error(path + " is not a benchmark result (bench/solvers --json)");
+        }
+        return doc;
+    }
+
+    std::map<CaseKey, Timing> timings(const json& doc)
+    {
+        std::map<CaseKey, Timing> result;
+        for (const json& r : doc.at("results"))
+        {
+            const CaseKey key{ r.at("solver").get<std::string>(), r.at("problem").get<std::string>(),
+                               r.at("size").get<std::size_t>(), r.at("threads").get<std::size_t>() };
+            Timing t;
+            if (r.contains("failure"))
+            {
+                t.failure = r.at("failure").get<std::string>();
+            }
+            else
+            {
+                const json& seconds = r.at("seconds");
+                t.median = seconds.at("median").get<double>();
+                t.ciLow = seconds.at("ciLow").get<double>();
+                t.ciHigh = seconds.at("ciHigh").get<double>();
+            }
+            result[key] = t;
+        }
+        return result;
+    }
+
+    Verdict classify(const Timing& baseline, const Timing& current, double tolerance)
+    {
+        if (!current.failure.empty())
+        {
+            return Verdict::Failed;
+        }
+        if (!baseline.failure.empty())
+        {
+            return Verdict::Improvement;
+        }
+        const double ratio = current.median / baseline.median;
+        if (current.ciLow > baseline.ciHigh && ratio > 1.0 + tolerance)
+        {
+            return Verdict::Regression;
+        }
+        if (current.ciHigh < baseline.ciLow && ratio < 1.0 / (1.0 + tolerance))
+        {
+            return Verdict::Improvement;
+        }
+        return Verdict::Unchanged;
+    }
+
+    std::string shellQuote(const std::string& s)
+    {
+        std::string quoted = "'";
+        for (const char c : s)
+        {
+            quoted += c == '\'' ? std::string("'\\''") : std::string(1, c);
+        }
+        return quoted + "'";
+    }
+
+    template <typename Items>
+    std::string joinList(const Items& items)
+    {
+        std::string list;
+        for (const auto& item : items)
+        {
+            if (!list.empty())
+            {
+                list += ',';
+            }
+            list += json(item).is_string() ? json(item).get<std::string>() : json(item).dump();
+        }
+        return list;
+    }
+
+    // Runs the suite with the baseline's settings, restricted to `cases` when
+    // given (every combination of their solvers, problems, sizes and threads).
+    json runSuite(const std::string& binary, const json& config, const std::vector<CaseKey>& cases, const std::string& output)
+    {
+        std::string command = shellQuote(binary);
+        auto addFlag = [&](const char* flag, const std::string& value)
+        {
+            if (!value.empty())
+            {
+                command += std::string(" ") + flag + " " + shellQuote(value);
+            }
+        };
+
+        if (cases.empty())
+        {
+            addFlag("--sizes", joinList(config.value("sizes", json::array())));
+            addFlag("--threads", joinList(config.value("threads", json::array())));
+            addFlag("--solvers", joinList(config.value("solvers", json::array())));
+            addFlag("--problems", joinList(config.value("problems", json::array())));
+        }
+        else
+        {
+            std::set<std::string> solvers;
+            std::set<std::string> problems;
+            std::set<std::size_t> sizes;
+            std::set<std::size_t> threads;
+            for (const CaseKey& key : cases)
+            {
+                solvers.insert(std::get<0>(key));
+                problems.insert(std::get<1>(key));
+                sizes.insert(std::get<2>(key));
+                threads.insert(std::get<3>(key));
+            }
+            addFlag("--sizes", joinList(sizes));
+            addFlag("--threads", joinList(threads));
+            addFlag("--solvers", joinList(solvers));
+            addFlag("--problems", joinList(problems));
+        }
+        for (const char* name : { "repetitions", "warmup", "digits", "sweeps", "seed" })
+        {
+            if (config.contains(name))
+            {
+                addFlag((std::string("--") + name).c_str(), config.at(name).dump());
+            }
+        }
+        if (config.contains("minTime"))
+        {
+            addFlag("--min-time", config.at("minTime").dump());
+        }
+        addFlag("--json", output);
+
+        std::remove(output.c_str());
+        std::cerr << "running: " << command << "\n";
+        // A nonzero status only means some case failed; those are in the JSON.
+        const int status = std::system((command + " > /dev/null").c_str());
+        std::ifstream produced(output);
+        if (!produced)
+        {
+            throw std::runtime_error("The benchmark suite did not produce " + output + " (exit status " + std::to_string(status) + ")");
+        }
+        return readJson(output);
+    }
+
+    void warnOnEnvironment(const json& baseline, const json& current)
+    {
+        const json& a = baseline.value("environment", json::object());
+        const json& b = current.value("environment", json::object());
+        if (a != b)
+        {
+            std::cout << "warning: the baseline was recorded in a different environment\n"
+                      << "  baseline: " << a.dump() << "\n"
+                      << "  current:  " << b.dump() << "\n";
+        }
+    }
+
+    std::string formatMicros(double seconds)
+    {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3) << seconds * 1e6;
+        return out.str();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string flag = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (flag == "--baseline" && hasValue)
+        {
+            options.baselinePath = argv[++i];
+        }
+        else if (flag == "--current" && hasValue)
+        {
+            options.currentPath = argv[++i];
+            options.currentGiven = true;
+        }
+        else if (flag == "--run" && hasValue)
+        {
+            options.runPath = argv[++i];
+        }
+        else if (flag == "--tolerance" && hasValue)
+        {
+            options.tolerance = std::atof(argv[++i]);
+        }
+        else if (flag == "--confirm" && hasValue)
+        {
+            options.confirm = static_cast<std::size_t>(std::max(0L, std::atol(argv[++i])));
+        }
+        else if (flag == "--update")
+        {
+            options.update = true;
+        }
+        else if (flag == "--allow-missing")
+        {
+            options.allowMissing = true;
+        }
+        else
+        {
+            options.runPath.clear();
+            options.currentGiven = false;
+            break;
+        }
+    }
+    if ((options.runPath.empty() && !options.currentGiven) || options.tolerance < 0.0)
+    {
+        std::cerr << "Usage: regressions --run <bench/solvers binary> [--baseline <file>] [--current <file>]\n"
+                  << "                   [--tolerance <fraction>] [--confirm <reruns>] [--allow-missing] [--update]\n"
+                  << "       regressions --current <file> [--baseline <file>] [--tolerance <fraction>] [--allow-missing]\n";
+        return 2;
+    }
+
+    try
+    {
+        if (options.update)
+        {
+            json config = json::object();
+            if (std::ifstream(options.baselinePath))
+            {
+                config = readJson(options.baselinePath).value("config", json::object());
+            }
+            const json current = options.runPath.empty()
+                ? readJson(options.currentPath)
+                : runSuite(options.runPath, config, {}, options.currentPath);
+            std::ofstream out(options.baselinePath);
+            if (!out)
+            {
+                throw std::runtime_error("Cannot write " + options.baselinePath);
+            }
+            out << current.dump(1) << "\n";
+            std::cout << "baseline written to " << options.baselinePath << " (" << current.at("results").size() << " cases)\n";
+            return 0;
+        }
+
+        const json baselineDoc = readJson(options.baselinePath);
+        const json config = baselineDoc.value("config", json::object());
+        const json currentDoc = options.runPath.empty()
+            ? readJson(options.currentPath)
+            : runSuite(options.runPath, config, {}, options.currentPath);
+        warnOnEnvironment(baselineDoc, currentDoc);
+
+        const std::map<CaseKey, Timing> baseline = timings(baselineDoc);
+        std::map<CaseKey, Timing> current = timings(currentDoc);
+
+        std::map<CaseKey, Verdict> verdicts;
+        std::vector<CaseKey> missing;
+        for (const auto& [key, base] : baseline)
+        {
+            const auto it = current.find(key);
+            if (it == current.end())
+            {
+                missing.push_back(key);
+                continue;
+            }
+            verdicts[key] = classify(base, it->second, options.tolerance);
+        }
+
+        // Reruns the regressed cases; one that does not regress again was noise.
+        std::set<CaseKey> unconfirmed;
+        for (std::size_t attempt = 0; attempt < options.confirm && !options.runPath.empty(); attempt++)
+        {
+            std::vector<CaseKey> regressed;
+            for (const auto& [key, verdict] : verdicts)
+            {
+                if (verdict == Verdict::Regression)
+                {
+                    regressed.push_back(key);
+                }
+            }
+            if (regressed.empty())
+            {
+                break;
+            }
+            const std::map<CaseKey, Timing> rerun = timings(runSuite(options.runPath, config, regressed, options.currentPath + ".confirm"));
+            for (const CaseKey& key : regressed)
+            {
+                const auto it = rerun.find(key);
+                if (it != rerun.end() && classify(baseline.at(key), it->second, options.tolerance) != Verdict::Regression)
+                {
+                    verdicts[key] = Verdict::Unchanged;
+                    unconfirmed.insert(key);
+                }
+            }
+        }
+
+        std::cout << "solver       problem                n   T   baseline us    current us   change  verdict\n";
+        std::map<std::string, std::tuple<std::size_t, std::size_t, std::size_t, double>> perSolver; // cases, regressions, improvements, worst change
+        bool failed = false;
+        for (const auto& [key, verdict] : verdicts)
+        {
+            const Timing& base = baseline.at(key);
+            const Timing& cur = current.at(key);
+            const bool timed = base.failure.empty() && cur.failure.empty();
+            const double change = timed ? cur.median / base.median - 1.0 : 0.0;
+
+            std::cout << std::left << std::setw(13) << std::get<0>(key) << std::setw(19) << std::get<1>(key)
+                      << std::right << std::setw(5) << std::get<2>(key) << std::setw(4) << std::get<3>(key)
+                      << std::setw(14) << (base.failure.empty() ? formatMicros(base.median) : std::string("failed"))
+                      << std::setw(14) << (cur.failure.empty() ? formatMicros(cur.median) : std::string("failed"));
+            if (timed)
+            {
+                std::cout << std::showpos << std::fixed << std::setprecision(1) << std::setw(8) << 100.0 * change << "%" << std::noshowpos;
+            }
+            else
+            {
+                std::cout << std::setw(9) << "";
+            }
+            std::cout << "  " << verdictName(verdict);
+            if (unconfirmed.count(key))
+            {
+                std::cout << " (regressed once, not on rerun)";
+            }
+            if (!cur.failure.empty())
+            {
+                std::cout << ": " << cur.failure;
+            }
+            std::cout << std::defaultfloat << "\n";
+
+            auto& [cases, regressions, improvements, worst] = perSolver[std::get<0>(key)];
+            cases++;
+            regressions += verdict == Verdict::Regression || verdict == Verdict::Failed ? 1 : 0;
+            improvements += verdict == Verdict::Improvement ? 1 : 0;
+            worst = cases == 1 ? change : std::max(worst, change);
+            failed = failed || verdict == Verdict::Regression || verdict == Verdict::Failed;
+        }
+
+        // A renamed, dropped or skipped case must not pass silently.
+        for (const CaseKey& key : missing)
+        {
+            std::cout << (options.allowMissing ? "warning" : "MISSING") << ": no current result for " << std::get<0>(key)
+                      << " / " << std::get<1>(key) << " n = " << std::get<2>(key) << " T = " << std::get<3>(key) << "\n";
+        }
+        failed = failed || (!missing.empty() && !options.allowMissing);
+        for (const auto& [key, timing] : current)
+        {
+            if (!baseline.count(key))
+            {
+                std::cout << "note: " << std::get<0>(key) << " / " << std::get<1>(key) << " n = " << std::get<2>(key)
+                          << " T = " << std::get<3>(key) << " is not in the baseline\n";
+            }
+        }
+
+        std::cout << "\nper solver (tolerance " << std::fixed << std::setprecision(1) << 100.0 * options.tolerance
+                  << "%):\n" << std::defaultfloat;
+        for (const auto& [solver, summary] : perSolver)
+        {
+            const auto& [cases, regressions, improvements, worst] = summary;
+            std::cout << "  " << std::left << std::setw(13) << solver << std::right << cases << " cases, "
+                      << regressions << " regressed, " << improvements << " improved, worst "
+                      << std::showpos << std::fixed << std::setprecision(1) << 100.0 * worst << "%"
+                      << std::noshowpos << std::defaultfloat << "\n";
+        }
+        if (failed)
+        {
+            std::cout << "FAIL: performance regressions" << (missing.empty() || options.allowMissing ? "" : " or missing cases") << "\n";
+        }
+        else
+        {
+            std::cout << "OK: no regressions\n";
+        }
+        return failed ? 1 : 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+}
@@ -0,0 +1,241 @@
+#include "core/DoubleDouble.h"
+#include "linear/GaussianElimination.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Speed and accuracy of the scalar types the templated solvers run on:
+// GaussianElimination::solveAs<T> on scaled Hilbert systems. H_ij = L / (i + j + 1)
+// with L = lcm(1 .. 2n - 1) is an integer matrix, so A and b = A * (1, .., 1)
+// are exact doubles and the exact solution is all ones; the condition number is
+// Hilbert's (1e13 at n = 10, 2e16 at n = 12).
+//
+//   scalar_types [--sizes 4,8,10,12] [--min-time 0.2] [--accuracy 1e-20]
+// prints the time per solve, its ratio to double and the relative error
+// ||x - 1||inf of every type; with --accuracy, the fastest type within it per size.
+
+namespace
+{
+#if defined(__SIZEOF_FLOAT128__) && !defined(__clang__)
+    // __float128 with the few free functions the solvers look up (abs).
+    class Quad {
+    private:
+        __float128 v = 0;
+
+    public:
+        Quad() = default;
+        Quad(double value)
+            : v(value)
+        {
+        }
+
+        explicit operator double() const
+        {
+            return static_cast<double>(v);
+        }
+
+        friend Quad operator-(Quad a) { Quad r; r.v = -a.v; return r; }
+        friend Quad operator+(Quad a, Quad b) { a.v += b.v; return a; }
+        friend Quad operator-(Quad a, Quad b) { a.v -= b.v; return a; }
+        friend Quad operator*(Quad a, Quad b) { a.v *= b.v; return a; }
+        friend Quad operator/(Quad a, Quad b) { a.v /= b.v; return a; }
+        Quad& operator+=(Quad o) { v += o.v; return *this; }
+        Quad& operator-=(Quad o) { v -= o.v; return *this; }
+        Quad& operator*=(Quad o) { v *= o.v; return *this; }
+        Quad& operator/=(Quad o) { v /= o.v; return *this; }
+        friend bool operator<(Quad a, Quad b) { return a.v < b.v; }
+        friend bool operator>(Quad a, Quad b) { return a.v > b.v; }
+        friend Quad abs(Quad a) { return a.v < 0 ? -a : a; }
+    };
+    constexpr bool haveQuad = true;
+#else
+    constexpr bool haveQuad = false;
+#endif
+
+    long long gcd(long long a, long long b)
+    {
+        while (b != 0)
+        {
+            const long long t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    LinearSystem scaledHilbert(std::size_t n)
+    {
+        long long lcm = 1;
+        for (long long k = 2; k <= static_cast<long long>(2 * n - 1); k++)
+        {
+            lcm = lcm / gcd(lcm, k) * k;
+        }
+
+        Matrix A(n, n);
+        Vector b(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            long long sum = 0;
+            for (std::size_t j = 0; j < n; j++)
+            {
+                const long long entry = lcm / static_cast<long long>(i + j + 1);
+                A(i, j) = static_cast<double>(entry);
+                sum += entry;
+            }
+            b[i] = static_cast<double>(sum);
+        }
+        return LinearSystem(A, b);
+    }
+
+    struct Measurement
+    {
+        std::string type;
+        int mantissaBits;
+        double secondsPerSolve;
+        double relativeError;
+    };
+
+    template <typename T>
+    Measurement measure(const std::string& type, int mantissaBits, const LinearSystem& system, double minSeconds)
+    {
+        using std::abs;
+        using Clock = std::chrono::steady_clock;
+
+        std::vector<T> x = GaussianElimination::solveAs<T>(system); // warm-up
+        T error = T(0.0);
+        for (const T& xi : x)
+        {
+            const T e = abs(xi - T(1.0));
+            error = e > error ? e : error;
+        }
+
+        // Best of five batches, each at least minSeconds / 5 long.
+        double best = std::numeric_limits<double>::infinity();
+        std::size_t reps = 1;
+        for (int batch = 0; batch < 5; batch++)
+        {
+            for (;;)
+            {
+                const auto start = Clock::now();
+                for (std::size_t r = 0; r < reps; r++)
+                {
+                    x = GaussianElimination::solveAs<T>(system);
+                }
+                const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                if (seconds >= minSeconds / 5.0)
+                {
+                    best = std::min(best, seconds / static_cast<double>(reps));
+                    break;
+                }
+                reps *= 2;
+            }
+        }
+        return { type, mantissaBits, best, static_cast<double>(error) };
+    }
+
+    std::vector<std::size_t> parseSizes(const std::string& list)
+    {
+        std::vector<std::size_t> sizes;
+        std::size_t start = 0;
+        while (start <= list.size())
+        {
+            const std::size_t comma = std::min(list.find(',', start), list.size());
+            const long n = std::atol(list.substr(start, comma - start).c_str());
+            if (n < 1 || n > 13)
+            {
+                throw std::invalid_argument("Sizes must be 1..13 (the scaled Hilbert entries must stay exact).");
+            }
+            sizes.push_back(static_cast<std::size_t>(n));
+            start = comma + 1;
+        }
+        return sizes;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::size_t> sizes = { 4, 8, 10, 12 };
+    double minSeconds = 0.2;
+    double accuracy = 0.0;
+
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string flag = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (flag == "--sizes" && hasValue)
+            {
+                sizes = parseSizes(argv[++i]);
+            }
+            else if (flag == "--min-time" && hasValue)
+            {
+                minSeconds = std::max(0.001, std::atof(argv[++i]));
+            }
+            else if (flag == "--accuracy" && hasValue)
+            {
+                accuracy = std::atof(argv[++i]);
+            }
+            else
+            {
+                std::cerr << "Usage: scalar_types [--sizes 4,8,10,12] [--min-time <s>] [--accuracy <relative error>]\n";
+                return 2;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    if (!haveQuad)
+    {
+        std::cout << "(__float128 is not available with this compiler; its rows are skipped)\n";
+    }
+
+    std::cout << " n  type          bits  us/solve   vs double  rel. error\n";
+    for (const std::size_t n : sizes)
+    {
+        const LinearSystem system = scaledHilbert(n);
+
+        std::vector<Measurement> rows;
+        rows.push_back(measure<float>("float", std::numeric_limits<float>::digits, system, minSeconds));
+        rows.push_back(measure<double>("double", std::numeric_limits<double>::digits, system, minSeconds));
+        rows.push_back(measure<long double>("long double", std::numeric_limits<long double>::digits, system, minSeconds));
+        rows.push_back(measure<DoubleDouble>("double-double", 106, system, minSeconds));
+#if defined(__SIZEOF_FLOAT128__) && !defined(__clang__)
+        rows.push_back(measure<Quad>("__float128", 113, system, minSeconds));
+#endif
+
+        const double doubleTime = rows[1].secondsPerSolve;
+        for (const Measurement& m : rows)
+        {
+            std::cout << std::setw(2) << n << "  " << std::left << std::setw(13) << m.type << std::right
+                      << std::setw(5) << m.mantissaBits << "  "
+                      << std::fixed << std::setprecision(3) << std::setw(8) << m.secondsPerSolve * 1e6 << "  "
+                      << std::setprecision(1) << std::setw(9) << m.secondsPerSolve / doubleTime << "x  "
+                      << std::scientific << std::setprecision(2) << m.relativeError << std::defaultfloat << "\n";
+        }
+
+        if (accuracy > 0.0)
+        {
+            const Measurement* fastest = nullptr;
+            for (const Measurement& m : rows)
+            {
+                if (m.relativeError <= accuracy && (!fastest || m.secondsPerSolve < fastest->secondsPerSolve))
+                {
+                    fastest = &m;
+                }
+            }
+            std::cout << "    fastest within " << accuracy << ": " << (fastest ? fastest->type : std::string("none")) << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,534 @@
+#include "Generators.h"
+#include "Statistics.h"
+
+#include "linear/GaussSeidel.h"
+#include "linear/GaussianElimination.h"
+#include "linear/Jacobi.h"
+#include "nonlinear/Newton.h"
+#include "nonlinear/RootFinding.h"
+
+#include "utils/JsonWriter.h"
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Benchmark suite: times every solver of the library on generated problems
+// across sizes and thread counts.
+//
+//   solvers [--sizes 16,64,128] [--threads 1,4] [--repetitions 15] [--warmup 2]
+//           [--min-time 0.02] [--solvers gauss,jacobi,...] [--problems random,spd,...]
+//           [--digits 15] [--sweeps 50] [--seed 1] [--json results.json]
+//
+// A case (solver, problem, size) is run with T threads by giving each of T
+// pool workers the same problem to solve `inner` times in a row; `inner` is
+// doubled during warm-up until one such batch takes --min-time. After
+// --warmup more batches, each of --repetitions batches yields one sample,
+// the wall time per solve of a worker (batch time / inner). With T > 1 the
+// workers compete for cores and memory bandwidth, so the samples show how a
+// solver scales: throughput is T / time per solve.
+//
+// Solvers: gauss (GaussianElimination::solve with --digits significant
+// digits), gaussLU (solveAs<double>, no rounding), jacobi and gaussSeidel
+// (--sweeps sweeps from 0), newtonSystem (Broyden's tridiagonal function),
+// bisection, regulaFalsi, secant and newton (x^3 - 2x - 5 on [2, 3], size 1).
+// Jacobi runs only on the diagonally dominant kinds and Gauss-Seidel also
+// on spd, where they converge. `error` is ||x - 1||inf for linear systems,
+// ||F(x)||inf for Newton and |f(x)| for the root finders.
+
+namespace
+{
+    struct Options
+    {
+        std::vector<std::size_t> sizes = { 16, 64, 128 };
+        std::vector<std::size_t> threads;
+        std::size_t repetitions = 15;
+        std::size_t warmup = 2;
+        double minSeconds = 0.02;
+        std::vector<std::string> solvers;
+        std::vector<std::string> problems;
+        int digits = 15;
+        std::size_t sweeps = 50;
+        std::uint64_t seed = 1;
+        std::string jsonPath;
+    };
+
+    struct Case
+    {
+        std::string solver;
+        std::string problem;
+        std::size_t size;
+        // One solve; the result is folded into a checksum so it is not optimized away.
+        std::function<double()> run;
+        std::function<double()> error;
+    };
+
+    struct CaseResult
+    {
+        const Case* benchmark;
+        std::size_t threads;
+        std::size_t inner = 0;
+        std::vector<double> samples;
+        SampleSummary seconds;
+        double error = 0.0;
+        std::string failure;
+    };
+
+    std::vector<std::string> splitList(const std::string& list)
+    {
+        std::vector<std::string> items;
+        std::size_t start = 0;
+        while (start <= list.size())
+        {
+            const std::size_t comma = std::min(list.find(',', start), list.size());
+            if (comma > start)
+            {
+                items.push_back(list.substr(start, comma - start));
+            }
+            start = comma + 1;
+        }
+        return items;
+    }
+
+    std::vector<std::size_t> parseCounts(const std::string& list, const char* what)
+    {
+        std::vector<std::size_t> counts;
+        for (const std::string& item : splitList(list))
+        {
+            const long value = std::atol(item.c_str());
+            if (value < 1)
+            {
+                throw std::invalid_argument(std::string(what) + " must be positive integers");
+            }
+            counts.push_back(static_cast<std::size_t>(value));
+        }
+        if (counts.empty())
+        {
+            throw std::invalid_argument(std::string(what) + " list is empty");
+        }
+        return counts;
+    }
+
+    bool selected(const std::vector<std::string>& filter, const std::string& name)
+    {
+        return filter.empty() || std::find(filter.begin(), filter.end(), name) != filter.end();
+    }
+
+    double solutionError(const std::vector<double>& x)
+    {
+        double error = 0.0;
+        for (const double v : x)
+        {
+            error = std::max(error, std::fabs(v - 1.0));
+        }
+        return error;
+    }
+
+    double solutionError(const Vector& x)
+    {
+        double error = 0.0;
+        for (std::size_t i = 0; i < x.size(); i++)
+        {
+            error = std::max(error, std::fabs(x[i] - 1.0));
+        }
+        return error;
+    }
+
+    std::vector<Case> buildCases(const Options& options)
+    {
+        std::vector<Case> cases;
+        auto add = [&](const std::string& solver, const std::string& problem, std::size_t size,
+                       std::function<double()> run, std::function<double()> error)
+        {
+            if (selected(options.solvers, solver) && selected(options.problems, problem))
+            {
+                cases.push_back({ solver, problem, size, std::move(run), std::move(error) });
+            }
+        };
+
+        for (const std::size_t n : options.sizes)
+        {
+            for (const ProblemKind kind : allProblemKinds())
+            {
+                const std::string problem = problemName(kind);
+                if (!selected(options.problems, problem))
+                {
+                    continue;
+                }
+                const auto system = std::make_shared<const LinearSystem>(makeLinearSystem(kind, n, options.seed));
+                const int digits = options.digits;
+                const std::size_t sweeps = options.sweeps;
+                const Vector zero(n);
+
+                add("gauss", problem, n,
+                    [system, digits] { return GaussianElimination::solve(*system, digits)[0]; },
+                    [system, digits] { return solutionError(GaussianElimination::solve(*system, digits)); });
+                add("gaussLU", problem, n,
+                    [system] { return GaussianElimination::solveAs<double>(*system)[0]; },
+                    [system] { return solutionError(GaussianElimination::solveAs<double>(*system)); });
+                if (kind != ProblemKind::Random && kind != ProblemKind::Spd)
+                {
+                    add("jacobi", problem, n,
+                        [system, zero, sweeps] { return JacobiSolver::iterate(*system, zero, sweeps)[0]; },
+                        [system, zero, sweeps] { return solutionError(JacobiSolver::iterate(*system, zero, sweeps)); });
+                }
+                if (kind != ProblemKind::Random)
+                {
+                    add("gaussSeidel", problem, n,
+                        [system, zero, sweeps] { return GaussSeidelSolver::iterate(*system, zero, sweeps)[0]; },
+                        [system, zero, sweeps] { return solutionError(GaussSeidelSolver::iterate(*system, zero, sweeps)); });
+                }
+            }
+
+            const auto system = std::make_shared<const NonlinearSystem>(broydenTridiagonal());
+            Vector x0(n);
+            for (std::size_t i = 0; i < n; i++)
+            {
+                x0[i] = -1.0;
+            }
+            add("newtonSystem", "broydenTridiagonal", n,
+                [system, x0] { return NewtonSolver::solve(*system, x0, 1e-10)[0]; },
+                [system, x0] { return system->evaluate(NewtonSolver::solve(*system, x0, 1e-10)).normInf(); });
+        }
+
+        const ScalarEquation cubic([](double x) { return (x * x - 2.0) * x - 5.0; });
+        const Function1D derivative = [](double x) { return 3.0 * x * x - 2.0; };
+        const double eps = 1e-12;
+        auto residual = [cubic](double root) { return std::fabs(cubic(root)); };
+        add("bisection", "cubic", 1,
+            [cubic, eps] { return RootFinding::bisection(cubic, 2.0, 3.0, eps); },
+            [cubic, eps, residual] { return residual(RootFinding::bisection(cubic, 2.0, 3.0, eps)); });
+        add("regulaFalsi", "cubic", 1,
+            [cubic, eps] { return RootFinding::regulaFalsi(cubic, 2.0, 3.0, eps); },
+            [cubic, eps, residual] { return residual(RootFinding::regulaFalsi(cubic, 2.0, 3.0, eps)); });
+        add("secant", "cubic", 1,
+            [cubic, eps] { return RootFinding::secant(cubic, 2.0, 3.0, eps); },
+            [cubic, eps, residual] { return residual(RootFinding::secant(cubic, 2.0, 3.0, eps)); });
+        add("newton", "cubic", 1,
+            [cubic, derivative, eps] { return RootFinding::newton(cubic, derivative, 2.0, eps); },
+            [cubic, derivative, eps, residual] { return residual(RootFinding::newton(cubic, derivative, 2.0, eps)); });
+        return cases;
+    }
+
+    // Wall time of `threads` workers each running `inner` solves; the first
+    // exception of any worker is rethrown.
+    double runBatch(ThreadPool& pool, std::size_t threads, std::size_t inner, const Case& benchmark)
+    {
+        std::mutex failureMutex;
+        std::exception_ptr failure;
+        std::vector<double> checksums(threads, 0.0);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t t = 0; t < threads; t++)
+        {
+            pool.submit([&, t]()
+            {
+                try
+                {
+                    double checksum = 0.0;
+                    for (std::size_t r = 0; r < inner; r++)
+                    {
+                        checksum += benchmark.run();
+                    }
+                    checksums[t] = checksum;
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if (!failure)
+                    {
+                        failure = std::current_exception();
+                    }
+                }
+            });
+        }
+        pool.wait();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (failure)
+        {
+            std::rethrow_exception(failure);
+        }
+        volatile double sink = 0.0;
+        for (const double c : checksums)
+        {
+            sink = sink + c;
+        }
+        return seconds;
+    }
+
+    CaseResult measure(ThreadPool& pool, std::size_t threads, const Case& benchmark, const Options& options)
+    {
+        CaseResult result;
+        result.benchmark = &benchmark;
+        result.threads = threads;
+        try
+        {
+            result.error = benchmark.error();
+
+            // Warm-up: grow the batch until it lasts minSeconds, then a few more.
+            std::size_t inner = 1;
+            for (;;)
+            {
+                const double seconds = runBatch(pool, threads, inner, benchmark);
+                if (seconds >= options.minSeconds)
+                {
+                    break;
+                }
+                const double scale = seconds > 0.0 ? options.minSeconds / seconds : 2.0;
+                inner = std::max(inner * 2, static_cast<std::size_t>(std::ceil(static_cast<double>(inner) * std::min(scale, 100.0))));
+            }
+            for (std::size_t w = 0; w < options.warmup; w++)
+            {
+                runBatch(pool, threads, inner, benchmark);
+            }
+
+            result.inner = inner;
+            for (std::size_t r = 0; r < options.repetitions; r++)
+            {
+                result.samples.push_back(runBatch(pool, threads, inner, benchmark) / static_cast<double>(inner));
+            }
+            result.seconds = summarize(result.samples);
+        }
+        catch (const std::exception& e)
+        {
+            result.failure = e.what();
+        }
+        return result;
+    }
+
+    void writeJson(std::ostream& out, const Options& options, const std::vector<CaseResult>& results)
+    {
+        JsonWriter w(out);
+        w.beginObject();
+        w.field("kind", "benchmark");
+        w.field("version", 1);
+
+        // Everything needed to rerun the same cases (bench/regressions.cpp does).
+        w.key("config");
+        w.beginObject();
+        auto writeList = [&](const char* name, const auto& items)
+        {
+            w.key(name);
+            w.beginArray();
+            for (const auto& item : items)
+            {
+                w.value(item);
+            }
+            w.endArray();
+        };
+        writeList("sizes", options.sizes);
+        writeList("threads", options.threads);
+        writeList("solvers", options.solvers);
+        writeList("problems", options.problems);
+        w.field("repetitions", options.repetitions);
+        w.field("warmup", options.warmup);
+        w.field("minTime", options.minSeconds);
+        w.field("digits", options.digits);
+        w.field("sweeps", options.sweeps);
+        w.field("seed", options.seed);
+        w.endObject();
+
+        w.key("environment");
+        w.beginObject();
+#if defined(__VERSION__)
+        w.field("compiler", __VERSION__);
+#else
+        w.field("compiler", "unknown");
+#endif
+#if defined(__OPTIMIZE__)
+        w.field("optimized", true);
+#else
+        w.field("optimized", false);
+#endif
+        w.field("hardwareThreads", ThreadPool::defaultThreadCount());
+        w.endObject();
+
+        w.key("results");
+        w.beginArray();
+        for (const CaseResult& r : results)
+        {
+            w.beginObject();
+            w.field("solver", r.benchmark->solver);
+            w.field("problem", r.benchmark->problem);
+            w.field("size", r.benchmark->size);
+            w.field("threads", r.threads);
+            if (!r.failure.empty())
+            {
+                w.field("failure", r.failure);
+                w.endObject();
+                continue;
+            }
+            w.field("solvesPerRepetition", r.inner);
+            w.field("error", r.error);
+            w.field("solvesPerSecond", static_cast<double>(r.threads) / r.seconds.median);
+            w.key("seconds");
+            w.beginObject();
+            w.field("median", r.seconds.median);
+            w.field("ciLow", r.seconds.ciLow);
+            w.field("ciHigh", r.seconds.ciHigh);
+            w.field("min", r.seconds.min);
+            w.field("max", r.seconds.max);
+            w.field("mean", r.seconds.mean);
+            w.field("stddev", r.seconds.stddev);
+            w.endObject();
+            w.key("samples");
+            w.beginArray();
+            for (const double s : r.samples)
+            {
+                w.value(s);
+            }
+            w.endArray();
+            w.endObject();
+        }
+        w.endArray();
+        w.endObject();
+        w.endLine();
+        w.flush();
+    }
+
+    void printRow(const CaseResult& r)
+    {
+        std::cout << std::left << std::setw(13) << r.benchmark->solver << std::setw(19) << r.benchmark->problem
+                  << std::right << std::setw(5) << r.benchmark->size << std::setw(4) << r.threads << "  ";
+        if (!r.failure.empty())
+        {
+            std::cout << "failed: " << r.failure << "\n";
+            return;
+        }
+        const double us = 1e6;
+        std::cout << std::fixed << std::setprecision(3)
+                  << std::setw(12) << r.seconds.median * us << "  ["
+                  << std::setw(12) << r.seconds.ciLow * us << ", "
+                  << std::setw(12) << r.seconds.ciHigh * us << "]  "
+                  << std::setprecision(1) << std::setw(5) << (r.seconds.mean > 0.0 ? 100.0 * r.seconds.stddev / r.seconds.mean : 0.0) << "%  "
+                  << std::scientific << std::setprecision(2) << r.error << std::defaultfloat << "\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string flag = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (flag == "--sizes" && hasValue)
+            {
+                options.sizes = parseCounts(argv[++i], "Sizes");
+            }
+            else if (flag == "--threads" && hasValue)
+            {
+                options.threads = parseCounts(argv[++i], "Thread counts");
+            }
+            else if (flag == "--repetitions" && hasValue)
+            {
+                options.repetitions = parseCounts(argv[++i], "Repetitions").front();
+            }
+            else if (flag == "--warmup" && hasValue)
+            {
+                options.warmup = static_cast<std::size_t>(std::max(0L, std::atol(argv[++i])));
+            }
+            else if (flag == "--min-time" && hasValue)
+            {
+                options.minSeconds = std::max(0.001, std::atof(argv[++i]));
+            }
+            else if (flag == "--solvers" && hasValue)
+            {
+                options.solvers = splitList(argv[++i]);
+            }
+            else if (flag == "--problems" && hasValue)
+            {
+                options.problems = splitList(argv[++i]);
+            }
+            else if (flag == "--digits" && hasValue)
+            {
+                options.digits = std::atoi(argv[++i]);
+            }
+            else if (flag == "--sweeps" && hasValue)
+            {
+                options.sweeps = parseCounts(argv[++i], "Sweeps").front();
+            }
+            else if (flag == "--seed" && hasValue)
+            {
+                options.seed = static_cast<std::uint64_t>(std::strtoull(argv[++i], nullptr, 10));
+            }
+            else if (flag == "--json" && hasValue)
+            {
+                options.jsonPath = argv[++i];
+            }
+            else
+            {
+                std::cerr << "Usage: solvers [--sizes 16,64,128] [--threads 1,4] [--repetitions <n>] [--warmup <n>]\n"
+                          << "               [--min-time <s>] [--solvers gauss,...] [--problems random,...]\n"
+                          << "               [--digits <t>] [--sweeps <n>] [--seed <n>] [--json <file>]\n";
+                return 2;
+            }
+        }
+        if (options.digits <= 0)
+        {
+            throw std::invalid_argument("Digits must be positive");
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    if (options.threads.empty())
+    {
+        options.threads.push_back(1);
+        if (ThreadPool::defaultThreadCount() > 1)
+        {
+            options.threads.push_back(ThreadPool::defaultThreadCount());
+        }
+    }
+
+    const std::vector<Case> cases = buildCases(options);
+    if (cases.empty())
+    {
+        std::cerr << "No benchmark matches the --solvers / --problems filters.\n";
+        return 2;
+    }
+
+    std::cout << "solver       problem                n   T     median us   [95% CI of the median, us]   cv    error\n";
+    std::vector<CaseResult> results;
+    for (const std::size_t threads : options.threads)
+    {
+        ThreadPool pool(threads);
+        for (const Case& benchmark : cases)
+        {
+            results.push_back(measure(pool, threads, benchmark, options));
+            printRow(results.back());
+        }
+    }
+
+    if (!options.jsonPath.empty())
+    {
+        std::ofstream out(options.jsonPath);
+        if (!out)
+        {
+            std::cerr << "Cannot write " << options.jsonPath << "\n";
+            return 1;
+        }
+        writeJson(out, options, results);
+    }
+
+    const bool failed = std::any_of(results.begin(), results.end(), [](const CaseResult& r) { return !r.failure.empty(); });
+    return failed ? 1 : 0;
+}
@@ -4,21 +4,34 @@
 // These headers are provided via the include/ tree.
 
 // Core
+#include "core/AlignedAllocator.h"
+#include "core/Arena.h"
+#include "core/Decimal.h"
+#include "core/DoubleDouble.h"
 #include "core/Matrix.h"
+#include "core/Scalar.h"
 #include "core/Vector.h"
 
 // Linear
 #include "linear/GaussianElimination.h"
 #include "linear/GaussSeidel.h"
+#include "linear/IterativeRefinement.h"
 #include "linear/Jacobi.h"
 #include "linear/LinearSystem.h"
+#include "linear/PrecisionSweep.h"
 
 // Nonlinear
+#include "nonlinear/MethodRace.h"
 #include "nonlinear/Newton.h"
 #include "nonlinear/NonlinearSystem.h"
 #include "nonlinear/RootFinding.h"
 #include "nonlinear/ScalarEquation.h"
 
 // Utils
+#include "utils/Cancellation.h"
 #include "utils/Exceptions.h"
+#include "utils/JsonWriter.h"
 #include "utils/Rounding.h"
+#include "utils/ThreadPool.h"
+#include "utils/TraceDecimation.h"
+#include "utils/TraceSink.h"
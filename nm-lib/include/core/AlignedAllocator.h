@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+// Cache line size the containers align and pad to.
+constexpr std::size_t cacheLineBytes = 64;
+
+// Transparent huge page size on x86-64 and most aarch64 kernels.
+constexpr std::size_t hugePageBytes = 2 * 1024 * 1024;
+
+// ::operator new / delete with the given alignment (a power of two).
+void* allocateAligned(std::size_t bytes, std::size_t alignment);
+void deallocateAligned(void* p, std::size_t alignment) noexcept;
+
+// Asks the kernel to back [p, p + bytes) with huge pages (madvise on Linux);
+// a no-op elsewhere or when transparent huge pages are disabled.
+void adviseHugePages(void* p, std::size_t bytes) noexcept;
+
+// Standard allocator whose blocks start on an Alignment boundary (at least
+// alignof(T)). The default storage of BasicVector and BasicMatrix, so that
+// vector data and matrix rows begin on a cache line.
+template <typename T, std::size_t Alignment = cacheLineBytes>
+class AlignedAllocator {
+public:
+	using value_type = T;
+
+	static constexpr std::size_t alignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+	template <typename U>
+	struct rebind
+	{
+		using other = AlignedAllocator<U, Alignment>;
+	};
+
+	AlignedAllocator() = default;
+
+	template <typename U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+	{
+	}
+
+	T* allocate(std::size_t count)
+	{
+		if (count > static_cast<std::size_t>(-1) / sizeof(T))
+		{
+			throw std::bad_array_new_length();
+		}
+		return static_cast<T*>(allocateAligned(count * sizeof(T), alignment));
+	}
+
+	void deallocate(T* p, std::size_t) noexcept
+	{
+		deallocateAligned(p, alignment);
+	}
+
+	template <typename U>
+	bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+	{
+		return true;
+	}
+
+	template <typename U>
+	bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept
+	{
+		return false;
+	}
+};
+
+// AlignedAllocator for large blocks: allocations of hugePageBytes or more are
+// aligned to a huge page and advised to be backed by huge pages, cutting TLB
+// misses when a sweep walks a matrix of tens of megabytes. Smaller blocks are
+// cache-line aligned as usual. Opt in per container:
+//   BasicMatrix<double, HugePageAllocator<double>> A(4000, 4000);
+template <typename T>
+class HugePageAllocator {
+public:
+	using value_type = T;
+
+	template <typename U>
+	struct rebind
+	{
+		using other = HugePageAllocator<U>;
+	};
+
+	HugePageAllocator() = default;
+
+	template <typename U>
+	HugePageAllocator(const HugePageAllocator<U>&) noexcept
+	{
+	}
+
+	T* allocate(std::size_t count)
+	{
+		if (count > static_cast<std::size_t>(-1) / sizeof(T))
+		{
+			throw std::bad_array_new_length();
+		}
+		const std::size_t bytes = count * sizeof(T);
+		if (bytes < hugePageBytes)
+		{
+			return static_cast<T*>(allocateAligned(bytes, AlignedAllocator<T>::alignment));
+		}
+		void* p = allocateAligned(bytes, hugePageBytes);
+		adviseHugePages(p, bytes);
+		return static_cast<T*>(p);
+	}
+
+	void deallocate(T* p, std::size_t count) noexcept
+	{
+		const std::size_t bytes = count * sizeof(T);
+		deallocateAligned(p, bytes < hugePageBytes ? AlignedAllocator<T>::alignment : hugePageBytes);
+	}
+
+	template <typename U>
+	bool operator==(const HugePageAllocator<U>&) const noexcept
+	{
+		return true;
+	}
+
+	template <typename U>
+	bool operator!=(const HugePageAllocator<U>&) const noexcept
+	{
+		return false;
+	}
+};
+
+// Elements per row of a matrix with `cols` columns so that every row starts
+// on a cache line: cols rounded up to a whole number of lines when T packs
+// evenly into one, cols otherwise.
+template <typename T>
+constexpr std::size_t paddedRowLength(std::size_t cols)
+{
+	if (sizeof(T) > cacheLineBytes || cacheLineBytes % sizeof(T) != 0)
+	{
+		return cols;
+	}
+	constexpr std::size_t perLine = cacheLineBytes / sizeof(T);
+	return (cols + perLine - 1) / perLine * perLine;
+}
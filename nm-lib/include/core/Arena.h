@@ -0,0 +1,142 @@
+#pragma once
+
+#include "core/AlignedAllocator.h"
+#include "core/Matrix.h"
+#include "core/Vector.h"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// Bump allocator for short-lived buffers: allocate() advances an offset in
+// the current block (starting a new, larger block when it is full),
+// deallocation is a no-op, and rewind() / reset() release everything after a
+// mark in O(1). Blocks are kept for reuse, so a thread that repeats similar
+// solves stops calling malloc after the first one. Not thread-safe; each
+// thread has its own in forThread().
+class Arena {
+public:
+	struct Mark
+	{
+		std::size_t block = 0;
+		std::size_t offset = 0;
+	};
+
+private:
+	struct Block
+	{
+		std::byte* data;
+		std::size_t size;
+	};
+
+	std::vector<Block> blocks;
+	Mark top;
+	std::size_t firstBlockBytes;
+
+public:
+	explicit Arena(std::size_t firstBlockBytes = 64 * 1024);
+	~Arena();
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	// `bytes` aligned to `alignment` (a power of two, at most cacheLineBytes).
+	void* allocate(std::size_t bytes, std::size_t alignment);
+
+	Mark mark() const;
+	void rewind(Mark mark) noexcept;
+	void reset() noexcept;
+
+	// Frees the blocks above the current top, e.g. on a long-lived thread
+	// after an unusually large solve; the next allocations start new ones.
+	void trim() noexcept;
+
+	// Bytes in use above the bottom, and held in all blocks.
+	std::size_t used() const;
+	std::size_t capacity() const;
+
+	// Arena of the calling thread, created on first use.
+	static Arena& forThread();
+};
+
+// Releases what the arena handed out while the object lives; scopes nest
+// like DecimalPrecision. A solver opens one around its temporaries, so their
+// memory is reclaimed in O(1) however the solve ends (exceptions included).
+class ArenaScope {
+private:
+	Arena& arena;
+	Arena::Mark start;
+
+public:
+	explicit ArenaScope(Arena& arena = Arena::forThread());
+	~ArenaScope();
+
+	ArenaScope(const ArenaScope&) = delete;
+	ArenaScope& operator=(const ArenaScope&) = delete;
+};
+
+// Standard allocator drawing from an Arena (by default the calling thread's
+// at construction), cache-line aligned like AlignedAllocator. Containers
+// using it must not outlive the ArenaScope they were filled in.
+template <typename T>
+class ArenaAllocator {
+private:
+	template <typename U>
+	friend class ArenaAllocator;
+
+	Arena* arena;
+
+public:
+	using value_type = T;
+
+	ArenaAllocator()
+		: arena(&Arena::forThread())
+	{
+	}
+
+	explicit ArenaAllocator(Arena& arena)
+		: arena(&arena)
+	{
+	}
+
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+		: arena(other.arena)
+	{
+	}
+
+	T* allocate(std::size_t count)
+	{
+		if (count > static_cast<std::size_t>(-1) / sizeof(T))
+		{
+			throw std::bad_array_new_length();
+		}
+		return static_cast<T*>(arena->allocate(count * sizeof(T), AlignedAllocator<T>::alignment));
+	}
+
+	void deallocate(T*, std::size_t) noexcept
+	{
+	}
+
+	template <typename U>
+	bool operator==(const ArenaAllocator<U>& other) const noexcept
+	{
+		return arena == other.arena;
+	}
+
+	template <typename U>
+	bool operator!=(const ArenaAllocator<U>& other) const noexcept
+	{
+		return arena != other.arena;
+	}
+};
+
+template <typename T>
+using ArenaVector = BasicVector<T, ArenaAllocator<T>>;
+
+template <typename T>
+using ArenaMatrix = BasicMatrix<T, ArenaAllocator<T>>;
+
+// Plain buffer from the thread's arena, for kernels that index raw storage.
+template <typename T>
+using ArenaBuffer = std::vector<T, ArenaAllocator<T>>;
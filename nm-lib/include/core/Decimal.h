@@ -0,0 +1,184 @@
+#pragma once
+
+#include "utils/Rounding.h"
+
+#include <cmath>
+#include <ostream>
+#include <stdexcept>
+
+// Precision of Decimal<0> on the calling thread while the object lives;
+// scopes nest and restore the previous precision when destroyed.
+class DecimalPrecision {
+private:
+	int previous;
+
+public:
+	explicit DecimalPrecision(int significantDigits);
+	~DecimalPrecision();
+
+	DecimalPrecision(const DecimalPrecision&) = delete;
+	DecimalPrecision& operator=(const DecimalPrecision&) = delete;
+
+	// Innermost precision on this thread, 0 outside any scope.
+	static int current();
+};
+
+// Scalar for finite-precision (t-digit) arithmetic: the value is a double and
+// every arithmetic result (+, -, *, /, sqrt) is rounded to `Digits`
+// significant digits by roundToSignificantDigits, exactly like the r(...)
+// calls of GaussianElimination::solve(system, t). Negation, abs and
+// comparisons are exact. Constructing from a double keeps the value as it
+// is; rounded() rounds it. Decimal<0> reads its precision from the innermost
+// DecimalPrecision of the calling thread, so one instantiation serves every t.
+template <int Digits>
+class Decimal {
+	static_assert(Digits >= 0, "Decimal: Digits must be non-negative (0 = runtime precision)");
+
+private:
+	double v = 0.0;
+
+	static double round(double x)
+	{
+		return roundToSignificantDigits(x, digits());
+	}
+
+public:
+	Decimal() = default;
+
+	Decimal(double value)
+		: v(value)
+	{
+	}
+
+	static Decimal rounded(double value)
+	{
+		return Decimal(round(value));
+	}
+
+	static int digits()
+	{
+		if constexpr (Digits > 0)
+		{
+			return Digits;
+		}
+		else
+		{
+			const int current = DecimalPrecision::current();
+			if (current <= 0)
+			{
+				throw std::logic_error("Decimal<0> arithmetic needs a DecimalPrecision scope");
+			}
+			return current;
+		}
+	}
+
+	double value() const
+	{
+		return v;
+	}
+
+	explicit operator double() const
+	{
+		return v;
+	}
+
+	Decimal operator-() const
+	{
+		return Decimal(-v);
+	}
+
+	Decimal operator+() const
+	{
+		return *this;
+	}
+
+	Decimal& operator+=(Decimal other)
+	{
+		v = round(v + other.v);
+		return *this;
+	}
+
+	Decimal& operator-=(Decimal other)
+	{
+		v = round(v - other.v);
+		return *this;
+	}
+
+	Decimal& operator*=(Decimal other)
+	{
+		v = round(v * other.v);
+		return *this;
+	}
+
+	Decimal& operator/=(Decimal other)
+	{
+		v = round(v / other.v);
+		return *this;
+	}
+
+	friend Decimal operator+(Decimal a, Decimal b)
+	{
+		return a += b;
+	}
+
+	friend Decimal operator-(Decimal a, Decimal b)
+	{
+		return a -= b;
+	}
+
+	friend Decimal operator*(Decimal a, Decimal b)
+	{
+		return a *= b;
+	}
+
+	friend Decimal operator/(Decimal a, Decimal b)
+	{
+		return a /= b;
+	}
+
+	friend bool operator==(Decimal a, Decimal b) { return a.v == b.v; }
+	friend bool operator!=(Decimal a, Decimal b) { return a.v != b.v; }
+	friend bool operator<(Decimal a, Decimal b) { return a.v < b.v; }
+	friend bool operator<=(Decimal a, Decimal b) { return a.v <= b.v; }
+	friend bool operator>(Decimal a, Decimal b) { return a.v > b.v; }
+	friend bool operator>=(Decimal a, Decimal b) { return a.v >= b.v; }
+
+	// Found by unqualified calls after `using std::abs;` etc. in the solvers.
+	friend Decimal abs(Decimal a)
+	{
+		return Decimal(std::fabs(a.v));
+	}
+
+	friend Decimal fabs(Decimal a)
+	{
+		return Decimal(std::fabs(a.v));
+	}
+
+	friend Decimal sqrt(Decimal a)
+	{
+		return Decimal(round(std::sqrt(a.v)));
+	}
+
+	friend bool isfinite(Decimal a)
+	{
+		return std::isfinite(a.v);
+	}
+
+	friend bool isnan(Decimal a)
+	{
+		return std::isnan(a.v);
+	}
+
+	friend bool isinf(Decimal a)
+	{
+		return std::isinf(a.v);
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, Decimal a)
+	{
+		return os << a.v;
+	}
+};
+
+// t chosen at run time (DecimalPrecision).
+using RuntimeDecimal = Decimal<0>;
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <string>
+
+// Unevaluated sum hi + lo of two doubles with |lo| <= ulp(hi) / 2: about 32
+// significant digits with double's exponent range. The arithmetic is built
+// from error-free transformations (two-sum, two-product) on plain doubles,
+// so it needs no library support, has no data-dependent branches and
+// vectorizes like double code. The products use a fused multiply-add when
+// the target has one and Dekker's splitting otherwise; the results are the
+// same. Comparisons are exact; +, -, * and / are accurate to a few units of
+// 2^-104 (Hida, Li, Bailey: the "accurate" QD algorithms).
+//
+// Like Decimal, it is a scalar for the templated solvers (solveAs<T>,
+// Basic*Stepper<T>); constructing from a double is exact.
+class DoubleDouble {
+private:
+	double hi = 0.0;
+	double lo = 0.0;
+
+	// s + e == a + b exactly.
+	static DoubleDouble twoSum(double a, double b)
+	{
+		const double s = a + b;
+		const double bb = s - a;
+		return DoubleDouble(s, (a - (s - bb)) + (b - bb));
+	}
+
+	// Same, for |a| >= |b|.
+	static DoubleDouble quickTwoSum(double a, double b)
+	{
+		const double s = a + b;
+		return DoubleDouble(s, b - (s - a));
+	}
+
+	// p + e == a * b exactly.
+	static DoubleDouble twoProd(double a, double b)
+	{
+		const double p = a * b;
+#if defined(__FMA__) || defined(__aarch64__) || defined(_M_ARM64)
+		return DoubleDouble(p, std::fma(a, b, -p));
+#else
+		constexpr double splitter = 134217729.0; // 2^27 + 1
+		const double ta = splitter * a;
+		const double aHi = ta - (ta - a);
+		const double aLo = a - aHi;
+		const double tb = splitter * b;
+		const double bHi = tb - (tb - b);
+		const double bLo = b - bHi;
+		return DoubleDouble(p, ((aHi * bHi - p) + aHi * bLo + aLo * bHi) + aLo * bLo);
+#endif
+	}
+
+	static DoubleDouble mulDouble(DoubleDouble a, double b)
+	{
+		DoubleDouble p = twoProd(a.hi, b);
+		p.lo += a.lo * b;
+		return quickTwoSum(p.hi, p.lo);
+	}
+
+public:
+	DoubleDouble() = default;
+
+	DoubleDouble(double value)
+		: hi(value)
+	{
+	}
+
+	// hi + lo as given; callers keep |lo| <= ulp(hi) / 2.
+	DoubleDouble(double hi, double lo)
+		: hi(hi), lo(lo)
+	{
+	}
+
+	// Nearest double-double to `value` (exact for 64-bit mantissas).
+	static DoubleDouble fromLongDouble(long double value)
+	{
+		const double high = static_cast<double>(value);
+		return DoubleDouble(high, static_cast<double>(value - static_cast<long double>(high)));
+	}
+
+	double high() const
+	{
+		return hi;
+	}
+
+	double low() const
+	{
+		return lo;
+	}
+
+	explicit operator double() const
+	{
+		return hi;
+	}
+
+	explicit operator long double() const
+	{
+		return static_cast<long double>(hi) + static_cast<long double>(lo);
+	}
+
+	DoubleDouble operator-() const
+	{
+		return DoubleDouble(-hi, -lo);
+	}
+
+	DoubleDouble operator+() const
+	{
+		return *this;
+	}
+
+	friend DoubleDouble operator+(DoubleDouble a, DoubleDouble b)
+	{
+		DoubleDouble s = twoSum(a.hi, b.hi);
+		const DoubleDouble t = twoSum(a.lo, b.lo);
+		s.lo += t.hi;
+		s = quickTwoSum(s.hi, s.lo);
+		s.lo += t.lo;
+		return quickTwoSum(s.hi, s.lo);
+	}
+
+	friend DoubleDouble operator-(DoubleDouble a, DoubleDouble b)
+	{
+		return a + (-b);
+	}
+
+	friend DoubleDouble operator*(DoubleDouble a, DoubleDouble b)
+	{
+		DoubleDouble p = twoProd(a.hi, b.hi);
+		p.lo += a.hi * b.lo + a.lo * b.hi;
+		return quickTwoSum(p.hi, p.lo);
+	}
+
+	friend DoubleDouble operator/(DoubleDouble a, DoubleDouble b)
+	{
+		// Three quotient digits, each from the remainder of the previous ones.
+		const double q1 = a.hi / b.hi;
+		DoubleDouble r = a - mulDouble(b, q1);
+		const double q2 = r.hi / b.hi;
+		r = r - mulDouble(b, q2);
+		const double q3 = r.hi / b.hi;
+		return quickTwoSum(q1, q2) + DoubleDouble(q3);
+	}
+
+	DoubleDouble& operator+=(DoubleDouble other)
+	{
+		return *this = *this + other;
+	}
+
+	DoubleDouble& operator-=(DoubleDouble other)
+	{
+		return *this = *this - other;
+	}
+
+	DoubleDouble& operator*=(DoubleDouble other)
+	{
+		return *this = *this * other;
+	}
+
+	DoubleDouble& operator/=(DoubleDouble other)
+	{
+		return *this = *this / other;
+	}
+
+	friend bool operator==(DoubleDouble a, DoubleDouble b) { return a.hi == b.hi && a.lo == b.lo; }
+	friend bool operator!=(DoubleDouble a, DoubleDouble b) { return !(a == b); }
+	friend bool operator<(DoubleDouble a, DoubleDouble b) { return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo); }
+	friend bool operator>(DoubleDouble a, DoubleDouble b) { return b < a; }
+	friend bool operator<=(DoubleDouble a, DoubleDouble b) { return a.hi < b.hi || (a.hi == b.hi && a.lo <= b.lo); }
+	friend bool operator>=(DoubleDouble a, DoubleDouble b) { return b <= a; }
+
+	// Found by unqualified calls after `using std::abs;` etc. in the solvers.
+	friend DoubleDouble abs(DoubleDouble a)
+	{
+		return a.hi < 0.0 ? -a : a;
+	}
+
+	friend DoubleDouble fabs(DoubleDouble a)
+	{
+		return abs(a);
+	}
+
+	// One Newton correction of the double square root (Karp's trick).
+	friend DoubleDouble sqrt(DoubleDouble a)
+	{
+		if (a.hi == 0.0)
+		{
+			return DoubleDouble(0.0);
+		}
+		if (a.hi < 0.0)
+		{
+			return DoubleDouble(std::numeric_limits<double>::quiet_NaN());
+		}
+		const double x = 1.0 / std::sqrt(a.hi);
+		const double ax = a.hi * x;
+		const double correction = (a - twoProd(ax, ax)).hi * (x * 0.5);
+		return twoSum(ax, correction);
+	}
+
+	friend bool isfinite(DoubleDouble a)
+	{
+		return std::isfinite(a.hi);
+	}
+
+	friend bool isnan(DoubleDouble a)
+	{
+		return std::isnan(a.hi);
+	}
+
+	friend bool isinf(DoubleDouble a)
+	{
+		return std::isinf(a.hi);
+	}
+
+	// Scientific form with `digits` significant digits (1..34), e.g.
+	// "3.3333333333333333333333333333333e-01"; the scaling by a power of ten
+	// can cost the last digit or two of the 32 the format holds.
+	std::string toString(int digits = 32) const;
+
+	// Writes toString() with the stream's precision when it was set above
+	// double's 17 digits, otherwise like a double.
+	friend std::ostream& operator<<(std::ostream& os, DoubleDouble a);
+};
@@ -1,23 +1,172 @@
 #pragma once
 
+#include "core/AlignedAllocator.h"
 #include "core/Vector.h"
 
-class Matrix {
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+// Row-major storage from Allocator (cache-line aligned by default). Rows are
+// stride() elements apart, colCount() rounded up to whole cache lines, so with
+// an aligned allocator every row() starts on a cache line and SIMD kernels may
+// use aligned loads on it; the padding is zero and not part of the matrix.
+template <typename T, typename Allocator = AlignedAllocator<T>>
+class BasicMatrix {
 private:
+	template <typename, typename>
+	friend class BasicMatrix;
+
 	std::size_t rows;
 	std::size_t cols;
-	std::vector<double> data; // row-major
+	std::size_t ld; // leading dimension
+	std::vector<T, Allocator> data;
 
 public:
-	Matrix(std::size_t rows, std::size_t cols);
+	using Scalar = T;
+	using AllocatorType = Allocator;
+
+	BasicMatrix(std::size_t rows, std::size_t cols, const Allocator& allocator = Allocator());
+
+	// Copy of a matrix stored with another allocator.
+	template <typename OtherAllocator>
+	explicit BasicMatrix(const BasicMatrix<T, OtherAllocator>& other, const Allocator& allocator = Allocator());
 
 	std::size_t rowCount() const;
 	std::size_t colCount() const;
 
-	double &operator()(std::size_t i, std::size_t j);
-	const double &operator()(std::size_t i, std::size_t j) const;
+	// Elements from the start of one row to the start of the next.
+	std::size_t stride() const;
+
+	Allocator allocator() const;
+
+	T &operator()(std::size_t i, std::size_t j);
+	const T &operator()(std::size_t i, std::size_t j) const;
 
-	static Matrix identity(std::size_t n);
+	// Row i as colCount() contiguous values.
+	T *row(std::size_t i);
+	const T *row(std::size_t i) const;
 
-	Vector multiply(const Vector &x) const;
+	static BasicMatrix identity(std::size_t n, const Allocator& allocator = Allocator());
+
+	BasicVector<T, Allocator> multiply(const BasicVector<T, Allocator> &x) const;
 };
+
+using Matrix = BasicMatrix<double>;
+
+template <typename T, typename Allocator>
+BasicMatrix<T, Allocator>::BasicMatrix(std::size_t rows, std::size_t cols, const Allocator& allocator)
+	: rows(rows), cols(cols), ld(paddedRowLength<T>(cols)), data(rows * paddedRowLength<T>(cols), T(0.0), allocator)
+{
+}
+
+template <typename T, typename Allocator>
+template <typename OtherAllocator>
+BasicMatrix<T, Allocator>::BasicMatrix(const BasicMatrix<T, OtherAllocator>& other, const Allocator& allocator)
+	: rows(other.rows), cols(other.cols), ld(other.ld), data(other.data.begin(), other.data.end(), allocator)
+{
+}
+
+template <typename T, typename Allocator>
+std::size_t BasicMatrix<T, Allocator>::rowCount() const
+{
+	return rows;
+}
+
+template <typename T, typename Allocator>
+std::size_t BasicMatrix<T, Allocator>::colCount() const
+{
+	return cols;
+}
+
+template <typename T, typename Allocator>
+std::size_t BasicMatrix<T, Allocator>::stride() const
+{
+	return ld;
+}
+
+template <typename T, typename Allocator>
+Allocator BasicMatrix<T, Allocator>::allocator() const
+{
+	return data.get_allocator();
+}
+
+template <typename T, typename Allocator>
+T& BasicMatrix<T, Allocator>::operator()(std::size_t i, std::size_t j)
+{
+	if (i >= rows || j >= cols)
+	{
+		throw std::out_of_range("Matrix index out of range");
+	}
+	return data[i * ld + j];
+}
+
+template <typename T, typename Allocator>
+const T& BasicMatrix<T, Allocator>::operator()(std::size_t i, std::size_t j) const
+{
+	if (i >= rows || j >= cols)
+	{
+		throw std::out_of_range("Matrix index out of range");
+	}
+	return data[i * ld + j];
+}
+
+template <typename T, typename Allocator>
+T* BasicMatrix<T, Allocator>::row(std::size_t i)
+{
+	if (i >= rows)
+	{
+		throw std::out_of_range("Matrix row out of range");
+	}
+	return data.data() + i * ld;
+}
+
+template <typename T, typename Allocator>
+const T* BasicMatrix<T, Allocator>::row(std::size_t i) const
+{
+	if (i >= rows)
+	{
+		throw std::out_of_range("Matrix row out of range");
+	}
+	return data.data() + i * ld;
+}
+
+template <typename T, typename Allocator>
+BasicMatrix<T, Allocator> BasicMatrix<T, Allocator>::identity(std::size_t n, const Allocator& allocator)
+{
+	BasicMatrix I(n, n, allocator);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		I(i, i) = T(1.0);
+	}
+	return I;
+}
+
+template <typename T, typename Allocator>
+BasicVector<T, Allocator> BasicMatrix<T, Allocator>::multiply(const BasicVector<T, Allocator>& x) const
+{
+	if (x.size() != cols)
+	{
+		throw std::invalid_argument("Matrix::multiply dimension mismatch");
+	}
+
+	BasicVector<T, Allocator> y(rows, data.get_allocator());
+	for (std::size_t i = 0; i < rows; ++i)
+	{
+		T sum = T(0.0);
+		for (std::size_t j = 0; j < cols; ++j)
+		{
+			sum += (*this)(i, j) * x[j];
+		}
+		y[i] = sum;
+	}
+
+	return y;
+}
+
+// Instantiated once in Matrix.cpp.
+extern template class BasicMatrix<double>;
+extern template class BasicMatrix<float>;
+extern template class BasicMatrix<long double>;
+extern template class BasicMatrix<std::complex<double>>;
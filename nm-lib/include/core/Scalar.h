@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <utility>
+
+// What the templated containers and solvers need from a scalar type T
+// (double, float, long double, std::complex, Decimal, DoubleDouble): the
+// magnitude |v| and a finiteness test. Both are found through std:: or by
+// argument-dependent lookup, so a scalar class provides them as friends
+// named abs and isfinite.
+template <typename T>
+auto scalarAbs(const T& v)
+{
+	using std::abs;
+	return abs(v);
+}
+
+template <typename T>
+bool scalarIsFinite(const T& v)
+{
+	using std::isfinite;
+	return isfinite(v);
+}
+
+template <typename T>
+bool scalarIsFinite(const std::complex<T>& v)
+{
+	return scalarIsFinite(v.real()) && scalarIsFinite(v.imag());
+}
+
+// Type of |v|: T itself for real types, the component type for std::complex.
+template <typename T>
+using ScalarMagnitude = decltype(scalarAbs(std::declval<const T&>()));
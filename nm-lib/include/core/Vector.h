@@ -1,19 +1,107 @@
 #pragma once
 
+#include "core/AlignedAllocator.h"
+#include "core/Scalar.h"
+
+#include <complex>
+#include <cstddef>
+#include <initializer_list>
 #include <vector>
 
-class Vector {
+// Storage comes from Allocator: cache-line aligned by default, or any
+// standard allocator (HugePageAllocator, an arena, ...).
+template <typename T, typename Allocator = AlignedAllocator<T>>
+class BasicVector {
 private:
-	std::vector<double> data;
+	template <typename, typename>
+	friend class BasicVector;
+
+	std::vector<T, Allocator> data;
 
 public:
-	explicit Vector(std::size_t n);
-	Vector(std::initializer_list<double> init);
+	using Scalar = T;
+	using AllocatorType = Allocator;
+
+	explicit BasicVector(std::size_t n, const Allocator& allocator = Allocator());
+	BasicVector(std::initializer_list<T> init, const Allocator& allocator = Allocator());
+
+	// Copy of a vector stored with another allocator.
+	template <typename OtherAllocator>
+	explicit BasicVector(const BasicVector<T, OtherAllocator>& other, const Allocator& allocator = Allocator());
 
 	std::size_t size() const;
 
-	double& operator[](std::size_t i);
-	const double& operator[](std::size_t i) const;
+	Allocator allocator() const;
 
-	double normInf() const;
+	T& operator[](std::size_t i);
+	const T& operator[](std::size_t i) const;
+
+	// max |x_i|, real even for complex entries.
+	ScalarMagnitude<T> normInf() const;
 };
+
+using Vector = BasicVector<double>;
+
+template <typename T, typename Allocator>
+BasicVector<T, Allocator>::BasicVector(std::size_t n, const Allocator& allocator)
+	: data(n, T(0.0), allocator)
+{
+}
+
+template <typename T, typename Allocator>
+BasicVector<T, Allocator>::BasicVector(std::initializer_list<T> init, const Allocator& allocator)
+	: data(init, allocator)
+{
+}
+
+template <typename T, typename Allocator>
+template <typename OtherAllocator>
+BasicVector<T, Allocator>::BasicVector(const BasicVector<T, OtherAllocator>& other, const Allocator& allocator)
+	: data(other.data.begin(), other.data.end(), allocator)
+{
+}
+
+template <typename T, typename Allocator>
+std::size_t BasicVector<T, Allocator>::size() const
+{
+	return data.size();
+}
+
+template <typename T, typename Allocator>
+Allocator BasicVector<T, Allocator>::allocator() const
+{
+	return data.get_allocator();
+}
+
+template <typename T, typename Allocator>
+T& BasicVector<T, Allocator>::operator[](std::size_t i)
+{
+	return data.at(i);
+}
+
+template <typename T, typename Allocator>
+const T& BasicVector<T, Allocator>::operator[](std::size_t i) const
+{
+	return data.at(i);
+}
+
+template <typename T, typename Allocator>
+ScalarMagnitude<T> BasicVector<T, Allocator>::normInf() const
+{
+	ScalarMagnitude<T> maxAbs = ScalarMagnitude<T>(0.0);
+	for (const T& value : data)
+	{
+		const ScalarMagnitude<T> absValue = scalarAbs(value);
+		if (absValue > maxAbs)
+		{
+			maxAbs = absValue;
+		}
+	}
+	return maxAbs;
+}
+
+// Instantiated once in Vector.cpp.
+extern template class BasicVector<double>;
+extern template class BasicVector<float>;
+extern template class BasicVector<long double>;
+extern template class BasicVector<std::complex<double>>;
@@ -4,9 +4,196 @@
 
 #include "linear/IterativeTrace.h"
 
+#include "utils/Cancellation.h"
+#include "utils/Exceptions.h"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+// Resumable Gauss-Seidel sweeps: current() starts as iteration 0 (x0) and each
+// step() performs one sweep in place, so current().x is the latest iterate
+// (no copy). There is no stop criterion; the caller decides how many sweeps
+// to run and step() always returns true. The system must outlive the stepper.
+class GaussSeidelStepper {
+private:
+	const Matrix& A;
+	const Vector& b;
+	IterativeTraceStep state;
+
+public:
+	GaussSeidelStepper(const LinearSystem& system, const Vector& x0);
+
+	bool step();
+
+	std::size_t iterations() const;
+	const IterativeTraceStep& current() const;
+};
+
 class GaussSeidelSolver {
+private:
+	friend class GaussSeidelStepper;
+
+	template <typename T>
+	static void validate(const BasicLinearSystem<T>& system, const BasicVector<T>& x0);
+
 public:
 	GaussSeidelSolver() = delete;
     
+	// Records into `trace` when given; the untraced run is the NoTrace kernel.
 	static Vector iterate(const LinearSystem& system, const Vector& x0, std::size_t iterations, IterativeMethodTrace* trace = nullptr);
+
+	// Kernel templated on a trace sink (utils/TraceSink.h).
+	template <typename Sink>
+	static Vector iterate(const LinearSystem& system, const Vector& x0, std::size_t iterations, Sink& sink);
+
+	// Checks `stop` (utils/Cancellation.h) before every sweep; when stopped
+	// early the latest iterate is returned with the sweeps done so far.
+	template <typename Sink>
+	static SolveOutcome<Vector> iterate(const LinearSystem& system, const Vector& x0, std::size_t iterations, Sink& sink, const StopCondition& stop);
+
+	// `iterations` sweeps in the system's own scalar type (float, long double,
+	// std::complex<double>, ...), untraced.
+	template <typename T>
+	static BasicVector<T> iterate(const BasicLinearSystem<T>& system, const BasicVector<T>& x0, std::size_t iterations);
+
+	// Runs `iterations` sweeps in the arithmetic of T, e.g. Decimal<t>
+	// (core/Decimal.h) for t-digit iterates; A, b and x0 are read as T.
+	template <typename T, typename Source>
+	static std::vector<T> iterateAs(const BasicLinearSystem<Source>& system, const BasicVector<Source>& x0, std::size_t iterations);
+
+	// One sweep computed in T, updating x in place (x_i already uses the new
+	// x_0..x_{i-1}). The stepper runs it with T = double; Iterate is Vector or
+	// std::vector<T>.
+	template <typename T, typename Source, typename Iterate>
+	static void sweep(const BasicMatrix<Source>& A, const BasicVector<Source>& b, Iterate& x);
 };
+
+template <typename Sink>
+Vector GaussSeidelSolver::iterate(const LinearSystem& system, const Vector& x0, std::size_t iterations, Sink& sink)
+{
+	GaussSeidelStepper stepper(system, x0);
+
+	if constexpr (Sink::enabled)
+	{
+		sink.record(stepper.current());
+	}
+
+	for (std::size_t it = 0; it < iterations; it++)
+	{
+		stepper.step();
+
+		if constexpr (Sink::enabled)
+		{
+			sink.record(stepper.current());
+		}
+	}
+
+	return stepper.current().x;
+}
+
+template <typename Sink>
+SolveOutcome<Vector> GaussSeidelSolver::iterate(const LinearSystem& system, const Vector& x0, std::size_t iterations, Sink& sink, const StopCondition& stop)
+{
+	GaussSeidelStepper stepper(system, x0);
+
+	if constexpr (Sink::enabled)
+	{
+		sink.record(stepper.current());
+	}
+
+	for (std::size_t it = 0; it < iterations; it++)
+	{
+		const SolveStatus status = stop.check();
+		if (status != SolveStatus::Completed)
+		{
+			return { status, stepper.current().x, stepper.iterations() };
+		}
+
+		stepper.step();
+
+		if constexpr (Sink::enabled)
+		{
+			sink.record(stepper.current());
+		}
+	}
+
+	return { SolveStatus::Completed, stepper.current().x, stepper.iterations() };
+}
+
+template <typename T>
+void GaussSeidelSolver::validate(const BasicLinearSystem<T>& system, const BasicVector<T>& x0)
+{
+	const std::size_t n = system.size();
+	if (system.matrix().rowCount() != n || system.matrix().colCount() != n || system.rhs().size() != n)
+	{
+		throw DimensionMismatchException("GaussSeidelSolver::iterate: dimension mismatch");
+	}
+	if (x0.size() != n)
+	{
+		throw DimensionMismatchException("GaussSeidelSolver::iterate: x0 dimension mismatch");
+	}
+}
+
+template <typename T>
+BasicVector<T> GaussSeidelSolver::iterate(const BasicLinearSystem<T>& system, const BasicVector<T>& x0, std::size_t iterations)
+{
+	const std::vector<T> values = iterateAs<T>(system, x0, iterations);
+	BasicVector<T> x(values.size());
+	for (std::size_t i = 0; i < values.size(); i++)
+	{
+		x[i] = values[i];
+	}
+	return x;
+}
+
+template <typename T, typename Source>
+std::vector<T> GaussSeidelSolver::iterateAs(const BasicLinearSystem<Source>& system, const BasicVector<Source>& x0, std::size_t iterations)
+{
+	validate(system, x0);
+
+	std::vector<T> x(x0.size());
+	for (std::size_t i = 0; i < x0.size(); i++)
+	{
+		x[i] = T(x0[i]);
+	}
+
+	for (std::size_t it = 0; it < iterations; it++)
+	{
+		sweep<T>(system.matrix(), system.rhs(), x);
+	}
+	return x;
+}
+
+template <typename T, typename Source, typename Iterate>
+void GaussSeidelSolver::sweep(const BasicMatrix<Source>& A, const BasicVector<Source>& b, Iterate& x)
+{
+	const std::size_t n = b.size();
+
+	constexpr double diagEps = 1e-15;
+	for (std::size_t i = 0; i < n; i++)
+	{
+		const Source aii = A(i, i);
+		if (scalarAbs(aii) < diagEps)
+		{
+			throw SingularMatrixException("GaussSeidelSolver::iterate: zero diagonal entry");
+		}
+
+		T sum = T(0.0);
+		for (std::size_t j = 0; j < n; j++)
+		{
+			if (j == i)
+			{
+				continue;
+			}
+			sum += T(A(i, j)) * x[j];
+		}
+
+		x[i] = (T(b[i]) - sum) / T(aii);
+	}
+}
+
+// Instantiated once in GaussSeidel.cpp.
+extern template BasicVector<float> GaussSeidelSolver::iterate<float>(const BasicLinearSystem<float>&, const BasicVector<float>&, std::size_t);
+extern template BasicVector<long double> GaussSeidelSolver::iterate<long double>(const BasicLinearSystem<long double>&, const BasicVector<long double>&, std::size_t);
+extern template BasicVector<std::complex<double>> GaussSeidelSolver::iterate<std::complex<double>>(const BasicLinearSystem<std::complex<double>>&, const BasicVector<std::complex<double>>&, std::size_t);
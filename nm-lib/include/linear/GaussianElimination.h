@@ -1,9 +1,19 @@
 #pragma once
 
+#include "core/Arena.h"
+
 #include "linear/LinearSystem.h"
 
+#include "utils/Cancellation.h"
+#include "utils/Exceptions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
 #include <cstddef>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 struct GaussianEliminationTraceStep
@@ -11,10 +21,15 @@ struct GaussianEliminationTraceStep
 	std::size_t k;
 	std::size_t pivotRow;
 	bool swapped;
-	Matrix A;
-	Vector b;
+	// Index in GaussianEliminationTrace::operations after which the matrix
+	// is the one at the end of this step (use GaussianEliminationReplay).
+	std::size_t operation;
 };
 
+// Delta-encoded trace: each operation records what changed (rows swapped,
+// the multiplier of a row update, a computed x_i), not the matrix. Any
+// intermediate matrix is rebuilt by GaussianEliminationReplay from the
+// nearest checkpoint, so the trace holds O(n^2 + operations) values.
 struct GaussianEliminationTrace
 {
 	std::vector<GaussianEliminationTraceStep> forwardSteps;
@@ -22,23 +37,314 @@ struct GaussianEliminationTrace
 	// Fine-grained trace, suitable for a step-by-step slideshow:
 	// - forward: pivot choice, row swaps, and each row operation
 	// - back: each back-substitution step that computes x_i
+	enum class OperationKind
+	{
+		Initial,          // augmented matrix as given
+		Pivot,            // pivot of column k is row `row`
+		Swap,             // rows k and `row` swapped
+		Eliminate,        // R_row <- R_row - value * R_k
+		Eliminated,       // upper triangular matrix reached
+		BackSubstitution, // x_row = value
+		Final
+	};
+
 	struct OperationStep
 	{
-		std::string phase; // "forward" | "back"
-		std::string op;    // human-readable operation label
+		OperationKind kind;
+		std::size_t k;
+		std::size_t row;
+		double value;
+
+		const char* phase() const; // "forward" | "back"
+		std::string label() const; // human-readable operation label
+		bool hasSolveValue() const;
+		std::size_t solveIndex() const; // 0-based index for x
+		double solveValue() const;
+	};
+
+	struct Checkpoint
+	{
+		std::size_t operation; // state after operations[operation]
 		Matrix A;
 		Vector b;
-		bool hasSolveValue;
-		std::size_t solveIndex; // 0-based index for x
-		double solveValue;
 	};
 
 	std::vector<OperationStep> operations;
+	std::vector<Checkpoint> checkpoints;
+
+	// Operations between checkpoints; 0 picks about n^2 / 8, which keeps a
+	// handful of matrix copies however large the system is.
+	std::size_t checkpointInterval = 0;
+
+	// Rounding of the traced run, needed to replay row updates exactly.
+	int significantDigits = 0;
+};
+
+// Cursor over the matrices of a trace. Moving forward applies the recorded
+// operations (a row update is recomputed with the same rounding, so the
+// result is bit-identical to the traced run); moving backward restarts from
+// the closest checkpoint.
+class GaussianEliminationReplay {
+private:
+	const GaussianEliminationTrace& trace;
+	Matrix A;
+	Vector b;
+	std::size_t current;
+
+	void apply(const GaussianEliminationTrace::OperationStep& step);
+
+public:
+	explicit GaussianEliminationReplay(const GaussianEliminationTrace& trace);
+
+	// Moves to the state after trace.operations[operation].
+	void seek(std::size_t operation);
+
+	std::size_t position() const;
+	const Matrix& matrix() const;
+	const Vector& rhs() const;
+};
+
+// Measurements of one elimination, filled when passed to solve().
+struct GaussianEliminationStats
+{
+	// max |a_ij^(k)| over every stage k of the (rounded) elimination, divided
+	// by max |a_ij| of the input: how much the entries grew.
+	double growthFactor = 0.0;
+};
+
+// PA = LU with partial pivoting, row-major n x n with rows `stride` apart
+// (cache-line aligned and padded like BasicMatrix): U on and above the
+// diagonal, the multipliers of L (unit diagonal) below it. Row k was swapped
+// with row pivotRows[k] at step k. Both arrays come from Allocator.
+template <typename T, typename Allocator = AlignedAllocator<T>>
+struct LUFactors
+{
+	using IndexAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>;
+
+	std::size_t n = 0;
+	std::size_t stride = 0;
+	std::vector<T, Allocator> lu;
+	std::vector<std::size_t, IndexAllocator> pivotRows;
+
+	explicit LUFactors(const Allocator& allocator = Allocator())
+		: lu(allocator), pivotRows(IndexAllocator(allocator))
+	{
+	}
 };
 
 class GaussianElimination {
+private:
+	// target[j] -= multiplier * source[j] for j < count. Unrolled by four over
+	// rows that do not alias, which -O2 packs into SIMD lanes (four floats or
+	// two doubles per instruction); each element is computed as in a plain loop.
+	template <typename T>
+	static void subtractScaledRow(T* __restrict target, const T* __restrict source, T multiplier, std::size_t count);
+
 public:
 	GaussianElimination() = delete;
 
-	static Vector solve(LinearSystem system, int significantDigits, GaussianEliminationTrace* trace = nullptr);
+	static Vector solve(const LinearSystem& system, int significantDigits, GaussianEliminationTrace* trace = nullptr);
+
+	// Checks `stop` (utils/Cancellation.h) before each pivot column and each
+	// back-substitution row. When stopped early, x holds the components
+	// back-substituted so far (zeros elsewhere) and `iterations` counts the
+	// columns and rows done; the trace ends at the last recorded operation.
+	static SolveOutcome<Vector> solve(const LinearSystem& system, int significantDigits, const StopCondition& stop, GaussianEliminationTrace* trace = nullptr, GaussianEliminationStats* stats = nullptr);
+
+	// Elimination with partial pivoting in the system's own scalar type
+	// (float, long double, std::complex<double>, ...), without rounding.
+	template <typename T>
+	static BasicVector<T> solve(const BasicLinearSystem<T>& system);
+
+	// The same elimination (partial pivoting, back substitution, operation
+	// order) in the arithmetic of T, reading the entries as T. With
+	// T = Decimal<t> (core/Decimal.h), or RuntimeDecimal inside
+	// DecimalPrecision(t), every operation is rounded where solve(system, t)
+	// rounds it, so the results are identical.
+	template <typename T, typename Source>
+	static std::vector<T> solveAs(const BasicLinearSystem<Source>& system);
+
+	// The elimination of solveAs split in two, to solve for several right-hand
+	// sides: factor() computes PA = LU in T and solveFactored() applies it to
+	// b. Both throw SingularMatrixException like solve(). A may use any
+	// allocator; the factors use `allocator` (e.g. an ArenaAllocator<T>
+	// inside an ArenaScope, as solveAs does).
+	template <typename T, typename Source, typename SourceAllocator, typename Allocator = AlignedAllocator<T>>
+	static LUFactors<T, Allocator> factor(const BasicMatrix<Source, SourceAllocator>& A, const Allocator& allocator = Allocator());
+
+	template <typename T, typename Allocator, typename VectorAllocator>
+	static std::vector<T> solveFactored(const LUFactors<T, Allocator>& factors, std::vector<T, VectorAllocator> b);
 };
+
+template <typename T>
+BasicVector<T> GaussianElimination::solve(const BasicLinearSystem<T>& system)
+{
+	const std::vector<T> solution = solveAs<T>(system);
+	BasicVector<T> x(solution.size());
+	for (std::size_t i = 0; i < solution.size(); i++)
+	{
+		x[i] = solution[i];
+	}
+	return x;
+}
+
+template <typename T, typename Source>
+std::vector<T> GaussianElimination::solveAs(const BasicLinearSystem<Source>& system)
+{
+	const std::size_t n = system.size();
+	const BasicMatrix<Source>& A = system.matrix();
+	const BasicVector<Source>& b = system.rhs();
+
+	if (A.rowCount() != n || A.colCount() != n || b.size() != n)
+	{
+		throw DimensionMismatchException("GaussianElimination::solve: dimension mismatch");
+	}
+
+	// The factors and the permuted right-hand side are scratch.
+	ArenaScope scope;
+	ArenaBuffer<T> rhs(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		rhs[i] = T(b[i]);
+	}
+	return solveFactored(factor<T>(A, ArenaAllocator<T>()), std::move(rhs));
+}
+
+template <typename T, typename Source, typename SourceAllocator, typename Allocator>
+LUFactors<T, Allocator> GaussianElimination::factor(const BasicMatrix<Source, SourceAllocator>& Aref, const Allocator& allocator)
+{
+	using Magnitude = ScalarMagnitude<T>;
+
+	const std::size_t n = Aref.rowCount();
+	if (Aref.colCount() != n)
+	{
+		throw DimensionMismatchException("GaussianElimination::solve: dimension mismatch");
+	}
+
+	LUFactors<T, Allocator> factors(allocator);
+	factors.n = n;
+	factors.stride = paddedRowLength<T>(n);
+	factors.lu.resize(n * factors.stride);
+	factors.pivotRows.resize(n);
+	const std::size_t ld = factors.stride;
+	std::vector<T, Allocator>& A = factors.lu;
+	for (std::size_t i = 0; i < n; i++)
+	{
+		const Source* row = Aref.row(i);
+		for (std::size_t j = 0; j < n; j++)
+		{
+			A[i * ld + j] = T(row[j]);
+		}
+	}
+
+	const Magnitude pivotEps = Magnitude(1e-15);
+	for (std::size_t k = 0; k < n; k++)
+	{
+		std::size_t pivotRow = k;
+		Magnitude maxAbs = scalarAbs(A[k * ld + k]);
+		for (std::size_t i = k + 1; i < n; i++)
+		{
+			const Magnitude candidate = scalarAbs(A[i * ld + k]);
+			if (candidate > maxAbs)
+			{
+				maxAbs = candidate;
+				pivotRow = i;
+			}
+		}
+
+		if (maxAbs < pivotEps)
+		{
+			throw SingularMatrixException("GaussianElimination::solve: singular matrix (zero pivot)");
+		}
+
+		factors.pivotRows[k] = pivotRow;
+		if (pivotRow != k)
+		{
+			std::swap_ranges(A.begin() + k * ld, A.begin() + k * ld + n, A.begin() + pivotRow * ld);
+		}
+
+		const T pivot = A[k * ld + k];
+		const T* source = A.data() + k * ld;
+		for (std::size_t i = k + 1; i < n; i++)
+		{
+			T* target = A.data() + i * ld;
+			const T multiplier = target[k] / pivot;
+			target[k] = multiplier;
+			subtractScaledRow(target + k + 1, source + k + 1, multiplier, n - k - 1);
+		}
+	}
+	return factors;
+}
+
+template <typename T>
+void GaussianElimination::subtractScaledRow(T* __restrict target, const T* __restrict source, T multiplier, std::size_t count)
+{
+	std::size_t j = 0;
+	for (; j + 4 <= count; j += 4)
+	{
+		target[j] -= multiplier * source[j];
+		target[j + 1] -= multiplier * source[j + 1];
+		target[j + 2] -= multiplier * source[j + 2];
+		target[j + 3] -= multiplier * source[j + 3];
+	}
+	for (; j < count; j++)
+	{
+		target[j] -= multiplier * source[j];
+	}
+}
+
+template <typename T, typename Allocator, typename VectorAllocator>
+std::vector<T> GaussianElimination::solveFactored(const LUFactors<T, Allocator>& factors, std::vector<T, VectorAllocator> b)
+{
+	using Magnitude = ScalarMagnitude<T>;
+
+	const std::size_t n = factors.n;
+	const std::size_t ld = factors.stride;
+	const std::vector<T, Allocator>& A = factors.lu;
+	if (b.size() != n)
+	{
+		throw DimensionMismatchException("GaussianElimination::solve: dimension mismatch");
+	}
+
+	// Every row keeps its own updates through the swaps, so permuting b first
+	// and substituting with L afterwards repeats the elimination's operations.
+	for (std::size_t k = 0; k < n; k++)
+	{
+		std::swap(b[k], b[factors.pivotRows[k]]);
+	}
+	for (std::size_t k = 0; k < n; k++)
+	{
+		for (std::size_t i = k + 1; i < n; i++)
+		{
+			b[i] -= A[i * ld + k] * b[k];
+		}
+	}
+
+	const Magnitude pivotEps = Magnitude(1e-15);
+	std::vector<T> x(n, T(0.0));
+	for (std::size_t ii = 0; ii < n; ii++)
+	{
+		const std::size_t i = n - 1 - ii;
+
+		T sum = T(0.0);
+		for (std::size_t j = i + 1; j < n; j++)
+		{
+			sum += A[i * ld + j] * x[j];
+		}
+
+		const T diag = A[i * ld + i];
+		if (scalarAbs(diag) < pivotEps)
+		{
+			throw SingularMatrixException("GaussianElimination::solve: singular matrix (zero diagonal)");
+		}
+
+		x[i] = (b[i] - sum) / diag;
+	}
+	return x;
+}
+
+// Instantiated once in GaussianElimination.cpp.
+extern template BasicVector<double> GaussianElimination::solve<double>(const BasicLinearSystem<double>&);
+extern template BasicVector<float> GaussianElimination::solve<float>(const BasicLinearSystem<float>&);
+extern template BasicVector<long double> GaussianElimination::solve<long double>(const BasicLinearSystem<long double>&);
+extern template BasicVector<std::complex<double>> GaussianElimination::solve<std::complex<double>>(const BasicLinearSystem<std::complex<double>>&);
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "linear/LinearSystem.h"
+
+#include <cstddef>
+#include <string>
+
+// Precision of the residuals r = b - A x of the refinement.
+enum class RefinementResidual
+{
+	// Converges to a small backward error, like a double solve.
+	Double,
+	// Accumulated exactly in DoubleDouble: the forward error also reaches
+	// double precision when cond(A) is well below 1 / float's epsilon.
+	DoubleDouble
+};
+
+struct IterativeRefinementResult
+{
+	Vector x = Vector(0);
+	// Corrections applied to the float solution.
+	std::size_t iterations = 0;
+	// True when refinement did not converge and x comes from a double
+	// factorization instead; `reason` says why.
+	bool fellBack = false;
+	std::string reason;
+	// ||b - A x||inf / (||A||inf ||x||inf + ||b||inf) of the returned x.
+	double backwardError = 0.0;
+};
+
+// Mixed-precision solve of a dense system: A is factored once in float (half
+// the memory traffic and twice the SIMD lanes of double), then the float
+// solution is corrected with residuals computed in double or double-double,
+// each correction solved with the float factors. When a correction fails to
+// shrink by half (refinement stalls, typically for cond(A) near 1e7 or more),
+// an entry of A or b lies outside float's range, the float factorization
+// fails, or maxIterations pass, the system is solved
+// by a double factorization instead; if that one fails too, its
+// SingularMatrixException propagates. x is only accepted from the float path
+// when ||b - A x||inf <= ||A||inf ||x||inf eps sqrt(n).
+class IterativeRefinement {
+public:
+	IterativeRefinement() = delete;
+
+	static IterativeRefinementResult solve(const LinearSystem& system, RefinementResidual residual = RefinementResidual::Double, std::size_t maxIterations = 30);
+};
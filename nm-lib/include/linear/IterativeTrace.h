@@ -2,8 +2,9 @@
 
 #include "core/Vector.h"
 
+#include "utils/TraceSink.h"
+
 #include <cstddef>
-#include <vector>
 
 struct IterativeTraceStep
 {
@@ -11,7 +12,6 @@ struct IterativeTraceStep
     Vector x;
 };
 
-struct IterativeMethodTrace
+struct IterativeMethodTrace : StepTrace<IterativeTraceStep>
 {
-    std::vector<IterativeTraceStep> steps;
 };
\ No newline at end of file
@@ -1,12 +1,224 @@
 #pragma once
 
+#include "core/Arena.h"
+
 #include "linear/LinearSystem.h"
 
 #include "linear/IterativeTrace.h"
 
+#include "utils/Cancellation.h"
+#include "utils/Exceptions.h"
+
+#include <cmath>
+#include <complex>
+#include <utility>
+#include <vector>
+
+// Resumable Jacobi sweeps: current() starts as iteration 0 (x0) and each
+// step() performs one sweep in place, so current().x is the latest iterate
+// (no copy). There is no stop criterion; the caller decides how many sweeps
+// to run and step() always returns true. The system must outlive the stepper.
+class JacobiStepper {
+private:
+	const Matrix& A;
+	const Vector& b;
+	IterativeTraceStep state;
+	// Scratch for the sweep in progress: Jacobi reads only the previous iterate.
+	Vector next;
+
+public:
+	JacobiStepper(const LinearSystem& system, const Vector& x0);
+
+	bool step();
+
+	std::size_t iterations() const;
+	const IterativeTraceStep& current() const;
+};
+
 class JacobiSolver {
+private:
+	friend class JacobiStepper;
+
+	template <typename T>
+	static void validate(const BasicLinearSystem<T>& system, const BasicVector<T>& x0);
+
+	// Up to `iterations` sweeps in T with both iterates in the thread's arena,
+	// checking `stop` before each; the last iterate is written to `out` (a
+	// vector of T of x0's size) and the number of sweeps done is returned.
+	template <typename T, typename Source, typename Out>
+	static std::size_t iterateInArena(const BasicLinearSystem<Source>& system, const BasicVector<Source>& x0, std::size_t iterations, Out& out, const StopCondition& stop = StopCondition{});
+
 public:
 	JacobiSolver() = delete;    
     
+	// Records into `trace` when given; the untraced run is the NoTrace kernel.
 	static Vector iterate(const LinearSystem& system, const Vector& x0, std::size_t iterations, IterativeMethodTrace* trace = nullptr);
+
+	// Kernel templated on a trace sink (utils/TraceSink.h).
+	template <typename Sink>
+	static Vector iterate(const LinearSystem& system, const Vector& x0, std::size_t iterations, Sink& sink);
+
+	// Checks `stop` (utils/Cancellation.h) before every sweep; when stopped
+	// early the latest iterate is returned with the sweeps done so far.
+	template <typename Sink>
+	static SolveOutcome<Vector> iterate(const LinearSystem& system, const Vector& x0, std::size_t iterations, Sink& sink, const StopCondition& stop);
+
+	// `iterations` sweeps in the system's own scalar type (float, long double,
+	// std::complex<double>, ...), untraced.
+	template <typename T>
+	static BasicVector<T> iterate(const BasicLinearSystem<T>& system, const BasicVector<T>& x0, std::size_t iterations);
+
+	// Runs `iterations` sweeps in the arithmetic of T, e.g. Decimal<t>
+	// (core/Decimal.h) for t-digit iterates; A, b and x0 are read as T.
+	template <typename T, typename Source>
+	static std::vector<T> iterateAs(const BasicLinearSystem<Source>& system, const BasicVector<Source>& x0, std::size_t iterations);
+
+	// One sweep computed in T: next = D^-1 (b - (L + U) xPrev). The stepper
+	// runs it with T = double; Iterate is Vector or a std::vector of T.
+	template <typename T, typename Source, typename Iterate>
+	static void sweep(const BasicMatrix<Source>& A, const BasicVector<Source>& b, const Iterate& xPrev, Iterate& next);
 };
+
+template <typename Sink>
+Vector JacobiSolver::iterate(const LinearSystem& system, const Vector& x0, std::size_t iterations, Sink& sink)
+{
+	if constexpr (!Sink::enabled)
+	{
+		// Nothing observes the iterates: skip the stepper and its heap scratch.
+		return iterate<double>(system, x0, iterations);
+	}
+	else
+	{
+		JacobiStepper stepper(system, x0);
+		sink.record(stepper.current());
+		for (std::size_t it = 0; it < iterations; it++)
+		{
+			stepper.step();
+			sink.record(stepper.current());
+		}
+		return stepper.current().x;
+	}
+}
+
+template <typename Sink>
+SolveOutcome<Vector> JacobiSolver::iterate(const LinearSystem& system, const Vector& x0, std::size_t iterations, Sink& sink, const StopCondition& stop)
+{
+	if constexpr (!Sink::enabled)
+	{
+		// Untraced: the arena kernel, stopping between sweeps. A stop is
+		// permanent (a cancelled token or an expired deadline), so checking
+		// again tells why the kernel ended early.
+		Vector x(x0.size());
+		const std::size_t done = iterateInArena<double>(system, x0, iterations, x, stop);
+		return { done < iterations ? stop.check() : SolveStatus::Completed, std::move(x), done };
+	}
+	else
+	{
+		JacobiStepper stepper(system, x0);
+		sink.record(stepper.current());
+		for (std::size_t it = 0; it < iterations; it++)
+		{
+			const SolveStatus status = stop.check();
+			if (status != SolveStatus::Completed)
+			{
+				return { status, stepper.current().x, stepper.iterations() };
+			}
+
+			stepper.step();
+			sink.record(stepper.current());
+		}
+		return { SolveStatus::Completed, stepper.current().x, stepper.iterations() };
+	}
+}
+
+template <typename T>
+void JacobiSolver::validate(const BasicLinearSystem<T>& system, const BasicVector<T>& x0)
+{
+	const std::size_t n = system.size();
+	if (system.matrix().rowCount() != n || system.matrix().colCount() != n || system.rhs().size() != n)
+	{
+		throw DimensionMismatchException("JacobiSolver::iterate: dimension mismatch");
+	}
+	if (x0.size() != n)
+	{
+		throw DimensionMismatchException("JacobiSolver::iterate: x0 dimension mismatch");
+	}
+}
+
+template <typename T>
+BasicVector<T> JacobiSolver::iterate(const BasicLinearSystem<T>& system, const BasicVector<T>& x0, std::size_t iterations)
+{
+	BasicVector<T> x(x0.size());
+	iterateInArena<T>(system, x0, iterations, x);
+	return x;
+}
+
+template <typename T, typename Source>
+std::vector<T> JacobiSolver::iterateAs(const BasicLinearSystem<Source>& system, const BasicVector<Source>& x0, std::size_t iterations)
+{
+	std::vector<T> x(x0.size());
+	iterateInArena<T>(system, x0, iterations, x);
+	return x;
+}
+
+template <typename T, typename Source, typename Out>
+std::size_t JacobiSolver::iterateInArena(const BasicLinearSystem<Source>& system, const BasicVector<Source>& x0, std::size_t iterations, Out& out, const StopCondition& stop)
+{
+	validate(system, x0);
+
+	// Both iterates are scratch from the thread's arena; only the last one
+	// is copied out.
+	ArenaScope scope;
+	ArenaBuffer<T> x(x0.size());
+	for (std::size_t i = 0; i < x0.size(); i++)
+	{
+		x[i] = T(x0[i]);
+	}
+
+	ArenaBuffer<T> next(x0.size());
+	std::size_t done = 0;
+	while (done < iterations && stop.check() == SolveStatus::Completed)
+	{
+		sweep<T>(system.matrix(), system.rhs(), x, next);
+		std::swap(x, next);
+		done++;
+	}
+	for (std::size_t i = 0; i < x.size(); i++)
+	{
+		out[i] = x[i];
+	}
+	return done;
+}
+
+template <typename T, typename Source, typename Iterate>
+void JacobiSolver::sweep(const BasicMatrix<Source>& A, const BasicVector<Source>& b, const Iterate& xPrev, Iterate& next)
+{
+	const std::size_t n = b.size();
+
+	constexpr double diagEps = 1e-15;
+	for (std::size_t i = 0; i < n; i++)
+	{
+		const Source aii = A(i, i);
+		if (scalarAbs(aii) < diagEps)
+		{
+			throw SingularMatrixException("JacobiSolver::iterate: zero diagonal entry");
+		}
+
+		T sum = T(0.0);
+		for (std::size_t j = 0; j < n; j++)
+		{
+			if (j == i)
+			{
+				continue;
+			}
+			sum += T(A(i, j)) * xPrev[j];
+		}
+
+		next[i] = (T(b[i]) - sum) / T(aii);
+	}
+}
+
+// Instantiated once in Jacobi.cpp.
+extern template BasicVector<float> JacobiSolver::iterate<float>(const BasicLinearSystem<float>&, const BasicVector<float>&, std::size_t);
+extern template BasicVector<long double> JacobiSolver::iterate<long double>(const BasicLinearSystem<long double>&, const BasicVector<long double>&, std::size_t);
+extern template BasicVector<std::complex<double>> JacobiSolver::iterate<std::complex<double>>(const BasicLinearSystem<std::complex<double>>&, const BasicVector<std::complex<double>>&, std::size_t);
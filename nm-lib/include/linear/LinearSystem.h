@@ -2,16 +2,53 @@
 
 #include "core/Matrix.h"
 
-class LinearSystem {
+#include <complex>
+
+template <typename T>
+class BasicLinearSystem {
 private:
-	Matrix A;
-	Vector b;
+	BasicMatrix<T> A;
+	BasicVector<T> b;
 
 public:
-	LinearSystem(const Matrix& A, const Vector& b);
+	using Scalar = T;
+
+	BasicLinearSystem(const BasicMatrix<T>& A, const BasicVector<T>& b);
 
 	std::size_t size() const;
 
-	const Matrix& matrix() const;
-	const Vector& rhs() const;
+	const BasicMatrix<T>& matrix() const;
+	const BasicVector<T>& rhs() const;
 };
+
+using LinearSystem = BasicLinearSystem<double>;
+
+template <typename T>
+BasicLinearSystem<T>::BasicLinearSystem(const BasicMatrix<T>& A, const BasicVector<T>& b)
+	: A(A), b(b)
+{
+}
+
+template <typename T>
+std::size_t BasicLinearSystem<T>::size() const
+{
+	return b.size();
+}
+
+template <typename T>
+const BasicMatrix<T>& BasicLinearSystem<T>::matrix() const
+{
+	return A;
+}
+
+template <typename T>
+const BasicVector<T>& BasicLinearSystem<T>::rhs() const
+{
+	return b;
+}
+
+// Instantiated once in LinearSystem.cpp.
+extern template class BasicLinearSystem<double>;
+extern template class BasicLinearSystem<float>;
+extern template class BasicLinearSystem<long double>;
+extern template class BasicLinearSystem<std::complex<double>>;
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "linear/LinearSystem.h"
+
+#include "utils/ThreadPool.h"
+
+#include <string>
+#include <vector>
+
+struct PrecisionSweepRow
+{
+	int significantDigits;
+	// False when elimination at this precision failed (e.g. a pivot rounded
+	// to zero); `error` says why and the numbers below are NaN.
+	bool solved;
+	std::string error;
+	Vector x = Vector(0);
+	// ||x - x*||inf / ||x*||inf, x* from the same elimination in long double.
+	double relativeError;
+	// ||b - A x||inf, accumulated in long double.
+	double residual;
+	// See GaussianEliminationStats.
+	double growthFactor;
+	double seconds;
+};
+
+// Round-off study: GaussianElimination::solve(system, t) for every t in
+// [minDigits, maxDigits], the precisions run concurrently on the pool. All
+// of them read the one system passed in; each solve only allocates its own
+// working copy.
+class PrecisionSweep {
+public:
+	PrecisionSweep() = delete;
+
+	// Rows are ordered by t. Throws std::invalid_argument for an empty or
+	// non-positive range and SingularMatrixException when the system is
+	// singular even for the long double reference.
+	static std::vector<PrecisionSweepRow> run(const LinearSystem& system, int minDigits, int maxDigits, ThreadPool& pool);
+};
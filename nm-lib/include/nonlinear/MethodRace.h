@@ -0,0 +1,67 @@
+#pragma once
+
+#include "nonlinear/ScalarEquation.h"
+
+#include "utils/ThreadPool.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+enum class RaceMode
+{
+	// Every method runs to completion.
+	RunAll,
+	// The first method that returns a root wins; the others are cancelled.
+	FirstToConverge
+};
+
+enum class RaceStatus
+{
+	Converged,
+	Failed,
+	Cancelled
+};
+
+struct RaceResult
+{
+	std::string name;
+	RaceStatus status;
+	double x;
+	std::string error;
+	double seconds;
+	// True for the first method that converged (FirstToConverge only).
+	bool winner;
+};
+
+// Runs several root-finding methods on the same equation concurrently.
+class MethodRace {
+public:
+	// A method gets the (cancellable) equation and returns the root it found.
+	using Method = std::function<double(const ScalarEquation& eq)>;
+
+	// Called on the worker thread as soon as a method finishes. Calls for
+	// different methods may overlap, so the callback must only touch state
+	// owned by its own index.
+	using OnFinished = std::function<void(std::size_t index, const RaceResult& result)>;
+
+private:
+	struct Entry
+	{
+		std::string name;
+		Method method;
+	};
+
+	std::vector<Entry> entries;
+
+public:
+	void add(std::string name, Method method);
+
+	std::size_t size() const;
+
+	// Results are returned in the order the methods were added.
+	std::vector<RaceResult> run(const ScalarEquation& eq, RaceMode mode, ThreadPool& pool, const OnFinished& onFinished = nullptr) const;
+
+	static const char* statusName(RaceStatus status);
+};
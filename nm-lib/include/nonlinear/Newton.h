@@ -1,8 +1,18 @@
 #pragma once
 
+#include "core/Arena.h"
+
 #include "nonlinear/NonlinearSystem.h"
 
+#include "utils/Cancellation.h"
+#include "utils/Exceptions.h"
+#include "utils/TraceSink.h"
+
+#include <cmath>
+#include <complex>
 #include <cstddef>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 struct NewtonSystemTraceStep
@@ -14,13 +24,325 @@ struct NewtonSystemTraceStep
 	Vector delta;
 };
 
-struct NewtonSystemTrace
+struct NewtonSystemTrace : StepTrace<NewtonSystemTraceStep>
 {
-	std::vector<NewtonSystemTraceStep> steps;
 };
 
 class NewtonSolver {
+private:
+	friend class NewtonSystemStepper;
+
+	template <typename T>
+	static bool isFiniteVector(const BasicVector<T>& v);
+
+	// J(x) * delta = -F(x), with the elimination's copies of J and -F taken
+	// from the thread's arena.
+	static Vector solveNewtonStep(const Matrix& jac, const Vector& fx);
+
+	// A * x = b by partial pivoting in T, A row-major (n x n); A and b are
+	// overwritten.
+	template <typename T>
+	static void solveLinearSystemGaussianPivot(T* A, T* b, T* x, std::size_t n);
+
 public:
 	NewtonSolver() = delete;
+
+	// Records into `trace` when given; the untraced run is the NoTrace kernel.
 	static Vector solve(const NonlinearSystem &system, Vector x0, double eps, NewtonSystemTrace* trace = nullptr);
+
+	// Kernel templated on a trace sink (utils/TraceSink.h).
+	template <typename Sink>
+	static Vector solve(const NonlinearSystem& system, Vector x0, double eps, Sink& sink);
+
+	// Checks `stop` (utils/Cancellation.h) before every iteration; when
+	// stopped early the latest iterate is returned.
+	template <typename Sink>
+	static SolveOutcome<Vector> solve(const NonlinearSystem& system, Vector x0, double eps, Sink& sink, const StopCondition& stop);
+
+	// Newton iterations in the system's own scalar type (float, long double,
+	// std::complex<double> for analytic F, ...), untraced; eps bounds |F(x)|
+	// and the relative step as in solve().
+	template <typename T>
+	static BasicVector<T> solve(const BasicNonlinearSystem<T>& system, const BasicVector<T>& x0, double eps);
+
+	// Newton iterations with the iterate, the linear solve and the update in
+	// the arithmetic of T (e.g. Decimal<t>, core/Decimal.h). F and J are
+	// evaluated in the system's scalar type at the iterate; the stop criteria
+	// are solve()'s.
+	template <typename T, typename Source>
+	static std::vector<T> solveAs(const BasicNonlinearSystem<Source>& system, const BasicVector<Source>& x0, double eps);
+};
+
+// Resumable Newton iterations for F(x) = 0. The constructor validates the
+// input like NewtonSolver::solve. step() performs one update and returns
+// true, with current() referring to that iteration's record (x before the
+// update, F(x), J(x), delta); it returns false once a stop criterion holds.
+// root() is the latest iterate, also while running. A non-finite iterate is
+// reported by the next step(). The system must outlive the stepper.
+class NewtonSystemStepper {
+private:
+	const NonlinearSystem& system;
+	double eps;
+	Vector x;
+	std::size_t iter = 0;
+	bool finished = false;
+	bool failed = false;
+	NewtonSystemTraceStep state;
+
+public:
+	static constexpr std::size_t maxIterations = 100;
+
+	NewtonSystemStepper(const NonlinearSystem& system, Vector x0, double eps);
+
+	bool step();
+
+	bool done() const;
+	std::size_t iterations() const;
+	const NewtonSystemTraceStep& current() const;
+	const Vector& root() const;
+
+	// Moves the current record out (e.g. into a trace); current() is then
+	// unspecified until the next step().
+	NewtonSystemTraceStep releaseCurrent();
 };
+
+template <typename Sink>
+Vector NewtonSolver::solve(const NonlinearSystem& system, Vector x0, double eps, Sink& sink)
+{
+	NewtonSystemStepper stepper(system, std::move(x0), eps);
+	while (stepper.step())
+	{
+		if constexpr (Sink::enabled)
+		{
+			// F(x) and J(x) are recomputed by the next step.
+			sink.record(stepper.releaseCurrent());
+		}
+	}
+	return stepper.root();
+}
+
+template <typename Sink>
+SolveOutcome<Vector> NewtonSolver::solve(const NonlinearSystem& system, Vector x0, double eps, Sink& sink, const StopCondition& stop)
+{
+	NewtonSystemStepper stepper(system, std::move(x0), eps);
+	for (;;)
+	{
+		const SolveStatus status = stop.check();
+		if (status != SolveStatus::Completed)
+		{
+			return { status, stepper.root(), stepper.iterations() };
+		}
+		if (!stepper.step())
+		{
+			return { SolveStatus::Completed, stepper.root(), stepper.iterations() };
+		}
+		if constexpr (Sink::enabled)
+		{
+			sink.record(stepper.releaseCurrent());
+		}
+	}
+}
+
+template <typename T>
+bool NewtonSolver::isFiniteVector(const BasicVector<T>& v)
+{
+	for (std::size_t i = 0; i < v.size(); i++)
+	{
+		if (!scalarIsFinite(v[i]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+template <typename T>
+void NewtonSolver::solveLinearSystemGaussianPivot(T* A, T* b, T* x, std::size_t n)
+{
+	using Magnitude = ScalarMagnitude<T>;
+
+	const Magnitude pivotEps = Magnitude(1e-15);
+
+	for (std::size_t k = 0; k < n; k++)
+	{
+		std::size_t pivotRow = k;
+		Magnitude maxAbs = scalarAbs(A[k * n + k]);
+		for (std::size_t i = k + 1; i < n; i++)
+		{
+			const Magnitude candidate = scalarAbs(A[i * n + k]);
+			if (candidate > maxAbs)
+			{
+				maxAbs = candidate;
+				pivotRow = i;
+			}
+		}
+
+		if (maxAbs < pivotEps)
+		{
+			throw SingularMatrixException("NewtonSolver: singular Jacobian (zero pivot)");
+		}
+
+		if (pivotRow != k)
+		{
+			for (std::size_t j = 0; j < n; j++)
+			{
+				std::swap(A[k * n + j], A[pivotRow * n + j]);
+			}
+			std::swap(b[k], b[pivotRow]);
+		}
+
+		const T pivot = A[k * n + k];
+		if (scalarAbs(pivot) < pivotEps)
+		{
+			throw SingularMatrixException("NewtonSolver: singular Jacobian (pivot too small)");
+		}
+
+		for (std::size_t i = k + 1; i < n; i++)
+		{
+			const T m = A[i * n + k] / pivot;
+			A[i * n + k] = T(0.0);
+			for (std::size_t j = k + 1; j < n; j++)
+			{
+				A[i * n + j] -= m * A[k * n + j];
+			}
+			b[i] -= m * b[k];
+		}
+	}
+
+	for (std::size_t ii = 0; ii < n; ii++)
+	{
+		const std::size_t i = n - 1 - ii;
+		T sum = T(0.0);
+		for (std::size_t j = i + 1; j < n; j++)
+		{
+			sum += A[i * n + j] * x[j];
+		}
+
+		const T diag = A[i * n + i];
+		if (scalarAbs(diag) < pivotEps)
+		{
+			throw SingularMatrixException("NewtonSolver: singular Jacobian during back substitution");
+		}
+
+		x[i] = (b[i] - sum) / diag;
+	}
+}
+
+template <typename T>
+BasicVector<T> NewtonSolver::solve(const BasicNonlinearSystem<T>& system, const BasicVector<T>& x0, double eps)
+{
+	const std::vector<T> values = solveAs<T>(system, x0, eps);
+	BasicVector<T> x(values.size());
+	for (std::size_t i = 0; i < values.size(); i++)
+	{
+		x[i] = values[i];
+	}
+	return x;
+}
+
+template <typename T, typename Source>
+std::vector<T> NewtonSolver::solveAs(const BasicNonlinearSystem<Source>& system, const BasicVector<Source>& x0, double eps)
+{
+	using Magnitude = ScalarMagnitude<T>;
+
+	if (eps <= 0.0)
+	{
+		throw std::invalid_argument("NewtonSolver::solve: eps must be positive");
+	}
+	if (x0.size() == 0)
+	{
+		throw std::invalid_argument("NewtonSolver::solve: x0 must be non-empty");
+	}
+	if (!isFiniteVector(x0))
+	{
+		throw std::invalid_argument("NewtonSolver::solve: x0 contains non-finite values");
+	}
+
+	const std::size_t n = x0.size();
+	std::vector<T> x(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		x[i] = T(x0[i]);
+	}
+
+	BasicVector<Source> at(n);
+	for (std::size_t iter = 0;; iter++)
+	{
+		if (iter == NewtonSystemStepper::maxIterations)
+		{
+			throw NonConvergenceException("NewtonSolver::solve: maximum iterations reached");
+		}
+
+		for (std::size_t i = 0; i < n; i++)
+		{
+			at[i] = static_cast<Source>(x[i]);
+		}
+
+		const BasicVector<Source> fx = system.evaluate(at);
+		if (fx.size() != n)
+		{
+			throw DimensionMismatchException("NewtonSolver::solve: F(x) dimension mismatch");
+		}
+		if (!isFiniteVector(fx))
+		{
+			throw NonConvergenceException("NewtonSolver::solve: F(x) became non-finite");
+		}
+		if (fx.normInf() <= eps)
+		{
+			return x;
+		}
+
+		const BasicMatrix<Source> jac = system.jacobian(at);
+		if (jac.rowCount() != n || jac.colCount() != n)
+		{
+			throw DimensionMismatchException("NewtonSolver::solve: J(x) dimension mismatch");
+		}
+
+		// This iteration's scratch, released at the end of the loop body.
+		ArenaScope scope;
+		ArenaBuffer<T> J(n * n);
+		ArenaBuffer<T> rhs(n);
+		ArenaBuffer<T> delta(n);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			for (std::size_t j = 0; j < n; j++)
+			{
+				J[i * n + j] = T(jac(i, j));
+			}
+			rhs[i] = T(-fx[i]);
+		}
+
+		solveLinearSystemGaussianPivot<T>(J.data(), rhs.data(), delta.data(), n);
+
+		Magnitude deltaNorm = Magnitude(0.0);
+		Magnitude xNorm = Magnitude(0.0);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			if (!scalarIsFinite(delta[i]))
+			{
+				throw NonConvergenceException("NewtonSolver::solve: update became non-finite");
+			}
+			x[i] += delta[i];
+			if (!scalarIsFinite(x[i]))
+			{
+				throw NonConvergenceException("NewtonSolver::solve: iterate became non-finite");
+			}
+			const Magnitude deltaAbs = scalarAbs(delta[i]);
+			const Magnitude xAbs = scalarAbs(x[i]);
+			deltaNorm = deltaAbs > deltaNorm ? deltaAbs : deltaNorm;
+			xNorm = xAbs > xNorm ? xAbs : xNorm;
+		}
+
+		// Course-style stop: small step (absolute or relative).
+		const Magnitude denom = xNorm > Magnitude(1.0) ? xNorm : Magnitude(1.0);
+		if (deltaNorm / denom <= Magnitude(eps))
+		{
+			return x;
+		}
+	}
+}
+
+// Instantiated once in Newton.cpp.
+extern template BasicVector<float> NewtonSolver::solve<float>(const BasicNonlinearSystem<float>&, const BasicVector<float>&, double);
+extern template BasicVector<long double> NewtonSolver::solve<long double>(const BasicNonlinearSystem<long double>&, const BasicVector<long double>&, double);
+extern template BasicVector<std::complex<double>> NewtonSolver::solve<std::complex<double>>(const BasicNonlinearSystem<std::complex<double>>&, const BasicVector<std::complex<double>>&, double);
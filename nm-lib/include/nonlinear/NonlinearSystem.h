@@ -1,19 +1,57 @@
 #pragma once
 
 #include "core/Matrix.h"
+
+#include <complex>
 #include <functional>
+#include <utility>
+
+template <typename T>
+using BasicVectorFunction = std::function<BasicVector<T>(const BasicVector<T> &)>;
+
+template <typename T>
+using BasicJacobianFunction = std::function<BasicMatrix<T>(const BasicVector<T> &)>;
 
-using VectorFunction = std::function<Vector(const Vector &)>;
-using JacobianFunction = std::function<Matrix(const Vector &)>;
+using VectorFunction = BasicVectorFunction<double>;
+using JacobianFunction = BasicJacobianFunction<double>;
 
-class NonlinearSystem {
+template <typename T>
+class BasicNonlinearSystem {
 private:
-	VectorFunction F;
-	JacobianFunction J;
+	BasicVectorFunction<T> F;
+	BasicJacobianFunction<T> J;
 
 public:
-	NonlinearSystem(VectorFunction F, JacobianFunction J);
+	using Scalar = T;
 
-	Vector evaluate(const Vector &x) const;
-	Matrix jacobian(const Vector &x) const;
+	BasicNonlinearSystem(BasicVectorFunction<T> F, BasicJacobianFunction<T> J);
+
+	BasicVector<T> evaluate(const BasicVector<T> &x) const;
+	BasicMatrix<T> jacobian(const BasicVector<T> &x) const;
 };
+
+using NonlinearSystem = BasicNonlinearSystem<double>;
+
+template <typename T>
+BasicNonlinearSystem<T>::BasicNonlinearSystem(BasicVectorFunction<T> F, BasicJacobianFunction<T> J)
+	: F(std::move(F)), J(std::move(J))
+{
+}
+
+template <typename T>
+BasicVector<T> BasicNonlinearSystem<T>::evaluate(const BasicVector<T>& x) const
+{
+	return F(x);
+}
+
+template <typename T>
+BasicMatrix<T> BasicNonlinearSystem<T>::jacobian(const BasicVector<T>& x) const
+{
+	return J(x);
+}
+
+// Instantiated once in NonlinearSystem.cpp.
+extern template class BasicNonlinearSystem<double>;
+extern template class BasicNonlinearSystem<float>;
+extern template class BasicNonlinearSystem<long double>;
+extern template class BasicNonlinearSystem<std::complex<double>>;
@@ -2,8 +2,15 @@
 
 #include "nonlinear/ScalarEquation.h"
 
+#include "utils/Cancellation.h"
+#include "utils/Exceptions.h"
+#include "utils/TraceSink.h"
+
+#include <cmath>
 #include <cstddef>
-#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <utility>
 
 struct BisectionTraceStep
 {
@@ -15,9 +22,8 @@ struct BisectionTraceStep
 	double errorBound;
 };
 
-struct BisectionTrace
+struct BisectionTrace : StepTrace<BisectionTraceStep>
 {
-	std::vector<BisectionTraceStep> steps;
 };
 
 struct RegulaFalsiTraceStep
@@ -29,9 +35,8 @@ struct RegulaFalsiTraceStep
 	double fp;
 };
 
-struct RegulaFalsiTrace
+struct RegulaFalsiTrace : StepTrace<RegulaFalsiTraceStep>
 {
-	std::vector<RegulaFalsiTraceStep> steps;
 };
 
 struct SecantTraceStep
@@ -43,9 +48,8 @@ struct SecantTraceStep
 	double fp;
 };
 
-struct SecantTrace
+struct SecantTrace : StepTrace<SecantTraceStep>
 {
-	std::vector<SecantTraceStep> steps;
 };
 
 struct NewtonTraceStep
@@ -58,15 +62,92 @@ struct NewtonTraceStep
 	double fxNext;
 };
 
-struct NewtonTrace
+struct NewtonTrace : StepTrace<NewtonTraceStep>
 {
-	std::vector<NewtonTraceStep> steps;
 };
 
+// Residual plotted by the convergence curve (see utils/TraceDecimation.h).
+inline double convergenceValue(const BisectionTraceStep& s)
+{
+	return s.fp;
+}
+
+inline double convergenceValue(const RegulaFalsiTraceStep& s)
+{
+	return s.fp;
+}
+
+inline double convergenceValue(const SecantTraceStep& s)
+{
+	return s.fp;
+}
+
+inline double convergenceValue(const NewtonTraceStep& s)
+{
+	return s.fxNext;
+}
+
+template <typename T>
+class BasicBisectionStepper;
+template <typename T>
+class BasicRegulaFalsiStepper;
+template <typename T>
+class BasicSecantStepper;
+template <typename T>
+class BasicNewtonStepper;
+
+// The methods are templates on the scalar type T of the equation
+// (BasicScalarEquation<T>): double, or e.g. Decimal<t> (core/Decimal.h) to
+// run them in t-digit arithmetic. Step records are stored as doubles.
 class RootFinding {
+private:
+	template <typename T>
+	friend class BasicBisectionStepper;
+	template <typename T>
+	friend class BasicRegulaFalsiStepper;
+	template <typename T>
+	friend class BasicSecantStepper;
+	template <typename T>
+	friend class BasicNewtonStepper;
+
+	// Scalar parameters take the equation's type without taking part in
+	// deduction, so double literals work for any T.
+	template <typename T>
+	using Scalar = typename BasicScalarEquation<T>::Scalar;
+
+	template <typename T>
+	static void validateEps(T eps);
+
+	template <typename T>
+	static void validateBracket(const BasicScalarEquation<T>& eq, T a, T b);
+
+	template <typename T>
+	static int signum(T x)
+	{
+		if (x > 0.0)
+		{
+			return 1;
+		}
+		if (x < 0.0)
+		{
+			return -1;
+		}
+		return 0;
+	}
+
+	// Drives a stepper to completion, recording every iteration into `sink`.
+	template <typename Stepper, typename Sink>
+	static auto run(Stepper& stepper, Sink& sink);
+
+	// Same, checking `stop` before every iteration.
+	template <typename Stepper, typename Sink>
+	static auto runUntil(Stepper& stepper, Sink& sink, const StopCondition& stop);
+
 public:
 	RootFinding() = delete;
-    
+
+	// Pointer overloads: record into `trace` when given, otherwise run the
+	// untraced (NoTrace) kernel.
 	static double bisection(const ScalarEquation& eq, double a, double b, double eps, BisectionTrace* trace = nullptr);
 
 	static double regulaFalsi(const ScalarEquation& eq, double a, double b, double eps, RegulaFalsiTrace* trace = nullptr);
@@ -74,4 +155,804 @@ public:
 	static double secant(const ScalarEquation& eq, double x0, double x1, double eps, SecantTrace* trace = nullptr);
 
 	static double newton(const ScalarEquation& eq, Function1D derivative, double x0, double eps, NewtonTrace* trace = nullptr);
+
+	// Kernels templated on a trace sink (utils/TraceSink.h).
+	template <typename T, typename Sink>
+	static T bisection(const BasicScalarEquation<T>& eq, Scalar<T> a, Scalar<T> b, Scalar<T> eps, Sink& sink);
+
+	template <typename T, typename Sink>
+	static T regulaFalsi(const BasicScalarEquation<T>& eq, Scalar<T> a, Scalar<T> b, Scalar<T> eps, Sink& sink);
+
+	template <typename T, typename Sink>
+	static T secant(const BasicScalarEquation<T>& eq, Scalar<T> x0, Scalar<T> x1, Scalar<T> eps, Sink& sink);
+
+	template <typename T, typename Sink>
+	static T newton(const BasicScalarEquation<T>& eq, BasicFunction1D<T> derivative, Scalar<T> x0, Scalar<T> eps, Sink& sink);
+
+	// Kernels that check `stop` (utils/Cancellation.h) before every iteration.
+	// They return the root with status Completed, or the latest iterate with
+	// status Cancelled / DeadlineExceeded. Solver errors still throw.
+	template <typename T, typename Sink>
+	static SolveOutcome<T> bisection(const BasicScalarEquation<T>& eq, Scalar<T> a, Scalar<T> b, Scalar<T> eps, Sink& sink, const StopCondition& stop);
+
+	template <typename T, typename Sink>
+	static SolveOutcome<T> regulaFalsi(const BasicScalarEquation<T>& eq, Scalar<T> a, Scalar<T> b, Scalar<T> eps, Sink& sink, const StopCondition& stop);
+
+	template <typename T, typename Sink>
+	static SolveOutcome<T> secant(const BasicScalarEquation<T>& eq, Scalar<T> x0, Scalar<T> x1, Scalar<T> eps, Sink& sink, const StopCondition& stop);
+
+	template <typename T, typename Sink>
+	static SolveOutcome<T> newton(const BasicScalarEquation<T>& eq, BasicFunction1D<T> derivative, Scalar<T> x0, Scalar<T> eps, Sink& sink, const StopCondition& stop);
+};
+
+// Resumable steppers: one object per solve, advanced one iteration at a time.
+// The constructor validates the input (same exceptions as the RootFinding
+// functions) and may already finish when an endpoint / start point is a root.
+// step() computes one iteration and returns true; current() then refers to
+// that iteration's step record (no copy). Once a stop criterion has been met
+// step() returns false and root() holds the result. Errors found after an
+// iteration was produced (e.g. non-finite f(p)) are thrown by the next step(),
+// so the offending iteration can still be observed. estimate() is the best
+// answer so far: root() once done, otherwise the latest iterate (the start
+// point before the first step). The equation (and derivative) must outlive
+// the stepper. BisectionStepper etc. are the double steppers.
+
+template <typename T>
+class BasicBisectionStepper {
+private:
+	const BasicScalarEquation<T>& eq;
+	T eps;
+	T a;
+	T b;
+	T fa;
+	T fb;
+	std::size_t iter = 0;
+	bool finished = false;
+	T x = 0.0;
+	T latest = 0.0; // p of the latest step (state keeps it as a double)
+	BisectionTraceStep state{};
+
+public:
+	static constexpr std::size_t maxIterations = 1000;
+
+	BasicBisectionStepper(const BasicScalarEquation<T>& eq, T a, T b, T eps);
+
+	bool step();
+
+	bool done() const;
+	std::size_t iterations() const;
+	const BisectionTraceStep& current() const;
+	T root() const;
+	T estimate() const;
+};
+
+template <typename T>
+class BasicRegulaFalsiStepper {
+private:
+	const BasicScalarEquation<T>& eq;
+	T eps;
+	T a;
+	T b;
+	T fa;
+	T fb;
+	T prevP;
+	std::size_t iter = 0;
+	bool finished = false;
+	T x = 0.0;
+	T latest = 0.0; // p of the latest step (state keeps it as a double)
+	RegulaFalsiTraceStep state{};
+
+public:
+	static constexpr std::size_t maxIterations = 100000;
+
+	BasicRegulaFalsiStepper(const BasicScalarEquation<T>& eq, T a, T b, T eps);
+
+	bool step();
+
+	bool done() const;
+	std::size_t iterations() const;
+	const RegulaFalsiTraceStep& current() const;
+	T root() const;
+	T estimate() const;
+};
+
+template <typename T>
+class BasicSecantStepper {
+private:
+	const BasicScalarEquation<T>& eq;
+	T eps;
+	T x0;
+	T x1;
+	T f0;
+	T f1;
+	std::size_t iter = 0;
+	bool finished = false;
+	bool failed = false;
+	T x = 0.0;
+	T latest = 0.0; // p of the latest step (state keeps it as a double)
+	SecantTraceStep state{};
+
+public:
+	static constexpr std::size_t maxIterations = 100000;
+
+	BasicSecantStepper(const BasicScalarEquation<T>& eq, T x0, T x1, T eps);
+
+	bool step();
+
+	bool done() const;
+	std::size_t iterations() const;
+	const SecantTraceStep& current() const;
+	T root() const;
+	T estimate() const;
+};
+
+template <typename T>
+class BasicNewtonStepper {
+private:
+	const BasicScalarEquation<T>& eq;
+	BasicFunction1D<T> derivative;
+	T eps;
+	T x0;
+	T f0;
+	std::size_t iter = 0;
+	bool finished = false;
+	bool failed = false;
+	T x = 0.0;
+	T latest = 0.0; // p of the latest step (state keeps it as a double)
+	NewtonTraceStep state{};
+
+public:
+	static constexpr std::size_t maxIterations = 1000;
+
+	BasicNewtonStepper(const BasicScalarEquation<T>& eq, BasicFunction1D<T> derivative, T x0, T eps);
+
+	bool step();
+
+	bool done() const;
+	std::size_t iterations() const;
+	const NewtonTraceStep& current() const;
+	T root() const;
+	T estimate() const;
 };
+
+using BisectionStepper = BasicBisectionStepper<double>;
+using RegulaFalsiStepper = BasicRegulaFalsiStepper<double>;
+using SecantStepper = BasicSecantStepper<double>;
+using NewtonStepper = BasicNewtonStepper<double>;
+
+template <typename T>
+void RootFinding::validateEps(T eps)
+{
+	if (!(eps > 0.0))
+	{
+		throw std::invalid_argument("eps must be > 0");
+	}
+}
+
+template <typename T>
+void RootFinding::validateBracket(const BasicScalarEquation<T>& eq, T a, T b)
+{
+	using std::isinf;
+	using std::isnan;
+
+	if (!(a < b))
+	{
+		throw std::invalid_argument("invalid interval: require a < b");
+	}
+
+	const T fa = eq(a);
+	const T fb = eq(b);
+
+	if (isnan(fa) || isnan(fb) || isinf(fa) || isinf(fb))
+	{
+		throw std::invalid_argument("f(a) or f(b) is not finite");
+	}
+
+	const int sa = signum(fa);
+	const int sb = signum(fb);
+	if (sa == sb)
+	{
+		throw std::invalid_argument("interval does not bracket a root (same sign at endpoints)");
+	}
+}
+
+template <typename Stepper, typename Sink>
+auto RootFinding::run(Stepper& stepper, Sink& sink)
+{
+	while (stepper.step())
+	{
+		if constexpr (Sink::enabled) {
+			sink.record(stepper.current());
+		}
+	}
+	return stepper.root();
+}
+
+template <typename Stepper, typename Sink>
+auto RootFinding::runUntil(Stepper& stepper, Sink& sink, const StopCondition& stop)
+{
+	using Outcome = SolveOutcome<decltype(stepper.root())>;
+	for (;;)
+	{
+		const SolveStatus status = stop.check();
+		if (status != SolveStatus::Completed)
+		{
+			return Outcome{ status, stepper.estimate(), stepper.iterations() };
+		}
+		if (!stepper.step())
+		{
+			return Outcome{ SolveStatus::Completed, stepper.root(), stepper.iterations() };
+		}
+		if constexpr (Sink::enabled) {
+			sink.record(stepper.current());
+		}
+	}
+}
+
+template <typename T, typename Sink>
+T RootFinding::bisection(const BasicScalarEquation<T>& eq, Scalar<T> a, Scalar<T> b, Scalar<T> eps, Sink& sink)
+{
+	BasicBisectionStepper<T> stepper(eq, a, b, eps);
+	return run(stepper, sink);
+}
+
+template <typename T, typename Sink>
+T RootFinding::regulaFalsi(const BasicScalarEquation<T>& eq, Scalar<T> a, Scalar<T> b, Scalar<T> eps, Sink& sink)
+{
+	BasicRegulaFalsiStepper<T> stepper(eq, a, b, eps);
+	return run(stepper, sink);
+}
+
+template <typename T, typename Sink>
+T RootFinding::secant(const BasicScalarEquation<T>& eq, Scalar<T> x0, Scalar<T> x1, Scalar<T> eps, Sink& sink)
+{
+	BasicSecantStepper<T> stepper(eq, x0, x1, eps);
+	return run(stepper, sink);
+}
+
+template <typename T, typename Sink>
+T RootFinding::newton(const BasicScalarEquation<T>& eq, BasicFunction1D<T> derivative, Scalar<T> x0, Scalar<T> eps, Sink& sink)
+{
+	BasicNewtonStepper<T> stepper(eq, std::move(derivative), x0, eps);
+	return run(stepper, sink);
+}
+
+template <typename T, typename Sink>
+SolveOutcome<T> RootFinding::bisection(const BasicScalarEquation<T>& eq, Scalar<T> a, Scalar<T> b, Scalar<T> eps, Sink& sink, const StopCondition& stop)
+{
+	BasicBisectionStepper<T> stepper(eq, a, b, eps);
+	return runUntil(stepper, sink, stop);
+}
+
+template <typename T, typename Sink>
+SolveOutcome<T> RootFinding::regulaFalsi(const BasicScalarEquation<T>& eq, Scalar<T> a, Scalar<T> b, Scalar<T> eps, Sink& sink, const StopCondition& stop)
+{
+	BasicRegulaFalsiStepper<T> stepper(eq, a, b, eps);
+	return runUntil(stepper, sink, stop);
+}
+
+template <typename T, typename Sink>
+SolveOutcome<T> RootFinding::secant(const BasicScalarEquation<T>& eq, Scalar<T> x0, Scalar<T> x1, Scalar<T> eps, Sink& sink, const StopCondition& stop)
+{
+	BasicSecantStepper<T> stepper(eq, x0, x1, eps);
+	return runUntil(stepper, sink, stop);
+}
+
+template <typename T, typename Sink>
+SolveOutcome<T> RootFinding::newton(const BasicScalarEquation<T>& eq, BasicFunction1D<T> derivative, Scalar<T> x0, Scalar<T> eps, Sink& sink, const StopCondition& stop)
+{
+	BasicNewtonStepper<T> stepper(eq, std::move(derivative), x0, eps);
+	return runUntil(stepper, sink, stop);
+}
+
+// Bisection
+
+template <typename T>
+BasicBisectionStepper<T>::BasicBisectionStepper(const BasicScalarEquation<T>& eq, T a, T b, T eps)
+	: eq(eq), eps(eps), a(a), b(b), fa(0.0), fb(0.0)
+{
+	using std::abs;
+
+	RootFinding::validateEps(eps);
+	RootFinding::validateBracket(eq, a, b);
+
+	fa = eq(a);
+	fb = eq(b);
+
+	if (abs(fa) < eps)
+	{
+		finished = true;
+		x = a;
+	}
+	else if (abs(fb) < eps)
+	{
+		finished = true;
+		x = b;
+	}
+}
+
+template <typename T>
+bool BasicBisectionStepper<T>::step()
+{
+	using std::abs;
+
+	if (finished)
+	{
+		return false;
+	}
+	if (iter == maxIterations)
+	{
+		// reached max iterations and no solution was found
+		throw NonConvergenceException("bisection did not converge within iteration limit");
+	}
+
+	// pick midpoint and avoid ovrflow from a+b
+	const T p = a + (b - a) / 2.0;
+	// evaluate function in midpoint
+	const T fp = eq(p);
+
+	// the iteration, endpoints, midpoint, function value at midpoint
+	// and the maximum error at this step
+	state = BisectionTraceStep{ iter, static_cast<double>(a), static_cast<double>(b), static_cast<double>(p),
+		static_cast<double>(fp), static_cast<double>(abs(b - a) / 2.0) };
+	latest = p;
+	iter++;
+
+	// found solution within tolerance
+	// (or the sign of the function at midpoint is exactly zero)
+	const int sp = RootFinding::signum(fp);
+	if (abs(fp) <= eps || abs(b - a) / 2.0 <= eps || sp == 0)
+	{
+		finished = true;
+		x = p;
+		return true;
+	}
+
+	// change the interval into [a, p] or [p,b] depending on signs
+	const int sa = RootFinding::signum(fa);
+	const int sb = RootFinding::signum(fb);
+	if (sa == sp)
+	{
+		a = p;
+		fa = fp;
+	}
+	if (sb == sp)
+	{
+		b = p;
+		fb = fp;
+	}
+	return true;
+}
+
+template <typename T>
+bool BasicBisectionStepper<T>::done() const
+{
+	return finished;
+}
+
+template <typename T>
+std::size_t BasicBisectionStepper<T>::iterations() const
+{
+	return iter;
+}
+
+template <typename T>
+const BisectionTraceStep& BasicBisectionStepper<T>::current() const
+{
+	return state;
+}
+
+template <typename T>
+T BasicBisectionStepper<T>::root() const
+{
+	return x;
+}
+
+template <typename T>
+T BasicBisectionStepper<T>::estimate() const
+{
+	if (finished)
+	{
+		return x;
+	}
+	return iter > 0 ? latest : a + (b - a) / 2.0;
+}
+
+// Regula falsi
+
+template <typename T>
+BasicRegulaFalsiStepper<T>::BasicRegulaFalsiStepper(const BasicScalarEquation<T>& eq, T a, T b, T eps)
+	: eq(eq), eps(eps), a(a), b(b), fa(0.0), fb(0.0), prevP(std::numeric_limits<double>::quiet_NaN())
+{
+	RootFinding::validateEps(eps);
+
+	// regula falsi (false position) is a bracketing method:
+	// - we start with an interval [a,b] such that f(a) and f(b) have opposite signs
+	// - we approximate the root by intersecting the secant through (a,f(a)) and (b,f(b)) with the x-axis
+	//   p = (a*f(b) - b*f(a)) / (f(b) - f(a))
+	// - we keep the root bracketed by replacing the endpoint that has the same sign as f(p)
+	RootFinding::validateBracket(eq, a, b);
+
+	fa = eq(a);
+	fb = eq(b);
+
+	if (fa == 0.0)
+	{
+		finished = true;
+		x = a;
+	}
+	else if (fb == 0.0)
+	{
+		finished = true;
+		x = b;
+	}
+}
+
+template <typename T>
+bool BasicRegulaFalsiStepper<T>::step()
+{
+	using std::abs;
+	using std::isfinite;
+
+	if (finished)
+	{
+		return false;
+	}
+	if (iter == maxIterations)
+	{
+		throw NonConvergenceException("regula falsi did not converge within iteration limit");
+	}
+
+	// compute the secant intersection with OX for the current bracket [a,b]
+	// (the denominator must be non-zero to define the secant slope)
+	const T denom = (fb - fa);
+	if (denom == 0.0)
+	{
+		throw std::invalid_argument("regula falsi failed: f(b) - f(a) == 0");
+	}
+
+	// regula falsi update (false position)
+	// p is where the secant line crosses y=0
+	const T p = (a * fb - b * fa) / denom;
+	// evaluate function in the candidate point
+	const T fp = eq(p);
+
+	// the iteration, endpoints and candidate
+	state = RegulaFalsiTraceStep{ iter, static_cast<double>(a), static_cast<double>(b), static_cast<double>(p),
+		static_cast<double>(fp) };
+	latest = p;
+	iter++;
+
+	// stop criteria: small residual / small change / small bracket
+	// - successive approximations stop moving (common practical criterion)
+	// - the bracket is very small (bracket-based criterion)
+	const int sp = RootFinding::signum(fp);
+	if (abs(fp) <= eps
+		|| (isfinite(prevP) && abs(p - prevP) <= eps)
+		|| abs(b - a) <= 2.0 * eps
+		|| sp == 0)
+	{
+		finished = true;
+		x = p;
+		return true;
+	}
+
+	// decide which side to keep so the root stays bracketed
+	// (keep opposite signs at endpoints)
+	const int sa = RootFinding::signum(fa);
+	if (sa == sp)
+	{
+		a = p;
+		fa = fp;
+	}
+	else
+	{
+		b = p;
+		fb = fp;
+	}
+
+	// store previous approximation for the next step
+	prevP = p;
+	return true;
+}
+
+template <typename T>
+bool BasicRegulaFalsiStepper<T>::done() const
+{
+	return finished;
+}
+
+template <typename T>
+std::size_t BasicRegulaFalsiStepper<T>::iterations() const
+{
+	return iter;
+}
+
+template <typename T>
+const RegulaFalsiTraceStep& BasicRegulaFalsiStepper<T>::current() const
+{
+	return state;
+}
+
+template <typename T>
+T BasicRegulaFalsiStepper<T>::root() const
+{
+	return x;
+}
+
+template <typename T>
+T BasicRegulaFalsiStepper<T>::estimate() const
+{
+	if (finished)
+	{
+		return x;
+	}
+	return iter > 0 ? latest : a + (b - a) / 2.0;
+}
+
+// Secant
+
+template <typename T>
+BasicSecantStepper<T>::BasicSecantStepper(const BasicScalarEquation<T>& eq, T x0, T x1, T eps)
+	: eq(eq), eps(eps), x0(x0), x1(x1), f0(0.0), f1(0.0)
+{
+	using std::abs;
+	using std::isfinite;
+
+	RootFinding::validateEps(eps);
+
+	// secant method is a 2-point open method:
+	// - unlike bisection/regula falsi, it does not require a bracket
+	// - it uses the last two iterates (x0,f(x0)) and (x1,f(x1))
+	// - update formula (teacher style):
+	//   p = x1 - f(x1) * (x1 - x0) / (f(x1) - f(x0))
+	// - typical stop criteria: small residual |f(p)| or small step |p-x1|
+	f0 = eq(x0);
+	f1 = eq(x1);
+
+	if (!isfinite(f0) || !isfinite(f1))
+	{
+		throw std::invalid_argument("secant requires finite function values at initial points");
+	}
+
+	if (abs(f0) <= eps)
+	{
+		finished = true;
+		x = x0;
+	}
+	else if (abs(f1) <= eps)
+	{
+		finished = true;
+		x = x1;
+	}
+}
+
+template <typename T>
+bool BasicSecantStepper<T>::step()
+{
+	using std::abs;
+	using std::isfinite;
+
+	if (failed)
+	{
+		throw std::invalid_argument("secant produced non-finite f(p)");
+	}
+	if (finished)
+	{
+		return false;
+	}
+	if (iter == maxIterations)
+	{
+		throw NonConvergenceException("secant did not converge within iteration limit");
+	}
+
+	// compute secant slope denominator
+	// (must be non-zero to avoid division by zero)
+	const T denom = (f1 - f0);
+	if (denom == 0.0)
+	{
+		throw std::invalid_argument("secant failed: f(x1) - f(x0) == 0");
+	}
+
+	// secant update using last two points
+	// p is the intersection of the secant through the two points with the x-axis
+	const T p = x1 - f1 * (x1 - x0) / denom;
+	// evaluate function in the new approximation
+	const T fp = eq(p);
+
+	// the iteration and the two previous points
+	state = SecantTraceStep{ iter, static_cast<double>(x0), static_cast<double>(x1), static_cast<double>(p),
+		static_cast<double>(fp) };
+	latest = p;
+	iter++;
+
+	if (!isfinite(fp))
+	{
+		failed = true;
+		return true;
+	}
+
+	// stop criteria: small residual or small step (iterates stop moving)
+	if (abs(fp) <= eps || abs(p - x1) <= eps)
+	{
+		finished = true;
+		x = p;
+		return true;
+	}
+
+	// advance the two-point window for the next iteration
+	x0 = x1;
+	f0 = f1;
+	x1 = p;
+	f1 = fp;
+	return true;
+}
+
+template <typename T>
+bool BasicSecantStepper<T>::done() const
+{
+	return finished;
+}
+
+template <typename T>
+std::size_t BasicSecantStepper<T>::iterations() const
+{
+	return iter;
+}
+
+template <typename T>
+const SecantTraceStep& BasicSecantStepper<T>::current() const
+{
+	return state;
+}
+
+template <typename T>
+T BasicSecantStepper<T>::root() const
+{
+	return x;
+}
+
+template <typename T>
+T BasicSecantStepper<T>::estimate() const
+{
+	if (finished)
+	{
+		return x;
+	}
+	return iter > 0 ? latest : x1;
+}
+
+// Newton
+
+template <typename T>
+BasicNewtonStepper<T>::BasicNewtonStepper(const BasicScalarEquation<T>& eq, BasicFunction1D<T> derivative, T x0, T eps)
+	: eq(eq), derivative(std::move(derivative)), eps(eps), x0(x0), f0(0.0)
+{
+	using std::abs;
+	using std::isfinite;
+
+	RootFinding::validateEps(eps);
+
+	// newton method (tangent method) is an open method:
+	// - requires a derivative function f'(x)
+	// - update formula (teacher style):
+	//   p = x - f(x)/f'(x)
+	// - convergence is typically fast near a simple root, but it is not guaranteed
+	// - we must explicitly guard against f'(x)=0 and non-finite values
+	if (!this->derivative)
+	{
+		throw std::invalid_argument("newton requires a valid derivative function");
+	}
+
+	f0 = eq(x0);
+	if (!isfinite(f0))
+	{
+		throw std::invalid_argument("newton requires finite f(x0)");
+	}
+
+	if (abs(f0) <= eps)
+	{
+		finished = true;
+		x = x0;
+	}
+}
+
+template <typename T>
+bool BasicNewtonStepper<T>::step()
+{
+	using std::abs;
+	using std::isfinite;
+
+	if (failed)
+	{
+		throw std::invalid_argument("newton produced non-finite f(p)");
+	}
+	if (finished)
+	{
+		return false;
+	}
+	if (iter == maxIterations)
+	{
+		throw NonConvergenceException("newton did not converge within iteration limit");
+	}
+
+	// evaluate derivative at current point
+	const T df = derivative(x0);
+	if (!isfinite(df))
+	{
+		throw std::invalid_argument("newton requires finite f'(x)");
+	}
+	if (df == 0.0)
+	{
+		throw NonConvergenceException("newton failed: derivative is zero");
+	}
+
+	// newton update p = x - f(x)/f'(x)
+	// p is the x-intersection of the tangent line at (x0, f(x0))
+	const T p = x0 - f0 / df;
+	// evaluate function in the new approximation
+	const T fp = eq(p);
+
+	// x, f(x), f'(x) and the next iterate
+	state = NewtonTraceStep{ iter, static_cast<double>(x0), static_cast<double>(f0), static_cast<double>(df),
+		static_cast<double>(p), static_cast<double>(fp) };
+	latest = p;
+	iter++;
+
+	if (!isfinite(fp))
+	{
+		failed = true;
+		return true;
+	}
+	// stop criteria: small residual or small step (iterates stop moving)
+	if (abs(fp) <= eps || abs(p - x0) <= eps)
+	{
+		finished = true;
+		x = p;
+		return true;
+	}
+
+	// advance to next iterate
+	x0 = p;
+	f0 = fp;
+	return true;
+}
+
+template <typename T>
+bool BasicNewtonStepper<T>::done() const
+{
+	return finished;
+}
+
+template <typename T>
+std::size_t BasicNewtonStepper<T>::iterations() const
+{
+	return iter;
+}
+
+template <typename T>
+const NewtonTraceStep& BasicNewtonStepper<T>::current() const
+{
+	return state;
+}
+
+template <typename T>
+T BasicNewtonStepper<T>::root() const
+{
+	return x;
+}
+
+template <typename T>
+T BasicNewtonStepper<T>::estimate() const
+{
+	if (finished)
+	{
+		return x;
+	}
+	return iter > 0 ? latest : x0;
+}
+
+extern template class BasicBisectionStepper<double>;
+extern template class BasicRegulaFalsiStepper<double>;
+extern template class BasicSecantStepper<double>;
+extern template class BasicNewtonStepper<double>;
@@ -1,15 +1,40 @@
 #pragma once
 
 #include <functional>
+#include <utility>
 
-using Function1D = std::function<double(double)>;
+template <typename T>
+using BasicFunction1D = std::function<T(T)>;
 
-class ScalarEquation {
+using Function1D = BasicFunction1D<double>;
+
+// f: T -> T. T is double for the course equations; other scalar types
+// (e.g. Decimal<t>) evaluate the equation in their own arithmetic.
+template <typename T>
+class BasicScalarEquation {
 private:
-	Function1D f;
+	BasicFunction1D<T> f;
 
 public:
-	explicit ScalarEquation(Function1D f);
+	using Scalar = T;
+
+	explicit BasicScalarEquation(BasicFunction1D<T> f);
 
-	double operator()(double x) const;
+	T operator()(T x) const;
 };
+
+using ScalarEquation = BasicScalarEquation<double>;
+
+template <typename T>
+BasicScalarEquation<T>::BasicScalarEquation(BasicFunction1D<T> f)
+	: f(std::move(f))
+{
+}
+
+template <typename T>
+T BasicScalarEquation<T>::operator()(T x) const
+{
+	return f(x);
+}
+
+extern template class BasicScalarEquation<double>;
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "linear/LinearSystem.h"
+
+#include "utils/JsonWriter.h"
+
+#include "nlohmann/json.hpp"
+
+#include <cstddef>
+
+// Parameters of a `tema2_gauss --json` style request.
+struct GaussRequest
+{
+	int system = 1;
+	bool trace = true;
+	int significantDigits = 3;
+};
+
+// Parameters of a `tema3_iterative --json` style request.
+struct IterativeRequest
+{
+	int system = 1;
+	bool trace = true;
+	std::size_t iterations = 2;
+};
+
+// Parameters of a `tema2_gauss --sweep` style request.
+struct GaussSweepRequest
+{
+	int system = 1;
+	int minDigits = 2;
+	int maxDigits = 16;
+	// Worker threads; 0 picks ThreadPool::defaultThreadCount().
+	std::size_t threads = 0;
+};
+
+// Request/response layer for the Referat 01 linear systems, shared by the
+// tema2 / tema3 drivers and the HTTP service. Invalid parameters are
+// reported as std::invalid_argument with a user-facing message.
+class LinearSystemsService {
+public:
+	LinearSystemsService() = delete;
+
+	// Systems of the Gaussian elimination exercise; which: 1-4.
+	static LinearSystem gaussSystem(int which);
+
+	// Systems of the Jacobi / Gauss-Seidel exercise; which: 1-4.
+	static LinearSystem iterativeSystem(int which);
+
+	// Writes the tema2 result object: the system, the elimination trace
+	// (matrices rebuilt by a replay cursor) when requested, x and its residual.
+	static void solveGauss(const GaussRequest& request, JsonWriter& out);
+
+	// Writes the precision sweep of a Gaussian elimination system: one row
+	// per t with x, its error, residual, growth factor and time.
+	static void sweepGauss(const GaussSweepRequest& request, JsonWriter& out);
+
+	// Writes the tema3 result object; each method's iterates are written
+	// while it runs.
+	static void solveIterative(const IterativeRequest& request, JsonWriter& out);
+
+	// Keys: system, trace (bool), significantDigits (1-17).
+	static GaussRequest parseGaussRequest(const nlohmann::json& params);
+
+	// Keys: system, trace (bool), iterations (0-1e7).
+	static IterativeRequest parseIterativeRequest(const nlohmann::json& params);
+};
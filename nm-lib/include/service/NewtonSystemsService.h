@@ -0,0 +1,41 @@
+#pragma once
+
+#include "nonlinear/NonlinearSystem.h"
+
+#include "utils/JsonWriter.h"
+
+#include "nlohmann/json.hpp"
+
+#include <string>
+
+// One of the Referat 02 nonlinear systems together with its starting point.
+struct NewtonSystemProblem
+{
+	int which;
+	std::string statement;
+	NonlinearSystem system;
+	Vector x0;
+};
+
+// Parameters of a `tema4_newton_systems --json` style request.
+struct NewtonSystemRequest
+{
+	int system = 4;
+	bool trace = true;
+	double eps = 1e-5;
+};
+
+class NewtonSystemsService {
+public:
+	NewtonSystemsService() = delete;
+
+	// which: 1-4, throws std::invalid_argument otherwise.
+	static NewtonSystemProblem problem(int which);
+
+	// Writes the tema4 result object; iterations are written while the
+	// solver runs. Solver failures throw NumericalException.
+	static void solve(const NewtonSystemRequest& request, JsonWriter& out);
+
+	// Keys: system, trace (bool), eps.
+	static NewtonSystemRequest parseRequest(const nlohmann::json& params);
+};
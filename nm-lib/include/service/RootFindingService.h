@@ -0,0 +1,122 @@
+#pragma once
+
+#include "nonlinear/RootFinding.h"
+
+#include "utils/ColumnarTrace.h"
+#include "utils/JsonWriter.h"
+#include "utils/TraceDecimation.h"
+
+#include "nlohmann/json.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// One of the course equations together with its default bracket.
+struct RootFindingProblem
+{
+	int eq;
+	std::string statement;
+	ScalarEquation f;
+	Function1D derivative;
+	double a;
+	double b;
+};
+
+enum class RootFindingMode
+{
+	Sequential,
+	Parallel,
+	Race
+};
+
+// Parameters of one /api/rootfinding/trace style request. Unset optionals
+// fall back to the problem defaults, exactly like the tema1 CLI flags.
+struct RootFindingRequest
+{
+	int eq = 4;
+	int interval = 1;
+	std::optional<double> a;
+	std::optional<double> b;
+	std::optional<double> x0;
+	std::optional<double> eps;
+	bool trace = true;
+	TraceDecimation decimation; // which trace steps are kept
+	RootFindingMode mode = RootFindingMode::Sequential;
+	std::size_t threads = 0; // 0 = one thread per method
+	// Deadline for the whole solve, checked once per iteration. Methods still
+	// running when it passes report "status" and their best iterate instead
+	// of a root (in parallel / race mode they end as cancelled).
+	std::optional<double> timeoutMs;
+};
+
+// A request with the problem defaults applied and its parameters validated.
+struct ResolvedRootFindingRequest
+{
+	RootFindingProblem problem;
+	double eps;
+	double a;
+	double b;
+	double x0;
+	// Deadline of the whole request (never expires without timeoutMs).
+	StopCondition stop;
+};
+
+// Request/response layer shared by the tema1 driver and the solver worker.
+// Invalid parameters and solver failures are reported as exceptions
+// (std::invalid_argument / NumericalException) with a user-facing message.
+class RootFindingService {
+public:
+	RootFindingService() = delete;
+
+	static RootFindingProblem problem(int eq, int interval);
+
+	// Applies the defaults (eps 1e-7, the problem's bracket, x0 at its middle)
+	// and checks the bracket; the one place every front end gets them from.
+	// timeoutMs counts from `start` (the batch start for solveBatch).
+	static ResolvedRootFindingRequest resolve(const RootFindingRequest& request, std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now());
+
+	// Writes the result object to `out`. In sequential mode full traces are
+	// written while the solvers run, so memory does not grow with the trace;
+	// decimated traces are written once each method finishes, together with
+	// its "traceSteps" (the number of steps before decimation).
+	// On an exception part of the object may already have been written.
+	static void solve(const RootFindingRequest& request, JsonWriter& out);
+
+	// Same result as an NMTC container (utils/ColumnarTrace.h): one table per
+	// traced method, named like the method, and the rest of the payload as
+	// the metadata JSON. `compress` selects Xor/DeltaVarint column encodings.
+	static void solveColumnar(const RootFindingRequest& request, std::ostream& out, bool compress = true);
+
+	// Streams the sequential solve as newline-delimited JSON, one record per
+	// line, handed to `out` as it is produced (at most 50 ms late):
+	//   {"event":"header", ...header fields}
+	//   {"event":"step","method":"bisection","step":{...}}   one per kept step
+	//   {"event":"method","name":"bisection","x":..,"fx":..}  when a method ends
+	//   {"event":"done"}
+	// A solver failure ends the stream with {"event":"error","method":..,"error":..}
+	// and returns false. Only the sequential mode with trace mode full or
+	// stride can stream; other requests throw before anything is written.
+	static bool solveStream(const RootFindingRequest& request, std::ostream& out);
+
+	// Solves independent requests on one thread pool (`threads` workers, 0 =
+	// one per hardware thread; with 1 they run on the calling thread) and
+	// writes a JSON array in request order:
+	//   [{"ok":true,"result":{...same object as solve}}, {"ok":false,"error":".."}, ...]
+	// A failing request does not affect the others. A request's timeoutMs
+	// counts from the start of the batch, so queued requests share the budget.
+	static void solveBatch(const std::vector<RootFindingRequest>& requests, JsonWriter& out, std::size_t threads = 0);
+
+	// Accepts the same keys as the HTTP query: eq, interval, a, b, x0, eps,
+	// plus trace (bool), traceMode ("full" | "head-tail" | "stride" | "lttb"),
+	// traceLimit, mode ("sequential" | "parallel" | "race"), threads (clamped
+	// to the number of methods and of hardware threads) and timeoutMs.
+	static RootFindingRequest parseRequest(const nlohmann::json& params);
+
+	// A JSON array of parseRequest objects. The first invalid entry rejects
+	// the whole batch; its message starts with the entry's index.
+	static std::vector<RootFindingRequest> parseBatch(const nlohmann::json& params);
+};
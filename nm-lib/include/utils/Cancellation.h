@@ -0,0 +1,140 @@
+#pragma once
+
+#include "utils/Exceptions.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+// Shared cancellation flag. Copies refer to the same flag, so a token can be
+// handed to a worker while the owner keeps a copy to cancel it. A
+// default-constructed token has no flag (and allocates nothing): it is never
+// cancelled, and cancel() does nothing. Cancellable tokens come from create().
+class CancellationToken {
+private:
+	std::shared_ptr<std::atomic<bool>> flag;
+
+public:
+	CancellationToken() = default;
+
+	static CancellationToken create()
+	{
+		CancellationToken token;
+		token.flag = std::make_shared<std::atomic<bool>>(false);
+		return token;
+	}
+
+	void cancel() const
+	{
+		if (flag)
+		{
+			flag->store(true, std::memory_order_relaxed);
+		}
+	}
+
+	bool isCancelled() const
+	{
+		return flag && flag->load(std::memory_order_relaxed);
+	}
+
+	void throwIfCancelled(const char* where) const
+	{
+		if (isCancelled())
+		{
+			throw OperationCancelledException(where);
+		}
+	}
+};
+
+// Point in time after which a solve should stop; default-constructed it never expires.
+class Deadline {
+private:
+	using Clock = std::chrono::steady_clock;
+
+	Clock::time_point at;
+	bool set;
+
+public:
+	Deadline()
+		: at(), set(false)
+	{
+	}
+
+	static Deadline after(std::chrono::milliseconds duration)
+	{
+		Deadline d;
+		d.at = Clock::now() + duration;
+		d.set = true;
+		return d;
+	}
+
+	bool isSet() const
+	{
+		return set;
+	}
+
+	bool expired() const
+	{
+		return set && Clock::now() >= at;
+	}
+};
+
+enum class SolveStatus
+{
+	// The solver ran to its normal end (converged, or did every requested sweep).
+	Completed,
+	Cancelled,
+	DeadlineExceeded
+};
+
+inline const char* solveStatusName(SolveStatus status)
+{
+	switch (status)
+	{
+	case SolveStatus::Completed:
+		return "completed";
+	case SolveStatus::Cancelled:
+		return "cancelled";
+	case SolveStatus::DeadlineExceeded:
+		return "deadlineExceeded";
+	}
+	return "unknown";
+}
+
+// Checked by the solvers once per iteration (per pivot column / back
+// substitution row in Gaussian elimination).
+struct StopCondition
+{
+	CancellationToken token;
+	Deadline deadline;
+
+	// Completed while the solve may go on.
+	SolveStatus check() const
+	{
+		if (token.isCancelled())
+		{
+			return SolveStatus::Cancelled;
+		}
+		if (deadline.expired())
+		{
+			return SolveStatus::DeadlineExceeded;
+		}
+		return SolveStatus::Completed;
+	}
+};
+
+// Result of a solve that may be stopped early: the solution when Completed,
+// otherwise the best iterate reached so far.
+template <typename T>
+struct SolveOutcome
+{
+	SolveStatus status;
+	T x;
+	std::size_t iterations;
+
+	bool completed() const
+	{
+		return status == SolveStatus::Completed;
+	}
+};
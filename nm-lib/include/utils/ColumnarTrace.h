@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Binary columnar container for solver traces ("NMTC").
+//
+// A file holds any number of tables (one per traced method). A table is a
+// list of typed columns; a column may be `width` values wide per row (e.g. a
+// vector iterate or a flattened Jacobian). Rows are appended one at a time
+// and written in blocks of contiguous, 8-byte aligned column chunks, so the
+// writer needs memory for one block only. A footer at the end describes the
+// tables, columns and block offsets, plus a free-form metadata string
+// (the scalar part of the result as JSON).
+//
+// Layout (little-endian):
+//   "NMTC" u16 version u16 reserved u32 reserved
+//   column chunks ...
+//   footer
+//   u64 footerOffset "NMTC"
+//
+// Footer:
+//   u32 metadataLength, metadata bytes
+//   u32 tableCount, per table:
+//     u16 nameLength, name, u64 rowCount
+//     u16 columnCount, per column: u16 nameLength, name, u8 type, u8 encoding, u32 width
+//     u32 blockCount, per block: u64 rowCount, per column: u64 offset, u64 byteLength
+//
+// Encodings:
+//   Raw          8 bytes per value; readable in place (mmap / Float64Array).
+//   Xor          Float64 only. Each value is XORed with the same component of
+//                the previous row; 0 is one bit, otherwise 1 bit + 6 bits of
+//                leading zeros + 6 bits of (length - 1) + the meaningful bits.
+//   DeltaVarint  UInt64 only. Zigzag delta to the previous row, LEB128.
+// Every chunk restarts its predictors, so blocks decode independently.
+
+enum class ColumnType : std::uint8_t
+{
+	Float64 = 1,
+	UInt64 = 2
+};
+
+enum class ColumnEncoding : std::uint8_t
+{
+	Raw = 0,
+	Xor = 1,
+	DeltaVarint = 2
+};
+
+struct ColumnSpec
+{
+	std::string name;
+	ColumnType type = ColumnType::Float64;
+	ColumnEncoding encoding = ColumnEncoding::Raw;
+	std::uint32_t width = 1;
+};
+
+struct ColumnarBlock
+{
+	std::uint64_t rowCount;
+	// Per column: byte offset from the start of the file and byte length.
+	std::vector<std::uint64_t> offsets;
+	std::vector<std::uint64_t> lengths;
+};
+
+struct ColumnarTable
+{
+	std::string name;
+	std::uint64_t rowCount = 0;
+	std::vector<ColumnSpec> columns;
+	std::vector<ColumnarBlock> blocks;
+
+	// Index of the named column; throws std::invalid_argument if absent.
+	std::size_t columnIndex(const std::string& column) const;
+};
+
+class ColumnarTraceWriter {
+private:
+	std::ostream& out;
+	std::size_t rowsPerBlock;
+	std::uint64_t position;
+	std::vector<ColumnarTable> tables;
+	std::string metadata;
+	bool tableOpen;
+	bool finished;
+
+	// Current block: one buffer of decoded values per column.
+	std::vector<std::vector<double>> pending;
+	std::size_t pendingRows;
+	std::size_t rowWidth;
+
+	void writeBytes(const void* data, std::size_t n);
+	void flushBlock();
+
+public:
+	explicit ColumnarTraceWriter(std::ostream& out, std::size_t rowsPerBlock = 4096);
+	~ColumnarTraceWriter();
+
+	ColumnarTraceWriter(const ColumnarTraceWriter&) = delete;
+	ColumnarTraceWriter& operator=(const ColumnarTraceWriter&) = delete;
+
+	void beginTable(const std::string& name, std::vector<ColumnSpec> columns);
+
+	// One row: the values of every column in order, `width` values each
+	// (UInt64 columns are given as doubles holding integers).
+	void addRow(const double* values, std::size_t count);
+	void addRow(std::initializer_list<double> values);
+
+	void endTable();
+
+	void setMetadata(std::string json);
+
+	// Writes the footer. Called by the destructor if not called explicitly.
+	void finish();
+};
+
+class ColumnarTraceReader {
+private:
+	// Keeps the mapping (or owned buffer) alive for copies of the reader.
+	std::shared_ptr<const void> storage;
+	const unsigned char* data = nullptr;
+	std::size_t size = 0;
+	std::string metadataText;
+	std::vector<ColumnarTable> tableList;
+
+	void parse();
+
+public:
+	// Memory-maps the file (read-only); raw columns are then read in place.
+	static ColumnarTraceReader open(const std::string& path);
+	static ColumnarTraceReader fromBuffer(std::vector<unsigned char> bytes);
+
+	const std::string& metadata() const;
+	const std::vector<ColumnarTable>& tables() const;
+	const ColumnarTable& table(const std::string& name) const;
+
+	// All values of a column (rows * width), decoded across blocks.
+	std::vector<double> readColumn(const ColumnarTable& table, std::size_t column) const;
+
+	// Zero-copy view of a Raw Float64 chunk. Returns nullptr when the chunk
+	// is encoded, is not Float64, or the host is not little-endian.
+	const double* rawChunk(const ColumnarTable& table, std::size_t block, std::size_t column) const;
+};
@@ -21,3 +21,8 @@ class NonConvergenceException : public NumericalException {
 public:
 	using NumericalException::NumericalException;
 };
+
+class OperationCancelledException : public NumericalException {
+public:
+	using NumericalException::NumericalException;
+};
@@ -3,9 +3,15 @@
 #include "core/Matrix.h"
 #include "core/Vector.h"
 
+#include "utils/JsonWriter.h"
+
 #include "nlohmann/json.hpp"
 
+#include <cmath>
 #include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
 
 using nlohmann::json;
 
@@ -32,4 +38,61 @@ inline json matrixToJson(const Matrix& A)
         rows.push_back(row);
     }
     return rows;
-}
\ No newline at end of file
+}
+
+inline void writeVector(JsonWriter& w, const Vector& v)
+{
+    w.beginArray();
+    for (std::size_t i = 0; i < v.size(); i++)
+    {
+        w.value(v[i]);
+    }
+    w.endArray();
+}
+
+inline void writeMatrix(JsonWriter& w, const Matrix& A)
+{
+    w.beginArray();
+    for (std::size_t i = 0; i < A.rowCount(); i++)
+    {
+        w.beginArray();
+        for (std::size_t j = 0; j < A.colCount(); j++)
+        {
+            w.value(A(i, j));
+        }
+        w.endArray();
+    }
+    w.endArray();
+}
+
+// Reads an optional finite number from a request object; null counts as absent.
+// Throws std::invalid_argument naming the key otherwise.
+inline std::optional<double> optionalNumber(const json& params, const char* key)
+{
+    const auto it = params.find(key);
+    if (it == params.end() || it->is_null())
+    {
+        return std::nullopt;
+    }
+    if (!it->is_number())
+    {
+        throw std::invalid_argument(std::string("Invalid ") + key + ". Must be a number.");
+    }
+    const double v = it->get<double>();
+    if (!std::isfinite(v))
+    {
+        throw std::invalid_argument(std::string("Invalid ") + key + ". Must be a finite number.");
+    }
+    return v;
+}
+
+// Optional boolean; absent, null or a non-boolean value keep `fallback`.
+inline bool optionalBool(const json& params, const char* key, bool fallback)
+{
+    const auto it = params.find(key);
+    if (it == params.end() || !it->is_boolean())
+    {
+        return fallback;
+    }
+    return it->get<bool>();
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Streaming JSON writer: values go straight to the output (through a small
+// buffer) instead of into a DOM, so a trace of any length is written in
+// constant memory. Output is compact; doubles use the shortest form that
+// round-trips (std::to_chars) and non-finite values are written as null.
+//
+// Usage:
+//   JsonWriter w(std::cout);
+//   w.beginObject();
+//   w.field("kind", "rootfinding");
+//   w.key("trace"); w.beginArray(); ... w.endArray();
+//   w.endObject();
+//   w.flush();
+class JsonWriter {
+private:
+	std::ostream& out;
+	std::string buffer;
+	// One entry per open object/array: true until its first element is written.
+	std::vector<bool> first;
+	bool afterKey;
+
+	void separator();
+	void raw(const char* s, std::size_t n);
+	void writeString(const std::string& s);
+	void writeUnsigned(unsigned long long v);
+	void writeSigned(long long v);
+
+public:
+	explicit JsonWriter(std::ostream& out);
+	~JsonWriter();
+
+	JsonWriter(const JsonWriter&) = delete;
+	JsonWriter& operator=(const JsonWriter&) = delete;
+
+	void beginObject();
+	void endObject();
+	void beginArray();
+	void endArray();
+
+	void key(const std::string& name);
+
+	void value(double v);
+	void value(bool v);
+	void value(const std::string& v);
+	void value(const char* v);
+	void null();
+
+	template <typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+	void value(T v)
+	{
+		separator();
+		if (std::is_signed<T>::value)
+		{
+			writeSigned(static_cast<long long>(v));
+		}
+		else
+		{
+			writeUnsigned(static_cast<unsigned long long>(v));
+		}
+	}
+
+	template <typename T>
+	void field(const std::string& name, const T& v)
+	{
+		key(name);
+		value(v);
+	}
+
+	// Pre-serialized JSON (e.g. a nlohmann::json dump) written as one value.
+	void rawValue(const std::string& json);
+
+	// Ends a top-level value with a newline, for newline-delimited JSON
+	// (one record per line).
+	void endLine();
+
+	// Hands buffered output to the stream (also done by the destructor).
+	void flush();
+};
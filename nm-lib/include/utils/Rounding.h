@@ -1,3 +1,9 @@
 #pragma once
 
+#include <cstddef>
+
 double roundToSignificantDigits(double value, int significantDigits);
+
+// Rounds values[0..count) in place; each element gets exactly the result of
+// the scalar overload.
+void roundToSignificantDigits(double* values, std::size_t count, int significantDigits);
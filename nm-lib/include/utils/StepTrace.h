@@ -0,0 +1,24 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+// In-memory recorder: the trace-sink policy (see utils/TraceSink.h) behind
+// the solver trace structs. Every step is kept in `steps`.
+template <typename Step>
+struct StepTrace
+{
+	static constexpr bool enabled = true;
+
+	std::vector<Step> steps;
+
+	void record(const Step& step)
+	{
+		steps.push_back(step);
+	}
+
+	void record(Step&& step)
+	{
+		steps.push_back(std::move(step));
+	}
+};
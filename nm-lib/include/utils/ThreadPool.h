@@ -0,0 +1,45 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small fixed-size pool used to run independent solves concurrently.
+// Tasks must not throw; wrap them if they can (see MethodRace).
+class ThreadPool {
+private:
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> queue;
+	std::mutex mutex;
+	std::condition_variable taskAvailable;
+	std::condition_variable idle;
+	std::size_t running;
+	bool stopping;
+
+	void workerLoop();
+
+public:
+	explicit ThreadPool(std::size_t threadCount = defaultThreadCount());
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	std::size_t size() const;
+
+	void submit(std::function<void()> task);
+
+	// Blocks until the queue is empty and no task is running.
+	void wait();
+
+	// Runs task(0), ..., task(count - 1) on the pool and blocks until those
+	// have finished (other submitted tasks may still be running). Must not be
+	// called from a pool thread.
+	void runBatch(std::size_t count, const std::function<void(std::size_t)>& task);
+
+	static std::size_t defaultThreadCount();
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "utils/TraceSink.h"
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Recording modes for long traces (regula falsi and secant can run for 10^5
+// steps while a plot needs a few hundred points). `limit` depends on the mode:
+// - HeadTail: the first `limit` and the last `limit` steps;
+// - Stride:   every `limit`-th step, plus the last one;
+// - Lttb:     at most `limit` steps picked by Largest-Triangle-Three-Buckets
+//             on the convergence curve (iteration vs log10 |f|), which keeps
+//             its shape with few points.
+enum class TraceDecimationMode
+{
+	Full,
+	HeadTail,
+	Stride,
+	Lttb
+};
+
+struct TraceDecimation
+{
+	TraceDecimationMode mode = TraceDecimationMode::Full;
+	std::size_t limit = 0;
+
+	bool isFull() const;
+
+	// "full" | "head-tail" | "stride" | "lttb"
+	const char* modeName() const;
+
+	// Parses a mode name; limit 0 picks the mode's default (250 / 100 / 500).
+	// Throws std::invalid_argument for an unknown mode or an unusable limit.
+	static TraceDecimation parse(const std::string& mode, std::size_t limit = 0);
+};
+
+// Ascending indices of at most `threshold` points of the curve (i, y[i])
+// chosen by LTTB; the first and last points are always kept.
+std::vector<std::size_t> lttbSelect(const std::vector<double>& y, std::size_t threshold);
+
+// y value of a step on the convergence curve: log10 |f| (non-finite -> 300).
+double convergenceCurveValue(double residual);
+
+// Trace-sink policy (utils/TraceSink.h) applying a TraceDecimation while
+// recording. HeadTail holds O(limit) steps, Stride O(steps / limit) through a
+// SampledTrace; Lttb needs the whole curve and decimates in steps(). Steps must provide convergenceValue(step)
+// (the residual plotted by the convergence curve).
+template <typename Step>
+class DecimatedTrace {
+private:
+	TraceDecimation decimation;
+	std::size_t seen = 0;
+	// Full / Lttb: every step. HeadTail: the head.
+	std::vector<Step> kept;
+	std::deque<Step> tail;
+	// Stride mode only (stride 1 otherwise, and unused).
+	SampledTrace<Step> sampled;
+
+public:
+	static constexpr bool enabled = true;
+
+	explicit DecimatedTrace(TraceDecimation decimation = {})
+		: decimation(decimation), sampled(decimation.mode == TraceDecimationMode::Stride ? decimation.limit : 1)
+	{
+	}
+
+	// Number of steps the solver produced.
+	std::size_t recorded() const
+	{
+		return seen;
+	}
+
+	void record(const Step& step)
+	{
+		seen++;
+		switch (decimation.mode)
+		{
+		case TraceDecimationMode::HeadTail:
+			if (kept.size() < decimation.limit)
+			{
+				kept.push_back(step);
+			}
+			else
+			{
+				tail.push_back(step);
+				if (tail.size() > decimation.limit)
+				{
+					tail.pop_front();
+				}
+			}
+			break;
+		case TraceDecimationMode::Stride:
+			sampled.record(step);
+			break;
+		default:
+			kept.push_back(step);
+			break;
+		}
+	}
+
+	// The kept steps in iteration order.
+	std::vector<Step> steps() const
+	{
+		if (decimation.mode == TraceDecimationMode::HeadTail)
+		{
+			std::vector<Step> out(kept);
+			out.insert(out.end(), tail.begin(), tail.end());
+			return out;
+		}
+		if (decimation.mode == TraceDecimationMode::Stride)
+		{
+			return sampled.steps();
+		}
+		if (decimation.mode != TraceDecimationMode::Lttb || kept.size() <= decimation.limit)
+		{
+			return kept;
+		}
+
+		std::vector<double> y(kept.size());
+		for (std::size_t i = 0; i < kept.size(); i++)
+		{
+			y[i] = convergenceCurveValue(convergenceValue(kept[i]));
+		}
+		std::vector<Step> out;
+		for (std::size_t i : lttbSelect(y, decimation.limit))
+		{
+			out.push_back(kept[i]);
+		}
+		return out;
+	}
+};
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "utils/StepTrace.h"
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Trace-sink policies for the solver templates. A sink has a compile-time
+// `enabled` flag and a record(step) member; solvers put every piece of trace
+// work behind `if constexpr (Sink::enabled)`, so a NoTrace instantiation is
+// the bare kernel. Available sinks:
+// - NoTrace: records nothing;
+// - StepTrace<Step> (and the *Trace structs): keeps every step in memory;
+// - StreamingSink: hands each step to a callable as soon as it exists;
+// - SampledTrace<Step>: keeps every stride-th step plus the latest one.
+
+struct NoTrace
+{
+	static constexpr bool enabled = false;
+
+	template <typename Step>
+	void record(const Step&)
+	{
+	}
+};
+
+template <typename F>
+class StreamingSink {
+private:
+	F consume;
+
+public:
+	static constexpr bool enabled = true;
+
+	explicit StreamingSink(F consume)
+		: consume(std::move(consume))
+	{
+	}
+
+	template <typename Step>
+	void record(const Step& step)
+	{
+		consume(step);
+	}
+};
+
+// auto sink = streamTo([&](const BisectionTraceStep& s) { ... });
+template <typename F>
+StreamingSink<F> streamTo(F consume)
+{
+	return StreamingSink<F>(std::move(consume));
+}
+
+// The stride rule of the sampling sinks, in one place: steps 0, stride,
+// 2*stride, ... are samples, handed to `emit` as they arrive; the latest step
+// off the stride is held as pending() so that whoever consumes the samples
+// can still end with the last step.
+template <typename Step>
+class StrideSampler {
+private:
+	std::size_t stride;
+	std::size_t seen = 0;
+	std::optional<Step> latest;
+
+public:
+	explicit StrideSampler(std::size_t stride)
+		: stride(stride)
+	{
+		if (stride == 0)
+		{
+			throw std::invalid_argument("StrideSampler: stride must be positive");
+		}
+	}
+
+	// Number of steps offered, samples or not.
+	std::size_t recorded() const
+	{
+		return seen;
+	}
+
+	// The latest step when it was not a sample (nullopt otherwise).
+	const std::optional<Step>& pending() const
+	{
+		return latest;
+	}
+
+	template <typename S, typename Emit>
+	void record(S&& step, Emit&& emit)
+	{
+		if (seen++ % stride == 0)
+		{
+			latest.reset();
+			emit(std::forward<S>(step));
+		}
+		else
+		{
+			latest = std::forward<S>(step);
+		}
+	}
+};
+
+template <typename Step>
+class SampledTrace {
+private:
+	StrideSampler<Step> sampler;
+	std::vector<Step> samples;
+
+public:
+	static constexpr bool enabled = true;
+
+	explicit SampledTrace(std::size_t stride)
+		: sampler(stride)
+	{
+	}
+
+	std::size_t recorded() const
+	{
+		return sampler.recorded();
+	}
+
+	void record(const Step& step)
+	{
+		sampler.record(step, [this](const Step& s) { samples.push_back(s); });
+	}
+
+	void record(Step&& step)
+	{
+		sampler.record(std::move(step), [this](Step&& s) { samples.push_back(std::move(s)); });
+	}
+
+	// Steps 0, stride, 2*stride, ... followed by the latest step.
+	std::vector<Step> steps() const
+	{
+		std::vector<Step> out(samples);
+		if (sampler.pending())
+		{
+			out.push_back(*sampler.pending());
+		}
+		return out;
+	}
+};
@@ -0,0 +1,26 @@
+#include "core/AlignedAllocator.h"
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#include <sys/mman.h>
+#endif
+
+void* allocateAligned(std::size_t bytes, std::size_t alignment)
+{
+    return ::operator new(bytes, std::align_val_t(alignment));
+}
+
+void deallocateAligned(void* p, std::size_t alignment) noexcept
+{
+    ::operator delete(p, std::align_val_t(alignment));
+}
+
+void adviseHugePages(void* p, std::size_t bytes) noexcept
+{
+#if defined(__linux__) && !defined(__EMSCRIPTEN__) && defined(MADV_HUGEPAGE)
+    // Advisory only: the block stays usable with normal pages if it fails.
+    madvise(p, bytes, MADV_HUGEPAGE);
+#else
+    (void)p;
+    (void)bytes;
+#endif
+}
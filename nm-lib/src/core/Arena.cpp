@@ -0,0 +1,111 @@
+#include "core/Arena.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+Arena::Arena(std::size_t firstBlockBytes)
+    : firstBlockBytes(std::max<std::size_t>(firstBlockBytes, cacheLineBytes))
+{
+}
+
+Arena::~Arena()
+{
+    for (const Block& block : blocks)
+    {
+        deallocateAligned(block.data, cacheLineBytes);
+    }
+}
+
+void* Arena::allocate(std::size_t bytes, std::size_t alignment)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > cacheLineBytes)
+    {
+        throw std::invalid_argument("Arena::allocate: alignment must be a power of two up to a cache line");
+    }
+
+    // Blocks start on a cache line, so aligning the offset aligns the address.
+    while (top.block < blocks.size())
+    {
+        const Block& block = blocks[top.block];
+        const std::size_t offset = (top.offset + alignment - 1) & ~(alignment - 1);
+        if (offset <= block.size && bytes <= block.size - offset)
+        {
+            top.offset = offset + bytes;
+            return block.data + offset;
+        }
+        // Too small for this request: later blocks are larger; the tail of
+        // this one stays unused until the next rewind.
+        top.block++;
+        top.offset = 0;
+    }
+
+    // Doubling keeps the number of blocks logarithmic in the peak usage.
+    const std::size_t previous = blocks.empty() ? firstBlockBytes / 2 : blocks.back().size;
+    const std::size_t size = std::max(previous * 2, bytes);
+    blocks.push_back({ static_cast<std::byte*>(allocateAligned(size, cacheLineBytes)), size });
+    top.block = blocks.size() - 1;
+    top.offset = bytes;
+    return blocks.back().data;
+}
+
+Arena::Mark Arena::mark() const
+{
+    return top;
+}
+
+void Arena::rewind(Mark mark) noexcept
+{
+    top = mark;
+}
+
+void Arena::reset() noexcept
+{
+    top = Mark{};
+}
+
+void Arena::trim() noexcept
+{
+    // The block holding the top survives unless nothing is allocated in it.
+    const std::size_t keep = std::min(blocks.size(), top.offset > 0 ? top.block + 1 : top.block);
+    for (std::size_t i = keep; i < blocks.size(); i++)
+    {
+        deallocateAligned(blocks[i].data, cacheLineBytes);
+    }
+    blocks.resize(keep);
+}
+
+std::size_t Arena::used() const
+{
+    std::size_t total = top.offset;
+    for (std::size_t i = 0; i < top.block && i < blocks.size(); i++)
+    {
+        total += blocks[i].size;
+    }
+    return total;
+}
+
+std::size_t Arena::capacity() const
+{
+    std::size_t total = 0;
+    for (const Block& block : blocks)
+    {
+        total += block.size;
+    }
+    return total;
+}
+
+Arena& Arena::forThread()
+{
+    thread_local Arena arena;
+    return arena;
+}
+
+ArenaScope::ArenaScope(Arena& arena)
+    : arena(arena), start(arena.mark())
+{
+}
+
+ArenaScope::~ArenaScope()
+{
+    arena.rewind(start);
+}
@@ -0,0 +1,28 @@
+#include "core/Decimal.h"
+
+#include <stdexcept>
+
+namespace
+{
+    thread_local int currentDigits = 0;
+}
+
+DecimalPrecision::DecimalPrecision(int significantDigits)
+    : previous(currentDigits)
+{
+    if (significantDigits <= 0)
+    {
+        throw std::invalid_argument("significantDigits must be positive");
+    }
+    currentDigits = significantDigits;
+}
+
+DecimalPrecision::~DecimalPrecision()
+{
+    currentDigits = previous;
+}
+
+int DecimalPrecision::current()
+{
+    return currentDigits;
+}
@@ -0,0 +1,120 @@
+#include "core/DoubleDouble.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+// x * 10^n, by repeated squaring in double-double arithmetic; large |n| go
+// in chunks so the power itself stays finite.
+static DoubleDouble scaleByPowerOfTen(DoubleDouble x, int n)
+{
+    constexpr int chunk = 256;
+    while (n != 0)
+    {
+        const int step = std::max(-chunk, std::min(chunk, n));
+        DoubleDouble power(1.0);
+        DoubleDouble base(10.0);
+        for (int k = std::abs(step); k > 0; k >>= 1)
+        {
+            if (k & 1)
+            {
+                power *= base;
+            }
+            base *= base;
+        }
+        x = step > 0 ? x * power : x / power;
+        n -= step;
+    }
+    return x;
+}
+
+std::string DoubleDouble::toString(int digits) const
+{
+    if (std::isnan(hi))
+    {
+        return "nan";
+    }
+    if (std::isinf(hi))
+    {
+        return hi < 0.0 ? "-inf" : "inf";
+    }
+    if (hi == 0.0)
+    {
+        return "0";
+    }
+
+    digits = std::max(1, std::min(34, digits));
+
+    // x = |value| / 10^exponent in [1, 10).
+    int exponent = static_cast<int>(std::floor(std::log10(std::fabs(hi))));
+    DoubleDouble x = scaleByPowerOfTen(abs(*this), -exponent);
+    if (x >= DoubleDouble(10.0))
+    {
+        x /= 10.0;
+        exponent++;
+    }
+    else if (x < DoubleDouble(1.0))
+    {
+        x *= 10.0;
+        exponent--;
+    }
+
+    // One digit more than asked for, to round on.
+    std::string mantissa;
+    for (int i = 0; i <= digits; i++)
+    {
+        double d = std::floor(x.hi);
+        if (x - d < DoubleDouble(0.0))
+        {
+            d -= 1.0;
+        }
+        d = std::max(0.0, std::min(9.0, d));
+        mantissa.push_back(static_cast<char>('0' + static_cast<int>(d)));
+        x = (x - d) * 10.0;
+    }
+
+    const bool roundUp = mantissa.back() >= '5';
+    mantissa.pop_back();
+    if (roundUp)
+    {
+        std::size_t i = mantissa.size();
+        while (i > 0 && mantissa[i - 1] == '9')
+        {
+            mantissa[--i] = '0';
+        }
+        if (i == 0)
+        {
+            mantissa.insert(mantissa.begin(), '1');
+            mantissa.pop_back();
+            exponent++;
+        }
+        else
+        {
+            mantissa[i - 1]++;
+        }
+    }
+
+    std::string result = hi < 0.0 ? "-" : "";
+    result += mantissa[0];
+    if (mantissa.size() > 1)
+    {
+        result += '.';
+        result.append(mantissa, 1, std::string::npos);
+    }
+    const int absExponent = std::abs(exponent);
+    result += exponent < 0 ? "e-" : "e+";
+    if (absExponent < 10)
+    {
+        result += '0';
+    }
+    result += std::to_string(absExponent);
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& os, DoubleDouble a)
+{
+    if (os.precision() > 17)
+    {
+        return os << a.toString(static_cast<int>(os.precision()));
+    }
+    return os << a.hi;
+}
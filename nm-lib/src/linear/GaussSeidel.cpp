@@ -1,62 +1,40 @@
 #include "linear/GaussSeidel.h"
 
-#include "utils/Exceptions.h"
-
-#include <cmath>
-#include <stdexcept>
-
 Vector GaussSeidelSolver::iterate(const LinearSystem& system, const Vector& x0, std::size_t iterations, IterativeMethodTrace* trace)
 {
-    const std::size_t n = system.size();
-    const Matrix& A = system.matrix();
-    const Vector& b = system.rhs();
-
-    if (A.rowCount() != n || A.colCount() != n || b.size() != n)
-    {
-        throw DimensionMismatchException("GaussSeidelSolver::iterate: dimension mismatch");
-    }
-    if (x0.size() != n)
-    {
-        throw DimensionMismatchException("GaussSeidelSolver::iterate: x0 dimension mismatch");
-    }
-
-    Vector x = x0;
-    constexpr double diagEps = 1e-15;
-
     if (trace)
     {
         trace->steps.clear();
-        trace->steps.push_back({ 0, x });
+        return iterate(system, x0, iterations, *trace);
     }
+    NoTrace none;
+    return iterate(system, x0, iterations, none);
+}
 
-    for (std::size_t it = 0; it < iterations; it++)
-    {
-        for (std::size_t i = 0; i < n; i++)
-        {
-            const double aii = A(i, i);
-            if (std::fabs(aii) < diagEps)
-            {
-                throw SingularMatrixException("GaussSeidelSolver::iterate: zero diagonal entry");
-            }
+GaussSeidelStepper::GaussSeidelStepper(const LinearSystem& system, const Vector& x0)
+    : A(system.matrix()), b(system.rhs()), state{ 0, x0 }
+{
+    GaussSeidelSolver::validate(system, x0);
+}
 
-            double sum = 0.0;
-            for (std::size_t j = 0; j < n; j++)
-            {
-                if (j == i)
-                {
-                    continue;
-                }
-                sum += A(i, j) * x[j];
-            }
+bool GaussSeidelStepper::step()
+{
+    GaussSeidelSolver::sweep<double>(A, b, state.x);
 
-            x[i] = (b[i] - sum) / aii;
-        }
+    state.iter++;
+    return true;
+}
 
-        if (trace)
-        {
-            trace->steps.push_back({ it + 1, x });
-        }
-    }
+std::size_t GaussSeidelStepper::iterations() const
+{
+    return state.iter;
+}
 
-    return x;
+const IterativeTraceStep& GaussSeidelStepper::current() const
+{
+    return state;
 }
+
+template BasicVector<float> GaussSeidelSolver::iterate<float>(const BasicLinearSystem<float>&, const BasicVector<float>&, std::size_t);
+template BasicVector<long double> GaussSeidelSolver::iterate<long double>(const BasicLinearSystem<long double>&, const BasicVector<long double>&, std::size_t);
+template BasicVector<std::complex<double>> GaussSeidelSolver::iterate<std::complex<double>>(const BasicLinearSystem<std::complex<double>>&, const BasicVector<std::complex<double>>&, std::size_t);
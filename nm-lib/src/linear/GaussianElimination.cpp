@@ -1,14 +1,212 @@
 #include "linear/GaussianElimination.h"
 
+#include "core/Arena.h"
 #include "utils/Exceptions.h"
 #include "utils/Rounding.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 
-Vector GaussianElimination::solve(LinearSystem system, int significantDigits, GaussianEliminationTrace* trace)
+using OperationKind = GaussianEliminationTrace::OperationKind;
+
+// R_i <- R_i - multiplier * R_k with every product and difference rounded;
+// shared by solve() and the replay so both produce the same bits. The row is
+// rounded a block at a time through the bulk rounding call. solve() works on
+// arena copies, the replay on plain ones.
+template <typename MatrixType, typename VectorType>
+static void eliminateRow(MatrixType& A, VectorType& b, std::size_t i, std::size_t k, double multiplier, int significantDigits)
+{
+    const std::size_t n = b.size();
+
+    // A(i,k) becomes 0 by construction.
+    A(i, k) = 0.0;
+
+    constexpr std::size_t block = 256;
+    double products[block];
+    double* target = A.row(i);
+    const double* source = A.row(k);
+    for (std::size_t start = k + 1; start < n; start += block)
+    {
+        const std::size_t count = std::min(block, n - start);
+        for (std::size_t j = 0; j < count; j++)
+        {
+            products[j] = multiplier * source[start + j];
+        }
+        roundToSignificantDigits(products, count, significantDigits);
+        for (std::size_t j = 0; j < count; j++)
+        {
+            target[start + j] -= products[j];
+        }
+        roundToSignificantDigits(target + start, count, significantDigits);
+    }
+
+    const double productB = roundToSignificantDigits(multiplier * b[k], significantDigits);
+    b[i] = roundToSignificantDigits(b[i] - productB, significantDigits);
+}
+
+template <typename MatrixType, typename VectorType>
+static void swapRows(MatrixType& A, VectorType& b, std::size_t r1, std::size_t r2)
+{
+    const std::size_t n = b.size();
+    for (std::size_t j = 0; j < n; j++)
+    {
+        const double tmp = A(r1, j);
+        A(r1, j) = A(r2, j);
+        A(r2, j) = tmp;
+    }
+    const double tmpB = b[r1];
+    b[r1] = b[r2];
+    b[r2] = tmpB;
+}
+
+static std::string formatValue(double v)
+{
+    std::ostringstream oss;
+    oss.setf(std::ios::fmtflags(0), std::ios::floatfield);
+    oss << std::setprecision(8) << v;
+    return oss.str();
+}
+
+const char* GaussianEliminationTrace::OperationStep::phase() const
+{
+    return kind == OperationKind::BackSubstitution || kind == OperationKind::Final ? "back" : "forward";
+}
+
+std::string GaussianEliminationTrace::OperationStep::label() const
+{
+    switch (kind)
+    {
+    case OperationKind::Initial:
+        return "Matrice augmentată inițială";
+    case OperationKind::Pivot:
+        return "Aleg pivot pe coloana " + std::to_string(k + 1) +
+            ": R" + std::to_string(row + 1);
+    case OperationKind::Swap:
+        return "Schimb linii: R" + std::to_string(k + 1) +
+            " <-> R" + std::to_string(row + 1);
+    case OperationKind::Eliminate:
+        return "R" + std::to_string(row + 1) +
+            " <- R" + std::to_string(row + 1) +
+            " - (" + formatValue(value) + ") * R" + std::to_string(k + 1);
+    case OperationKind::Eliminated:
+        return "Matrice superior triunghiulară (după eliminare)";
+    case OperationKind::BackSubstitution:
+        return "Substituție înapoi: x" + std::to_string(row + 1) +
+            " = " + formatValue(value);
+    case OperationKind::Final:
+        return "Soluție finală (după substituție înapoi)";
+    }
+    return std::string();
+}
+
+bool GaussianEliminationTrace::OperationStep::hasSolveValue() const
+{
+    return kind == OperationKind::BackSubstitution;
+}
+
+std::size_t GaussianEliminationTrace::OperationStep::solveIndex() const
+{
+    return hasSolveValue() ? row : 0;
+}
+
+double GaussianEliminationTrace::OperationStep::solveValue() const
+{
+    return hasSolveValue() ? value : 0.0;
+}
+
+static const GaussianEliminationTrace::Checkpoint& firstCheckpoint(const GaussianEliminationTrace& trace)
+{
+    if (trace.checkpoints.empty() || trace.operations.empty())
+    {
+        throw std::invalid_argument("GaussianEliminationReplay: empty trace");
+    }
+    return trace.checkpoints.front();
+}
+
+GaussianEliminationReplay::GaussianEliminationReplay(const GaussianEliminationTrace& trace)
+    : trace(trace),
+      A(firstCheckpoint(trace).A),
+      b(trace.checkpoints.front().b),
+      current(trace.checkpoints.front().operation)
+{
+}
+
+void GaussianEliminationReplay::apply(const GaussianEliminationTrace::OperationStep& step)
+{
+    if (step.kind == OperationKind::Swap)
+    {
+        swapRows(A, b, step.k, step.row);
+    }
+    else if (step.kind == OperationKind::Eliminate)
+    {
+        eliminateRow(A, b, step.row, step.k, step.value, trace.significantDigits);
+    }
+}
+
+void GaussianEliminationReplay::seek(std::size_t operation)
+{
+    if (operation >= trace.operations.size())
+    {
+        throw std::out_of_range("GaussianEliminationReplay::seek: operation out of range");
+    }
+
+    // Last checkpoint at or before the target.
+    auto it = std::upper_bound(
+        trace.checkpoints.begin(), trace.checkpoints.end(), operation,
+        [](std::size_t op, const GaussianEliminationTrace::Checkpoint& c) { return op < c.operation; });
+    const GaussianEliminationTrace::Checkpoint& checkpoint = *(it - 1);
+
+    if (operation < current || checkpoint.operation > current)
+    {
+        A = checkpoint.A;
+        b = checkpoint.b;
+        current = checkpoint.operation;
+    }
+
+    while (current < operation)
+    {
+        current++;
+        apply(trace.operations[current]);
+    }
+}
+
+std::size_t GaussianEliminationReplay::position() const
+{
+    return current;
+}
+
+const Matrix& GaussianEliminationReplay::matrix() const
+{
+    return A;
+}
+
+const Vector& GaussianEliminationReplay::rhs() const
+{
+    return b;
+}
+
+Vector GaussianElimination::solve(const LinearSystem& system, int significantDigits, GaussianEliminationTrace* trace)
+{
+    return solve(system, significantDigits, StopCondition{}, trace).x;
+}
+
+// Largest |entry| of row i from column `from` on.
+static double rowMaxAbs(const ArenaMatrix<double>& A, std::size_t i, std::size_t from)
+{
+    const double* row = A.row(i);
+    double result = 0.0;
+    for (std::size_t j = from; j < A.colCount(); j++)
+    {
+        result = std::max(result, std::fabs(row[j]));
+    }
+    return result;
+}
+
+SolveOutcome<Vector> GaussianElimination::solve(const LinearSystem& system, int significantDigits, const StopCondition& stop, GaussianEliminationTrace* trace, GaussianEliminationStats* stats)
 {
     if (significantDigits <= 0)
     {
@@ -29,46 +227,66 @@ Vector GaussianElimination::solve(LinearSystem system, int significantDigits, Ga
         return roundToSignificantDigits(v, significantDigits);
     };
 
-    Matrix A = Aref;
-    Vector b = bref;
+    // Working copies come from the thread's arena and are released on return.
+    ArenaScope scope;
+    ArenaMatrix<double> A(Aref);
+    ArenaVector<double> b(bref);
 
-    auto pushOp = [&](const std::string& phase, const std::string& op, bool hasSolveValue = false, std::size_t solveIndex = 0, double solveValue = 0.0)
+    const std::size_t checkpointInterval = trace && trace->checkpointInterval > 0
+        ? trace->checkpointInterval
+        : std::max<std::size_t>(n * n / 8, 64);
+
+    // Records an operation applied to A/b, plus a checkpoint every
+    // checkpointInterval operations.
+    auto pushOp = [&](OperationKind kind, std::size_t k = 0, std::size_t row = 0, double value = 0.0)
     {
         if (!trace)
         {
             return;
         }
 
-        trace->operations.push_back({
-            phase,
-            op,
-            A,
-            b,
-            hasSolveValue,
-            solveIndex,
-            solveValue
-        });
+        trace->operations.push_back({ kind, k, row, value });
+        const std::size_t index = trace->operations.size() - 1;
+        if (trace->checkpoints.empty() || index - trace->checkpoints.back().operation >= checkpointInterval)
+        {
+            trace->checkpoints.push_back({ index, Matrix(A), Vector(b) });
+        }
     };
 
-    auto fmt = [&](double v) -> std::string
+    // Entries only change in eliminated rows, so the largest one seen is
+    // tracked there (only when stats are wanted).
+    double inputMax = 0.0;
+    double largest = 0.0;
+    if (stats)
     {
-        std::ostringstream oss;
-        oss.setf(std::ios::fmtflags(0), std::ios::floatfield);
-        oss << std::setprecision(8) << v;
-        return oss.str();
-    };
+        for (std::size_t i = 0; i < n; i++)
+        {
+            inputMax = std::max(inputMax, rowMaxAbs(A, i, 0));
+        }
+        largest = inputMax;
+    }
 
     if (trace)
     {
         trace->operations.clear();
         trace->forwardSteps.clear();
-        pushOp("forward", "Matrice augmentată inițială");
+        trace->checkpoints.clear();
+        trace->significantDigits = significantDigits;
+        pushOp(OperationKind::Initial);
     }
 
     // Forward elimination with partial pivoting.
     constexpr double pivotEps = 1e-15;
+    Vector x(n);
+    std::size_t done = 0;
     for (std::size_t k = 0; k < n; k++)
     {
+        const SolveStatus status = stop.check();
+        if (status != SolveStatus::Completed)
+        {
+            return { status, x, done };
+        }
+
         // Choose pivot row.
         std::size_t pivotRow = k;
         double maxAbs = std::fabs(A(k, k));
@@ -87,34 +305,15 @@ Vector GaussianElimination::solve(LinearSystem system, int significantDigits, Ga
             throw SingularMatrixException("GaussianElimination::solve: singular matrix (zero pivot)");
         }
 
-        {
-            const std::string op =
-                "Aleg pivot pe coloana " + std::to_string(k + 1) +
-                ": R" + std::to_string(pivotRow + 1);
-            pushOp("forward", op);
-        }
+        pushOp(OperationKind::Pivot, k, pivotRow);
 
         // Swap rows if needed.
         bool swapped = false;
         if (pivotRow != k)
         {
             swapped = true;
-            for (std::size_t j = 0; j < n; j++)
-            {
-                const double tmp = A(k, j);
-                A(k, j) = A(pivotRow, j);
-                A(pivotRow, j) = tmp;
-            }
-            const double tmpB = b[k];
-            b[k] = b[pivotRow];
-            b[pivotRow] = tmpB;
-
-            {
-                const std::string op =
-                    "Schimb linii: R" + std::to_string(k + 1) +
-                    " <-> R" + std::to_string(pivotRow + 1);
-                pushOp("forward", op);
-            }
+            swapRows(A, b, k, pivotRow);
+            pushOp(OperationKind::Swap, k, pivotRow);
         }
 
         const double pivot = A(k, k);
@@ -126,46 +325,36 @@ Vector GaussianElimination::solve(LinearSystem system, int significantDigits, Ga
         for (std::size_t i = k + 1; i < n; i++)
         {
             const double multiplier = r(A(i, k) / pivot);
-
-            // A(i,k) becomes 0 by construction.
-            A(i, k) = 0.0;
-
-            for (std::size_t j = k + 1; j < n; j++)
+            eliminateRow(A, b, i, k, multiplier, significantDigits);
+            pushOp(OperationKind::Eliminate, k, i, multiplier);
+            if (stats)
             {
-                const double product = r(multiplier * A(k, j));
-                A(i, j) = r(A(i, j) - product);
-            }
-
-            const double productB = r(multiplier * b[k]);
-            b[i] = r(b[i] - productB);
-
-            {
-                const std::string op =
-                    "R" + std::to_string(i + 1) +
-                    " <- R" + std::to_string(i + 1) +
-                    " - (" + fmt(multiplier) + ") * R" + std::to_string(k + 1);
-                pushOp("forward", op);
+                largest = std::max(largest, rowMaxAbs(A, i, k + 1));
             }
         }
 
         if (trace)
         {
-            trace->forwardSteps.push_back({
-                k,
-                pivotRow,
-                swapped,
-                A,
-                b
-            });
+            trace->forwardSteps.push_back({ k, pivotRow, swapped, trace->operations.size() - 1 });
         }
+        done++;
     }
 
-    pushOp("forward", "Matrice superior triunghiulară (după eliminare)");
+    pushOp(OperationKind::Eliminated);
+    if (stats)
+    {
+        stats->growthFactor = inputMax > 0.0 ? largest / inputMax : 1.0;
+    }
 
     // Back substitution.
-    Vector x(n);
     for (std::size_t ii = 0; ii < n; ii++)
     {
+        const SolveStatus status = stop.check();
+        if (status != SolveStatus::Completed)
+        {
+            return { status, x, done };
+        }
+
         const std::size_t i = n - 1 - ii;
 
         double sum = 0.0;
@@ -183,15 +372,16 @@ Vector GaussianElimination::solve(LinearSystem system, int significantDigits, Ga
         const double rhs = r(b[i] - sum);
         x[i] = r(rhs / diag);
 
-        {
-            const std::string op =
-                "Substituție înapoi: x" + std::to_string(i + 1) +
-                " = " + fmt(x[i]);
-            pushOp("back", op, true, i, x[i]);
-        }
+        pushOp(OperationKind::BackSubstitution, 0, i, x[i]);
+        done++;
     }
 
-    pushOp("back", "Soluție finală (după substituție înapoi)");
+    pushOp(OperationKind::Final);
 
-    return x;
+    return { SolveStatus::Completed, std::move(x), done };
 }
+
+template BasicVector<double> GaussianElimination::solve<double>(const BasicLinearSystem<double>&);
+template BasicVector<float> GaussianElimination::solve<float>(const BasicLinearSystem<float>&);
+template BasicVector<long double> GaussianElimination::solve<long double>(const BasicLinearSystem<long double>&);
+template BasicVector<std::complex<double>> GaussianElimination::solve<std::complex<double>>(const BasicLinearSystem<std::complex<double>>&);
@@ -0,0 +1,256 @@
+#include "linear/IterativeRefinement.h"
+
+#include "core/Arena.h"
+#include "core/DoubleDouble.h"
+#include "linear/GaussianElimination.h"
+#include "utils/Exceptions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    double normInf(const std::vector<double>& v)
+    {
+        double result = 0.0;
+        for (const double x : v)
+        {
+            result = std::max(result, std::fabs(x));
+        }
+        return result;
+    }
+
+    double matrixNormInf(const Matrix& A)
+    {
+        double result = 0.0;
+        for (std::size_t i = 0; i < A.rowCount(); i++)
+        {
+            const double* row = A.row(i);
+            double sum = 0.0;
+            for (std::size_t j = 0; j < A.colCount(); j++)
+            {
+                sum += std::fabs(row[j]);
+            }
+            result = std::max(result, sum);
+        }
+        return result;
+    }
+
+    void computeResidual(const LinearSystem& system, const std::vector<double>& x, RefinementResidual precision, std::vector<double>& r)
+    {
+        const Matrix& A = system.matrix();
+        const Vector& b = system.rhs();
+        const std::size_t n = x.size();
+        for (std::size_t i = 0; i < n; i++)
+        {
+            const double* row = A.row(i);
+            if (precision == RefinementResidual::DoubleDouble)
+            {
+                DoubleDouble sum = b[i];
+                for (std::size_t j = 0; j < n; j++)
+                {
+                    sum -= DoubleDouble(row[j]) * x[j];
+                }
+                r[i] = static_cast<double>(sum);
+            }
+            else
+            {
+                double sum = 0.0;
+                for (std::size_t j = 0; j < n; j++)
+                {
+                    sum += row[j] * x[j];
+                }
+                r[i] = b[i] - sum;
+            }
+        }
+    }
+
+    bool allFinite(const std::vector<double>& v)
+    {
+        return std::all_of(v.begin(), v.end(), [](double x) { return std::isfinite(x); });
+    }
+
+    // dsgesv's range check: an entry beyond float's range becomes inf in the
+    // float factors, and the float solve is meaningless.
+    bool fitsInFloat(const LinearSystem& system)
+    {
+        const double limit = static_cast<double>(std::numeric_limits<float>::max());
+        const Matrix& A = system.matrix();
+        for (std::size_t i = 0; i < A.rowCount(); i++)
+        {
+            const double* row = A.row(i);
+            for (std::size_t j = 0; j < A.colCount(); j++)
+            {
+                if (!(std::fabs(row[j]) <= limit))
+                {
+                    return false;
+                }
+            }
+        }
+        const Vector& b = system.rhs();
+        for (std::size_t i = 0; i < b.size(); i++)
+        {
+            if (!(std::fabs(b[i]) <= limit))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+IterativeRefinementResult IterativeRefinement::solve(const LinearSystem& system, RefinementResidual residual, std::size_t maxIterations)
+{
+    const std::size_t n = system.size();
+    const Matrix& A = system.matrix();
+    const Vector& b = system.rhs();
+    if (A.rowCount() != n || A.colCount() != n || b.size() != n)
+    {
+        throw DimensionMismatchException("IterativeRefinement::solve: dimension mismatch");
+    }
+
+    const double eps = std::numeric_limits<double>::epsilon();
+    const double aNorm = matrixNormInf(A);
+    const double bNorm = b.normInf();
+    // LAPACK's dsgesv test: ||r|| <= ||x|| ||A|| eps sqrt(n).
+    const double tolerance = aNorm * eps * std::sqrt(static_cast<double>(n));
+
+    IterativeRefinementResult result;
+    std::vector<double> x(n);
+    std::vector<double> r(n);
+    std::vector<float> scaled(n);
+    bool converged = false;
+    // Every acceptance goes through the double residual test, whatever ended
+    // the iteration: a vanishing correction alone also happens at x = 0.
+    auto meetsResidualTest = [&]()
+    {
+        computeResidual(system, x, RefinementResidual::Double, r);
+        return normInf(r) <= tolerance * normInf(x);
+    };
+
+    if (!fitsInFloat(system))
+    {
+        result.reason = "entries outside float range";
+    }
+    else
+    {
+        try
+        {
+            ArenaScope scope;
+            const LUFactors<float, ArenaAllocator<float>> factors = GaussianElimination::factor<float>(A, ArenaAllocator<float>());
+
+            // Corrections are solved for r / ||r|| so that small residuals do not
+            // underflow in float; x itself starts from the float solve of b.
+            auto solveCorrection = [&](const std::vector<double>& rhs, double scale)
+            {
+                for (std::size_t i = 0; i < n; i++)
+                {
+                    scaled[i] = static_cast<float>(rhs[i] / scale);
+                }
+                return GaussianElimination::solveFactored(factors, scaled);
+            };
+
+            std::vector<double> rhs(b.size());
+            for (std::size_t i = 0; i < n; i++)
+            {
+                rhs[i] = b[i];
+            }
+            const double bScale = bNorm > 0.0 ? bNorm : 1.0;
+            const std::vector<float> x0 = solveCorrection(rhs, bScale);
+            for (std::size_t i = 0; i < n; i++)
+            {
+                x[i] = static_cast<double>(x0[i]) * bScale;
+            }
+
+            double previousCorrection = std::numeric_limits<double>::infinity();
+            while (allFinite(x))
+            {
+                computeResidual(system, x, residual, r);
+                const double rNorm = normInf(r);
+                const double xNorm = normInf(x);
+                if (!std::isfinite(rNorm))
+                {
+                    break;
+                }
+                if (residual == RefinementResidual::Double && rNorm <= tolerance * xNorm)
+                {
+                    converged = true;
+                    break;
+                }
+                if (rNorm == 0.0)
+                {
+                    converged = meetsResidualTest();
+                    if (!converged)
+                    {
+                        result.reason = "residual test failed";
+                    }
+                    break;
+                }
+                if (result.iterations == maxIterations)
+                {
+                    result.reason = "no convergence in " + std::to_string(maxIterations) + " refinement steps";
+                    break;
+                }
+
+                const std::vector<float> d = solveCorrection(r, rNorm);
+                double correction = 0.0;
+                for (std::size_t i = 0; i < n; i++)
+                {
+                    const double di = static_cast<double>(d[i]) * rNorm;
+                    x[i] += di;
+                    correction = std::max(correction, std::fabs(di));
+                }
+                result.iterations++;
+
+                if (correction <= eps * normInf(x))
+                {
+                    converged = meetsResidualTest();
+                    if (!converged)
+                    {
+                        result.reason = "correction vanished without a small residual";
+                    }
+                    break;
+                }
+                if (correction > 0.5 * previousCorrection)
+                {
+                    // Stalled: accept x only if it already meets the residual test.
+                    converged = meetsResidualTest();
+                    if (!converged)
+                    {
+                        result.reason = "refinement stalled";
+                    }
+                    break;
+                }
+                previousCorrection = correction;
+            }
+            if (!converged && result.reason.empty())
+            {
+                result.reason = "float solution became non-finite";
+            }
+        }
+        catch (const SingularMatrixException& e)
+        {
+            result.reason = std::string("float factorization failed: ") + e.what();
+        }
+    }
+
+    if (!converged)
+    {
+        result.fellBack = true;
+        x = GaussianElimination::solveAs<double>(system);
+    }
+
+    result.x = Vector(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        result.x[i] = x[i];
+    }
+
+    computeResidual(system, x, RefinementResidual::Double, r);
+    const double denominator = aNorm * normInf(x) + bNorm;
+    result.backwardError = denominator > 0.0 ? normInf(r) / denominator : 0.0;
+    return result;
+}
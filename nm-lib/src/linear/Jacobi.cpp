@@ -1,65 +1,43 @@
 #include "linear/Jacobi.h"
 
-#include "utils/Exceptions.h"
-
-#include <cmath>
-#include <stdexcept>
+#include <utility>
 
 Vector JacobiSolver::iterate(const LinearSystem& system, const Vector& x0, std::size_t iterations, IterativeMethodTrace* trace)
 {
-    const std::size_t n = system.size();
-    const Matrix& A = system.matrix();
-    const Vector& b = system.rhs();
-
-    if (A.rowCount() != n || A.colCount() != n || b.size() != n)
-    {
-        throw DimensionMismatchException("JacobiSolver::iterate: dimension mismatch");
-    }
-    if (x0.size() != n)
-    {
-        throw DimensionMismatchException("JacobiSolver::iterate: x0 dimension mismatch");
-    }
-
-    Vector xPrev = x0;
-    Vector xNext(n);
-
     if (trace)
     {
         trace->steps.clear();
-        trace->steps.push_back({ 0, xPrev });
+        return iterate(system, x0, iterations, *trace);
     }
+    NoTrace none;
+    return iterate(system, x0, iterations, none);
+}
 
-    constexpr double diagEps = 1e-15;
-    for (std::size_t it = 0; it < iterations; it++)
-    {
-        for (std::size_t i = 0; i < n; i++)
-        {
-            const double aii = A(i, i);
-            if (std::fabs(aii) < diagEps)
-            {
-                throw SingularMatrixException("JacobiSolver::iterate: zero diagonal entry");
-            }
-
-            double sum = 0.0;
-            for (std::size_t j = 0; j < n; j++)
-            {
-                if (j == i)
-                {
-                    continue;
-                }
-                sum += A(i, j) * xPrev[j];
-            }
+JacobiStepper::JacobiStepper(const LinearSystem& system, const Vector& x0)
+    : A(system.matrix()), b(system.rhs()), state{ 0, x0 }, next(x0.size())
+{
+    JacobiSolver::validate(system, x0);
+}
 
-            xNext[i] = (b[i] - sum) / aii;
-        }
+bool JacobiStepper::step()
+{
+    JacobiSolver::sweep<double>(A, b, state.x, next);
 
-        xPrev = xNext;
+    std::swap(state.x, next);
+    state.iter++;
+    return true;
+}
 
-        if (trace)
-        {
-            trace->steps.push_back({ it + 1, xPrev });
-        }
-    }
+std::size_t JacobiStepper::iterations() const
+{
+    return state.iter;
+}
 
-    return xPrev;
+const IterativeTraceStep& JacobiStepper::current() const
+{
+    return state;
 }
+
+template BasicVector<float> JacobiSolver::iterate<float>(const BasicLinearSystem<float>&, const BasicVector<float>&, std::size_t);
+template BasicVector<long double> JacobiSolver::iterate<long double>(const BasicLinearSystem<long double>&, const BasicVector<long double>&, std::size_t);
+template BasicVector<std::complex<double>> JacobiSolver::iterate<std::complex<double>>(const BasicLinearSystem<std::complex<double>>&, const BasicVector<std::complex<double>>&, std::size_t);
@@ -1,21 +1,6 @@
 #include "linear/LinearSystem.h"
 
-LinearSystem::LinearSystem(const Matrix& A, const Vector& b)
-    : A(A), b(b)
-{
-}
-
-std::size_t LinearSystem::size() const
-{
-    return b.size();
-}
-
-const Matrix& LinearSystem::matrix() const
-{
-    return A;
-}
-
-const Vector& LinearSystem::rhs() const
-{
-    return b;
-}
+template class BasicLinearSystem<double>;
+template class BasicLinearSystem<float>;
+template class BasicLinearSystem<long double>;
+template class BasicLinearSystem<std::complex<double>>;
@@ -0,0 +1,94 @@
+#include "linear/PrecisionSweep.h"
+
+#include "linear/GaussianElimination.h"
+
+#include "utils/Rounding.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+
+static double residualInf(const LinearSystem& system, const Vector& x)
+{
+    const Matrix& A = system.matrix();
+    const Vector& b = system.rhs();
+
+    long double result = 0.0L;
+    for (std::size_t i = 0; i < b.size(); i++)
+    {
+        const double* row = A.row(i);
+        long double sum = 0.0L;
+        for (std::size_t j = 0; j < x.size(); j++)
+        {
+            sum += static_cast<long double>(row[j]) * x[j];
+        }
+        result = std::max(result, std::fabs(b[i] - sum));
+    }
+    return static_cast<double>(result);
+}
+
+std::vector<PrecisionSweepRow> PrecisionSweep::run(const LinearSystem& system, int minDigits, int maxDigits, ThreadPool& pool)
+{
+    if (minDigits <= 0 || maxDigits < minDigits)
+    {
+        throw std::invalid_argument("PrecisionSweep::run: need 1 <= minDigits <= maxDigits");
+    }
+
+    const std::vector<long double> reference = GaussianElimination::solveAs<long double>(system);
+    long double referenceNorm = 0.0L;
+    for (const long double v : reference)
+    {
+        referenceNorm = std::max(referenceNorm, std::fabs(v));
+    }
+
+    // Builds the rounding tables here rather than inside the first timed solve.
+    roundToSignificantDigits(1.0, 1);
+
+    const std::size_t count = static_cast<std::size_t>(maxDigits - minDigits + 1);
+    std::vector<PrecisionSweepRow> rows(count);
+
+    pool.runBatch(count, [&](std::size_t r)
+    {
+        constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+        PrecisionSweepRow& row = rows[r];
+        row.significantDigits = minDigits + static_cast<int>(r);
+        row.solved = false;
+        row.relativeError = nan;
+        row.residual = nan;
+        row.growthFactor = nan;
+
+        const auto start = std::chrono::steady_clock::now();
+        try
+        {
+            GaussianEliminationStats stats;
+            row.x = GaussianElimination::solve(system, row.significantDigits, StopCondition{}, nullptr, &stats).x;
+            row.growthFactor = stats.growthFactor;
+            row.solved = true;
+        }
+        catch (const std::exception& e)
+        {
+            row.error = e.what();
+        }
+        catch (...)
+        {
+            row.error = "unknown error";
+        }
+        row.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (row.solved)
+        {
+            long double difference = 0.0L;
+            for (std::size_t i = 0; i < reference.size(); i++)
+            {
+                difference = std::max(difference, std::fabs(row.x[i] - reference[i]));
+            }
+            row.relativeError = static_cast<double>(referenceNorm > 0.0L ? difference / referenceNorm : difference);
+            row.residual = residualInf(system, row.x);
+        }
+    });
+
+    return rows;
+}
@@ -0,0 +1,105 @@
+#include "nonlinear/MethodRace.h"
+
+#include "utils/Cancellation.h"
+#include "utils/Exceptions.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <utility>
+
+void MethodRace::add(std::string name, Method method)
+{
+    entries.push_back({ std::move(name), std::move(method) });
+}
+
+std::size_t MethodRace::size() const
+{
+    return entries.size();
+}
+
+std::vector<RaceResult> MethodRace::run(const ScalarEquation& eq, RaceMode mode, ThreadPool& pool, const OnFinished& onFinished) const
+{
+    const std::size_t n = entries.size();
+    std::vector<RaceResult> results(n);
+
+    const CancellationToken token = CancellationToken::create();
+
+    // Every function evaluation checks the token, so a cancelled method stops
+    // at its next iteration without the solvers knowing about the race.
+    const ScalarEquation cancellable([&eq, token](double x)
+    {
+        token.throwIfCancelled("method cancelled: another method converged first");
+        return eq(x);
+    });
+
+    std::atomic<bool> haveWinner(false);
+
+    pool.runBatch(n, [&](std::size_t i)
+    {
+        RaceResult& result = results[i];
+        result.name = entries[i].name;
+        result.x = std::numeric_limits<double>::quiet_NaN();
+        result.winner = false;
+
+        const auto start = std::chrono::steady_clock::now();
+        try
+        {
+            token.throwIfCancelled("method cancelled: another method converged first");
+            result.x = entries[i].method(cancellable);
+            result.status = RaceStatus::Converged;
+            if (mode == RaceMode::FirstToConverge)
+            {
+                bool expected = false;
+                result.winner = haveWinner.compare_exchange_strong(expected, true);
+                token.cancel();
+            }
+        }
+        catch (const OperationCancelledException& e)
+        {
+            result.status = RaceStatus::Cancelled;
+            result.error = e.what();
+        }
+        catch (const std::exception& e)
+        {
+            result.status = RaceStatus::Failed;
+            result.error = e.what();
+        }
+        catch (...)
+        {
+            result.status = RaceStatus::Failed;
+            result.error = "unknown error";
+        }
+        const auto stop = std::chrono::steady_clock::now();
+        result.seconds = std::chrono::duration<double>(stop - start).count();
+
+        if (onFinished)
+        {
+            try
+            {
+                onFinished(i, result);
+            }
+            catch (...)
+            {
+                // The pool must never see an exception; the result is kept as-is.
+            }
+        }
+    });
+
+    return results;
+}
+
+const char* MethodRace::statusName(RaceStatus status)
+{
+    switch (status)
+    {
+    case RaceStatus::Converged:
+        return "converged";
+    case RaceStatus::Failed:
+        return "failed";
+    case RaceStatus::Cancelled:
+        return "cancelled";
+    }
+    return "unknown";
+}
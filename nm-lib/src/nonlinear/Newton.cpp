@@ -1,194 +1,157 @@
 #include "nonlinear/Newton.h"
 
-#include "utils/Exceptions.h"
-
+#include <algorithm>
 #include <cmath>
-#include <limits>
-#include <stdexcept>
+#include <utility>
 
-static bool isFiniteVector(const Vector& v)
+Vector NewtonSolver::solveNewtonStep(const Matrix& jac, const Vector& fx)
 {
-    for (std::size_t i = 0; i < v.size(); i++)
+    const std::size_t n = fx.size();
+    if (jac.rowCount() != n || jac.colCount() != n)
     {
-        if (!std::isfinite(v[i]))
-        {
-            return false;
-        }
+        throw DimensionMismatchException("NewtonSolver: Jacobian dimension mismatch");
     }
-    return true;
-}
 
-static Vector solveLinearSystemGaussianPivot(Matrix A, Vector b)
-{
-    const std::size_t n = b.size();
-    if (A.rowCount() != n || A.colCount() != n)
+    ArenaScope scope;
+    ArenaBuffer<double> rows(n * n);
+    ArenaBuffer<double> rhs(n);
+    ArenaBuffer<double> solution(n);
+    for (std::size_t i = 0; i < n; i++)
     {
-        throw DimensionMismatchException("NewtonSolver: Jacobian dimension mismatch");
+        std::copy(jac.row(i), jac.row(i) + n, rows.begin() + i * n);
+        rhs[i] = -fx[i];
     }
 
-    constexpr double pivotEps = 1e-15;
-
-    for (std::size_t k = 0; k < n; k++)
-    {
-        std::size_t pivotRow = k;
-        double maxAbs = std::fabs(A(k, k));
-        for (std::size_t i = k + 1; i < n; i++)
-        {
-            const double candidate = std::fabs(A(i, k));
-            if (candidate > maxAbs)
-            {
-                maxAbs = candidate;
-                pivotRow = i;
-            }
-        }
-
-        if (maxAbs < pivotEps)
-        {
-            throw SingularMatrixException("NewtonSolver: singular Jacobian (zero pivot)");
-        }
-
-        if (pivotRow != k)
-        {
-            for (std::size_t j = 0; j < n; j++)
-            {
-                const double tmp = A(k, j);
-                A(k, j) = A(pivotRow, j);
-                A(pivotRow, j) = tmp;
-            }
-
-            const double tmpB = b[k];
-            b[k] = b[pivotRow];
-            b[pivotRow] = tmpB;
-        }
-
-        const double pivot = A(k, k);
-        if (std::fabs(pivot) < pivotEps)
-        {
-            throw SingularMatrixException("NewtonSolver: singular Jacobian (pivot too small)");
-        }
-
-        for (std::size_t i = k + 1; i < n; i++)
-        {
-            const double m = A(i, k) / pivot;
-            A(i, k) = 0.0;
-            for (std::size_t j = k + 1; j < n; j++)
-            {
-                A(i, j) -= m * A(k, j);
-            }
-            b[i] -= m * b[k];
-        }
-    }
-
-    Vector x(n);
-    for (std::size_t ii = 0; ii < n; ii++)
-    {
-        const std::size_t i = n - 1 - ii;
-        double sum = 0.0;
-        for (std::size_t j = i + 1; j < n; j++)
-        {
-            sum += A(i, j) * x[j];
-        }
-
-        const double diag = A(i, i);
-        if (std::fabs(diag) < pivotEps)
-        {
-            throw SingularMatrixException("NewtonSolver: singular Jacobian during back substitution");
-        }
-
-        x[i] = (b[i] - sum) / diag;
+    solveLinearSystemGaussianPivot<double>(rows.data(), rhs.data(), solution.data(), n);
+    Vector delta(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        delta[i] = solution[i];
     }
-
-    return x;
+    return delta;
 }
 
 Vector NewtonSolver::solve(const NonlinearSystem& system, Vector x0, double eps, NewtonSystemTrace* trace)
+{
+    if (trace)
+    {
+        trace->steps.clear();
+        return solve(system, std::move(x0), eps, *trace);
+    }
+    NoTrace none;
+    return solve(system, std::move(x0), eps, none);
+}
+
+NewtonSystemStepper::NewtonSystemStepper(const NonlinearSystem& system, Vector x0, double eps)
+    : system(system), eps(eps), x(std::move(x0)), state{ 0, Vector(0), Vector(0), Matrix(0, 0), Vector(0) }
 {
     if (eps <= 0.0)
     {
         throw std::invalid_argument("NewtonSolver::solve: eps must be positive");
     }
-    if (x0.size() == 0)
+    if (x.size() == 0)
     {
         throw std::invalid_argument("NewtonSolver::solve: x0 must be non-empty");
     }
-    if (!isFiniteVector(x0))
+    if (!NewtonSolver::isFiniteVector(x))
     {
         throw std::invalid_argument("NewtonSolver::solve: x0 contains non-finite values");
     }
+}
+
+bool NewtonSystemStepper::step()
+{
+    if (failed)
+    {
+        throw NonConvergenceException("NewtonSolver::solve: iterate became non-finite");
+    }
+    if (finished)
+    {
+        return false;
+    }
+    if (iter == maxIterations)
+    {
+        throw NonConvergenceException("NewtonSolver::solve: maximum iterations reached");
+    }
 
-    Vector x = x0;
-    constexpr std::size_t maxIterations = 100;
+    Vector fx = system.evaluate(x);
+    if (fx.size() != x.size())
+    {
+        throw DimensionMismatchException("NewtonSolver::solve: F(x) dimension mismatch");
+    }
+    if (!NewtonSolver::isFiniteVector(fx))
+    {
+        throw NonConvergenceException("NewtonSolver::solve: F(x) became non-finite");
+    }
 
-    if (trace)
+    const double fxNorm = fx.normInf();
+    if (fxNorm <= eps)
     {
-        trace->steps.clear();
+        finished = true;
+        return false;
     }
 
-    for (std::size_t iter = 0; iter < maxIterations; iter++)
-    {
-        Vector fx = system.evaluate(x);
-        if (fx.size() != x.size())
-        {
-            throw DimensionMismatchException("NewtonSolver::solve: F(x) dimension mismatch");
-        }
-        if (!isFiniteVector(fx))
-        {
-            throw NonConvergenceException("NewtonSolver::solve: F(x) became non-finite");
-        }
-
-        const double fxNorm = fx.normInf();
-        if (fxNorm <= eps)
-        {
-            return x;
-        }
-
-        Matrix jac = system.jacobian(x);
-        if (jac.rowCount() != x.size() || jac.colCount() != x.size())
-        {
-            throw DimensionMismatchException("NewtonSolver::solve: J(x) dimension mismatch");
-        }
-
-        // Solve J(x) * delta = -F(x)
-        Vector rhs(x.size());
-        for (std::size_t i = 0; i < x.size(); i++)
-        {
-            rhs[i] = -fx[i];
-        }
-
-        Vector delta = solveLinearSystemGaussianPivot(jac, rhs);
-        if (!isFiniteVector(delta))
-        {
-            throw NonConvergenceException("NewtonSolver::solve: update became non-finite");
-        }
-
-        if (trace)
-        {
-            trace->steps.push_back({
-                iter,
-                x,
-                fx,
-                jac,
-                delta
-            });
-        }
-
-        for (std::size_t i = 0; i < x.size(); i++)
-        {
-            x[i] += delta[i];
-        }
-        if (!isFiniteVector(x))
-        {
-            throw NonConvergenceException("NewtonSolver::solve: iterate became non-finite");
-        }
-
-        // Course-style stop: small step (absolute or relative).
-        const double xNorm = x.normInf();
-        const double denom = (xNorm > 1.0) ? xNorm : 1.0;
-        if (delta.normInf() / denom <= eps)
-        {
-            return x;
-        }
-    }
-
-    throw NonConvergenceException("NewtonSolver::solve: maximum iterations reached");
+    Matrix jac = system.jacobian(x);
+    if (jac.rowCount() != x.size() || jac.colCount() != x.size())
+    {
+        throw DimensionMismatchException("NewtonSolver::solve: J(x) dimension mismatch");
+    }
+
+    // Solve J(x) * delta = -F(x)
+    Vector delta = NewtonSolver::solveNewtonStep(jac, fx);
+    if (!NewtonSolver::isFiniteVector(delta))
+    {
+        throw NonConvergenceException("NewtonSolver::solve: update became non-finite");
+    }
+
+    state = NewtonSystemTraceStep{ iter, x, std::move(fx), std::move(jac), delta };
+    iter++;
+
+    for (std::size_t i = 0; i < x.size(); i++)
+    {
+        x[i] += delta[i];
+    }
+    if (!NewtonSolver::isFiniteVector(x))
+    {
+        failed = true;
+        return true;
+    }
+
+    // Course-style stop: small step (absolute or relative).
+    const double xNorm = x.normInf();
+    const double denom = (xNorm > 1.0) ? xNorm : 1.0;
+    if (delta.normInf() / denom <= eps)
+    {
+        finished = true;
+    }
+    return true;
 }
+
+bool NewtonSystemStepper::done() const
+{
+    return finished;
+}
+
+std::size_t NewtonSystemStepper::iterations() const
+{
+    return iter;
+}
+
+const NewtonSystemTraceStep& NewtonSystemStepper::current() const
+{
+    return state;
+}
+
+const Vector& NewtonSystemStepper::root() const
+{
+    return x;
+}
+
+NewtonSystemTraceStep NewtonSystemStepper::releaseCurrent()
+{
+    return std::move(state);
+}
+
+template BasicVector<float> NewtonSolver::solve<float>(const BasicNonlinearSystem<float>&, const BasicVector<float>&, double);
+template BasicVector<long double> NewtonSolver::solve<long double>(const BasicNonlinearSystem<long double>&, const BasicVector<long double>&, double);
+template BasicVector<std::complex<double>> NewtonSolver::solve<std::complex<double>>(const BasicNonlinearSystem<std::complex<double>>&, const BasicVector<std::complex<double>>&, double);
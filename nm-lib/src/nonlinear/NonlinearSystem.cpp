@@ -1,18 +1,6 @@
 #include "nonlinear/NonlinearSystem.h"
 
-#include <utility>
-
-NonlinearSystem::NonlinearSystem(VectorFunction F, JacobianFunction J)
-    : F(std::move(F)), J(std::move(J))
-{
-}
-
-Vector NonlinearSystem::evaluate(const Vector& x) const
-{
-    return F(x);
-}
-
-Matrix NonlinearSystem::jacobian(const Vector& x) const
-{
-    return J(x);
-}
+template class BasicNonlinearSystem<double>;
+template class BasicNonlinearSystem<float>;
+template class BasicNonlinearSystem<long double>;
+template class BasicNonlinearSystem<std::complex<double>>;
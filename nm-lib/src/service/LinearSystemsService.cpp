@@ -0,0 +1,474 @@
+#include "service/LinearSystemsService.h"
+
+#include "linear/GaussSeidel.h"
+#include "linear/GaussianElimination.h"
+#include "linear/Jacobi.h"
+#include "linear/PrecisionSweep.h"
+
+#include "utils/JsonUtils.h"
+#include "utils/ThreadPool.h"
+#include "utils/TraceSink.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+static double residualInf(const Matrix& A, const Vector& x, const Vector& b)
+{
+    const std::size_t n = b.size();
+    double maxAbs = 0.0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        double s = 0.0;
+        for (std::size_t j = 0; j < n; j++)
+        {
+            s += A(i, j) * x[j];
+        }
+        const double ri = s - b[i];
+        const double ai = std::fabs(ri);
+        if (ai > maxAbs)
+        {
+            maxAbs = ai;
+        }
+    }
+    return maxAbs;
+}
+
+static LinearSystem gaussSystem1()
+{
+    Matrix A(3, 3);
+    Vector b(3);
+
+    A(0, 0) = 3.03;
+    A(0, 1) = -12.1;
+    A(0, 2) = 14.0;
+    b[0] = -119.0;
+
+    A(1, 0) = -3.03;
+    A(1, 1) = 12.1;
+    A(1, 2) = -7.0;
+    b[1] = 120.0;
+
+    A(2, 0) = 6.11;
+    A(2, 1) = -14.2;
+    A(2, 2) = 21.0;
+    b[2] = -139.0;
+
+    return LinearSystem(A, b);
+}
+
+static LinearSystem gaussSystem2()
+{
+    Matrix A(3, 3);
+    Vector b(3);
+
+    A(0, 0) = 3.333;
+    A(0, 1) = 15920.0;
+    A(0, 2) = 10.333;
+    b[0] = 7953.0;
+
+    A(1, 0) = 2.222;
+    A(1, 1) = 16.71;
+    A(1, 2) = 9.612;
+    b[1] = 0.965;
+
+    A(2, 0) = -1.5611;
+    A(2, 1) = 5.1792;
+    A(2, 2) = -1.6855;
+    b[2] = 2714.0;
+
+    return LinearSystem(A, b);
+}
+
+static LinearSystem gaussSystem3()
+{
+    Matrix A(4, 4);
+    Vector b(4);
+
+    A(0, 0) = 2.12;
+    A(0, 1) = -2.12;
+    A(0, 2) = 51.3;
+    A(0, 3) = 100.0;
+    b[0] = 3.14159265358979323846;
+
+    A(1, 0) = 0.333;
+    A(1, 1) = -0.333;
+    A(1, 2) = -12.2;
+    A(1, 3) = 19.7;
+    b[1] = std::sqrt(2.0);
+
+    A(2, 0) = 6.19;
+    A(2, 1) = 8.20;
+    A(2, 2) = -1.0;
+    A(2, 3) = -2.01;
+    b[2] = 0.0;
+
+    A(3, 0) = -5.73;
+    A(3, 1) = 6.12;
+    A(3, 2) = 1.0;
+    A(3, 3) = -1.0;
+    b[3] = -1.0;
+
+    return LinearSystem(A, b);
+}
+
+static LinearSystem gaussSystem4()
+{
+    Matrix A(4, 4);
+    Vector b(4);
+
+    const double pi = 3.14159265358979323846;
+    A(0, 0) = pi;
+    A(0, 1) = std::sqrt(2.0);
+    A(0, 2) = -1.0;
+    A(0, 3) = 1.0;
+    b[0] = 0.0;
+
+    A(1, 0) = std::exp(1.0);
+    A(1, 1) = -1.0;
+    A(1, 2) = 1.0;
+    A(1, 3) = 2.0;
+    b[1] = 1.0;
+
+    A(2, 0) = 1.0;
+    A(2, 1) = 1.0;
+    A(2, 2) = -std::sqrt(3.0);
+    A(2, 3) = 1.0;
+    b[2] = 2.0;
+
+    A(3, 0) = -1.0;
+    A(3, 1) = -1.0;
+    A(3, 2) = 1.0;
+    A(3, 3) = -std::sqrt(5.0);
+    b[3] = 3.0;
+
+    return LinearSystem(A, b);
+}
+
+static LinearSystem iterativeSystem1()
+{
+    // 5x5
+    Matrix A(5, 5);
+    Vector b(5);
+
+    A(0, 0) = 4;  A(0, 1) = 1;  A(0, 2) = 1;  A(0, 3) = 0;  A(0, 4) = 1;  b[0] = 6;
+    A(1, 0) = -1; A(1, 1) = -3; A(1, 2) = 1;  A(1, 3) = 1;  A(1, 4) = 0;  b[1] = 6;
+    A(2, 0) = 2;  A(2, 1) = 1;  A(2, 2) = 5;  A(2, 3) = -1; A(2, 4) = -1; b[2] = 6;
+    A(3, 0) = -1; A(3, 1) = -1; A(3, 2) = -1; A(3, 3) = 4;  A(3, 4) = 0;  b[3] = 6;
+    A(4, 0) = 0;  A(4, 1) = 2;  A(4, 2) = -1; A(4, 3) = 1;  A(4, 4) = 4;  b[4] = 6;
+
+    return LinearSystem(A, b);
+}
+
+static LinearSystem iterativeSystem2()
+{
+    // 6x6
+    Matrix A(6, 6);
+    Vector b(6);
+
+    A(0, 0) = 4;  A(0, 1) = -1; A(0, 2) = 0;  A(0, 3) = -1; A(0, 4) = 0;  A(0, 5) = 0;  b[0] = 0;
+    A(1, 0) = -1; A(1, 1) = 4;  A(1, 2) = -1; A(1, 3) = 0;  A(1, 4) = -1; A(1, 5) = 0;  b[1] = 5;
+    A(2, 0) = 0;  A(2, 1) = -1; A(2, 2) = 4;  A(2, 3) = 0;  A(2, 4) = 0;  A(2, 5) = -1; b[2] = 0;
+    A(3, 0) = -1; A(3, 1) = 0;  A(3, 2) = 0;  A(3, 3) = 4;  A(3, 4) = -1; A(3, 5) = 0;  b[3] = 6;
+    A(4, 0) = 0;  A(4, 1) = -1; A(4, 2) = 0;  A(4, 3) = -1; A(4, 4) = 4;  A(4, 5) = -1; b[4] = -2;
+    A(5, 0) = 0;  A(5, 1) = 0;  A(5, 2) = -1; A(5, 3) = 0;  A(5, 4) = -1; A(5, 5) = 4;  b[5] = 6;
+
+    return LinearSystem(A, b);
+}
+
+static LinearSystem iterativeSystem3()
+{
+    // 4x4 (tridiagonal-ish)
+    Matrix A(4, 4);
+    Vector b(4);
+
+    A(0, 0) = 10; A(0, 1) = 5;  A(0, 2) = 0;  A(0, 3) = 0;  b[0] = 6;
+    A(1, 0) = 5;  A(1, 1) = 10; A(1, 2) = -4; A(1, 3) = 0;  b[1] = 25;
+    A(2, 0) = 0;  A(2, 1) = -4; A(2, 2) = 8;  A(2, 3) = -1; b[2] = -11;
+    A(3, 0) = 0;  A(3, 1) = 0;  A(3, 2) = -1; A(3, 3) = 5;  b[3] = -11;
+
+    return LinearSystem(A, b);
+}
+
+static LinearSystem iterativeSystem4()
+{
+    // 4x4
+    Matrix A(4, 4);
+    Vector b(4);
+
+    A(0, 0) = 4;  A(0, 1) = 1;  A(0, 2) = -1; A(0, 3) = 1;  b[0] = -2;
+    A(1, 0) = 1;  A(1, 1) = 4;  A(1, 2) = -1; A(1, 3) = -1; b[1] = -1;
+    A(2, 0) = -1; A(2, 1) = -1; A(2, 2) = 5;  A(2, 3) = 1;  b[2] = 0;
+    A(3, 0) = 1;  A(3, 1) = -1; A(3, 2) = 1;  A(3, 3) = 3;  b[3] = 1;
+
+    return LinearSystem(A, b);
+}
+
+LinearSystem LinearSystemsService::gaussSystem(int which)
+{
+    switch (which)
+    {
+    case 1:
+        return gaussSystem1();
+    case 2:
+        return gaussSystem2();
+    case 3:
+        return gaussSystem3();
+    case 4:
+        return gaussSystem4();
+    }
+    throw std::invalid_argument("Invalid system. Use 1-4.");
+}
+
+LinearSystem LinearSystemsService::iterativeSystem(int which)
+{
+    switch (which)
+    {
+    case 1:
+        return iterativeSystem1();
+    case 2:
+        return iterativeSystem2();
+    case 3:
+        return iterativeSystem3();
+    case 4:
+        return iterativeSystem4();
+    }
+    throw std::invalid_argument("Invalid system. Use 1-4.");
+}
+
+void LinearSystemsService::solveGauss(const GaussRequest& request, JsonWriter& w)
+{
+    const LinearSystem sys = gaussSystem(request.system);
+    const int significantDigits = request.significantDigits;
+
+    w.beginObject();
+    w.field("kind", "gauss");
+    w.field("referat", "01");
+    w.field("system", request.system);
+    w.field("significantDigits", significantDigits);
+    w.key("A");
+    writeMatrix(w, sys.matrix());
+    w.key("b");
+    writeVector(w, sys.rhs());
+    w.field("traceEnabled", request.trace);
+
+    Vector x(sys.size());
+    if (request.trace)
+    {
+        // The trace keeps only what each operation changed; the matrices of
+        // both step lists are rebuilt by a replay cursor while writing.
+        GaussianEliminationTrace trace;
+        x = GaussianElimination::solve(sys, significantDigits, &trace);
+        GaussianEliminationReplay replay(trace);
+
+        w.key("trace");
+        w.beginObject();
+
+        w.key("forwardElimination");
+        w.beginArray();
+        for (const GaussianEliminationTraceStep& s : trace.forwardSteps)
+        {
+            replay.seek(s.operation);
+            w.beginObject();
+            w.field("k", s.k);
+            w.field("pivotRow", s.pivotRow);
+            w.field("swapped", s.swapped);
+            w.key("A");
+            writeMatrix(w, replay.matrix());
+            w.key("b");
+            writeVector(w, replay.rhs());
+            w.endObject();
+        }
+        w.endArray();
+
+        w.key("operations");
+        w.beginArray();
+        for (std::size_t i = 0; i < trace.operations.size(); i++)
+        {
+            const GaussianEliminationTrace::OperationStep& op = trace.operations[i];
+            replay.seek(i);
+            w.beginObject();
+            w.field("phase", op.phase());
+            w.field("op", op.label());
+            w.key("A");
+            writeMatrix(w, replay.matrix());
+            w.key("b");
+            writeVector(w, replay.rhs());
+            w.field("hasSolveValue", op.hasSolveValue());
+            w.field("solveIndex", op.solveIndex());
+            w.field("solveValue", op.solveValue());
+            w.endObject();
+        }
+        w.endArray();
+
+        w.endObject();
+    }
+    else
+    {
+        x = GaussianElimination::solve(sys, significantDigits);
+    }
+
+    w.key("x");
+    writeVector(w, x);
+    w.field("residual_inf", residualInf(sys.matrix(), x, sys.rhs()));
+    w.endObject();
+}
+
+void LinearSystemsService::sweepGauss(const GaussSweepRequest& request, JsonWriter& w)
+{
+    const LinearSystem sys = gaussSystem(request.system);
+    const std::size_t precisions = static_cast<std::size_t>(std::max(1, request.maxDigits - request.minDigits + 1));
+    const std::size_t wanted = request.threads > 0 ? request.threads : ThreadPool::defaultThreadCount();
+    ThreadPool pool(std::min(wanted, precisions));
+    const std::vector<PrecisionSweepRow> rows = PrecisionSweep::run(sys, request.minDigits, request.maxDigits, pool);
+
+    w.beginObject();
+    w.field("kind", "gauss_sweep");
+    w.field("referat", "01");
+    w.field("system", request.system);
+    w.field("minDigits", request.minDigits);
+    w.field("maxDigits", request.maxDigits);
+    w.field("threads", pool.size());
+    w.key("A");
+    writeMatrix(w, sys.matrix());
+    w.key("b");
+    writeVector(w, sys.rhs());
+
+    w.key("rows");
+    w.beginArray();
+    for (const PrecisionSweepRow& row : rows)
+    {
+        w.beginObject();
+        w.field("significantDigits", row.significantDigits);
+        w.field("solved", row.solved);
+        if (row.solved)
+        {
+            w.key("x");
+            writeVector(w, row.x);
+        }
+        else
+        {
+            w.field("error", row.error);
+        }
+        w.field("relativeError", row.relativeError);
+        w.field("residual_inf", row.residual);
+        w.field("growthFactor", row.growthFactor);
+        w.field("seconds", row.seconds);
+        w.endObject();
+    }
+    w.endArray();
+    w.endObject();
+}
+
+void LinearSystemsService::solveIterative(const IterativeRequest& request, JsonWriter& w)
+{
+    const LinearSystem sys = iterativeSystem(request.system);
+    const std::size_t iterations = request.iterations;
+    const Vector x0(sys.size());
+
+    w.beginObject();
+    w.field("kind", "iterative");
+    w.field("referat", "01");
+    w.field("system", request.system);
+    w.field("iterations", iterations);
+    w.key("A");
+    writeMatrix(w, sys.matrix());
+    w.key("b");
+    writeVector(w, sys.rhs());
+    w.key("x0");
+    writeVector(w, x0);
+    w.field("traceEnabled", request.trace);
+
+    // Each method's iterates are written while it runs.
+    auto writeMethod = [&](const char* name, auto iterate) {
+        w.beginObject();
+        w.field("name", name);
+        Vector x(sys.size());
+        if (request.trace)
+        {
+            auto sink = streamTo([&](const IterativeTraceStep& s) {
+                w.beginObject();
+                w.field("iter", s.iter);
+                w.key("x");
+                writeVector(w, s.x);
+                w.endObject();
+            });
+            w.key("trace");
+            w.beginArray();
+            x = iterate(sink);
+            w.endArray();
+        }
+        else
+        {
+            NoTrace none;
+            x = iterate(none);
+        }
+        w.key("x");
+        writeVector(w, x);
+        w.field("residual_inf", residualInf(sys.matrix(), x, sys.rhs()));
+        w.endObject();
+    };
+
+    w.key("methods");
+    w.beginArray();
+    writeMethod("jacobi", [&](auto& sink) { return JacobiSolver::iterate(sys, x0, iterations, sink); });
+    writeMethod("gaussSeidel", [&](auto& sink) { return GaussSeidelSolver::iterate(sys, x0, iterations, sink); });
+    w.endArray();
+    w.endObject();
+}
+
+static int systemOf(const nlohmann::json& params)
+{
+    const auto system = optionalNumber(params, "system");
+    if (!system)
+    {
+        return 1;
+    }
+    if (!(*system >= 1.0 && *system <= 4.0) || *system != std::floor(*system))
+    {
+        throw std::invalid_argument("Invalid system. Use 1-4.");
+    }
+    return static_cast<int>(*system);
+}
+
+GaussRequest LinearSystemsService::parseGaussRequest(const nlohmann::json& params)
+{
+    if (!params.is_object())
+    {
+        throw std::invalid_argument("Invalid request. Expected a JSON object.");
+    }
+
+    GaussRequest request;
+    request.system = systemOf(params);
+    request.trace = optionalBool(params, "trace", request.trace);
+    if (const auto digits = optionalNumber(params, "significantDigits"))
+    {
+        if (!(*digits >= 1.0 && *digits <= 17.0))
+        {
+            throw std::invalid_argument("Invalid significantDigits. Use 1..17.");
+        }
+        request.significantDigits = static_cast<int>(*digits);
+    }
+    return request;
+}
+
+IterativeRequest LinearSystemsService::parseIterativeRequest(const nlohmann::json& params)
+{
+    if (!params.is_object())
+    {
+        throw std::invalid_argument("Invalid request. Expected a JSON object.");
+    }
+
+    IterativeRequest request;
+    request.system = systemOf(params);
+    request.trace = optionalBool(params, "trace", request.trace);
+    if (const auto iterations = optionalNumber(params, "iterations"))
+    {
+        if (!(*iterations >= 0.0 && *iterations <= 1e7))
+        {
+            throw std::invalid_argument("Invalid iterations. Use 0..1e7.");
+        }
+        request.iterations = static_cast<std::size_t>(*iterations);
+    }
+    return request;
+}
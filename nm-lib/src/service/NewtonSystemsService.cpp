@@ -0,0 +1,279 @@
+#include "service/NewtonSystemsService.h"
+
+#include "nonlinear/Newton.h"
+
+#include "utils/JsonUtils.h"
+#include "utils/TraceSink.h"
+
+#include <cmath>
+#include <stdexcept>
+
+static NonlinearSystem system1()
+{
+    // Referat 02 — Tema 2 — (1)
+    // f1 = x1 + 2 x2^2 - x2 - 2 x3 = 0
+    // f2 = x2 - 8 x2^2 + 10 x3 = 0
+    // f3 = x2 (7 x2 x3)^{-1} - 1 = 0  => (for x2 != 0) 1/(7 x3) - 1 = 0
+    VectorFunction F = [](const Vector& x) {
+        Vector fx(3);
+        const double x1 = x[0];
+        const double x2 = x[1];
+        const double x3 = x[2];
+
+        fx[0] = x1 + 2.0 * x2 * x2 - x2 - 2.0 * x3;
+        fx[1] = x2 - 8.0 * x2 * x2 + 10.0 * x3;
+        fx[2] = (1.0 / (7.0 * x3)) - 1.0;
+        return fx;
+    };
+
+    JacobianFunction J = [](const Vector& x) {
+        Matrix jac(3, 3);
+        const double x2 = x[1];
+        const double x3 = x[2];
+
+        jac(0, 0) = 1.0;
+        jac(0, 1) = 4.0 * x2 - 1.0;
+        jac(0, 2) = -2.0;
+
+        jac(1, 0) = 0.0;
+        jac(1, 1) = 1.0 - 16.0 * x2;
+        jac(1, 2) = 10.0;
+
+        jac(2, 0) = 0.0;
+        jac(2, 1) = 0.0;
+        jac(2, 2) = -(1.0 / (7.0 * x3 * x3));
+
+        return jac;
+    };
+
+    return NonlinearSystem(F, J);
+}
+
+static NonlinearSystem system2()
+{
+    // (2)
+    // f1 = x1^2 + x2 - 37 = 0
+    // f2 = x1 - x2^2 - 5 = 0
+    // f3 = x1 + x2 + x3 - 3 = 0
+    VectorFunction F = [](const Vector& x) {
+        Vector fx(3);
+        const double x1 = x[0];
+        const double x2 = x[1];
+        const double x3 = x[2];
+        fx[0] = x1 * x1 + x2 - 37.0;
+        fx[1] = x1 - x2 * x2 - 5.0;
+        fx[2] = x1 + x2 + x3 - 3.0;
+        return fx;
+    };
+
+    JacobianFunction J = [](const Vector& x) {
+        Matrix jac(3, 3);
+        const double x1 = x[0];
+        const double x2 = x[1];
+
+        jac(0, 0) = 2.0 * x1;
+        jac(0, 1) = 1.0;
+        jac(0, 2) = 0.0;
+
+        jac(1, 0) = 1.0;
+        jac(1, 1) = -2.0 * x2;
+        jac(1, 2) = 0.0;
+
+        jac(2, 0) = 1.0;
+        jac(2, 1) = 1.0;
+        jac(2, 2) = 1.0;
+
+        return jac;
+    };
+
+    return NonlinearSystem(F, J);
+}
+
+static NonlinearSystem system3()
+{
+    // (3)
+    // f1 = x1^2 + x2^2 - x1 = 0
+    // f2 = x1^2 - x2^2 - x2 = 0
+    VectorFunction F = [](const Vector& x) {
+        Vector fx(2);
+        const double x1 = x[0];
+        const double x2 = x[1];
+        fx[0] = x1 * x1 + x2 * x2 - x1;
+        fx[1] = x1 * x1 - x2 * x2 - x2;
+        return fx;
+    };
+
+    JacobianFunction J = [](const Vector& x) {
+        Matrix jac(2, 2);
+        const double x1 = x[0];
+        const double x2 = x[1];
+
+        jac(0, 0) = 2.0 * x1 - 1.0;
+        jac(0, 1) = 2.0 * x2;
+
+        jac(1, 0) = 2.0 * x1;
+        jac(1, 1) = -2.0 * x2 - 1.0;
+
+        return jac;
+    };
+
+    return NonlinearSystem(F, J);
+}
+
+static NonlinearSystem system4()
+{
+    // (4)
+    // f1 = 3x1^2 - x2^2 = 0
+    // f2 = 3x1 x2^2 - x1^3 - 1 = 0
+    VectorFunction F = [](const Vector& x) {
+        Vector fx(2);
+        const double x1 = x[0];
+        const double x2 = x[1];
+        fx[0] = 3.0 * x1 * x1 - x2 * x2;
+        fx[1] = 3.0 * x1 * x2 * x2 - x1 * x1 * x1 - 1.0;
+        return fx;
+    };
+
+    JacobianFunction J = [](const Vector& x) {
+        Matrix jac(2, 2);
+        const double x1 = x[0];
+        const double x2 = x[1];
+
+        jac(0, 0) = 6.0 * x1;
+        jac(0, 1) = -2.0 * x2;
+
+        jac(1, 0) = 3.0 * x2 * x2 - 3.0 * x1 * x1;
+        jac(1, 1) = 6.0 * x1 * x2;
+
+        return jac;
+    };
+
+    return NonlinearSystem(F, J);
+}
+
+NewtonSystemProblem NewtonSystemsService::problem(int which)
+{
+    if (which == 1)
+    {
+        return {
+            1,
+            "x1 + 2x2^2 - x2 - 2x3 = 0;  x2 - 8x2^2 + 10x3 = 0;  1/(7x3) - 1 = 0",
+            system1(),
+            Vector{ 0.3, 0.5, 0.14 }
+        };
+    }
+    if (which == 2)
+    {
+        return {
+            2,
+            "x1^2 + x2 - 37 = 0;  x1 - x2^2 - 5 = 0;  x1 + x2 + x3 - 3 = 0",
+            system2(),
+            Vector{ 6.0, 6.0, -9.0 }
+        };
+    }
+    if (which == 3)
+    {
+        return {
+            3,
+            "x1^2 + x2^2 - x1 = 0;  x1^2 - x2^2 - x2 = 0",
+            system3(),
+            Vector{ 0.5, 0.5 }
+        };
+    }
+    if (which == 4)
+    {
+        return {
+            4,
+            "3x1^2 - x2^2 = 0;  3x1 x2^2 - x1^3 - 1 = 0",
+            system4(),
+            Vector{ 1.0, 2.0 }
+        };
+    }
+
+    throw std::invalid_argument("Invalid system. Use 1, 2, 3, or 4.");
+}
+
+void NewtonSystemsService::solve(const NewtonSystemRequest& request, JsonWriter& w)
+{
+    const NewtonSystemProblem p = problem(request.system);
+    const NonlinearSystem& sys = p.system;
+    const Vector& x0 = p.x0;
+    const std::string& statement = p.statement;
+    const double eps = request.eps;
+
+    w.beginObject();
+    w.field("kind", "newton_systems");
+    w.field("referat", "02");
+    w.field("system", request.system);
+    w.field("eps", eps);
+    w.field("statement", statement);
+    w.key("x0");
+    writeVector(w, x0);
+    w.field("traceEnabled", request.trace);
+
+    Vector x(x0.size());
+    if (request.trace)
+    {
+        // Iterations are written while the solver runs.
+        auto sink = streamTo([&](const NewtonSystemTraceStep& s) {
+            w.beginObject();
+            w.field("iter", s.iter);
+            w.key("x");
+            writeVector(w, s.x);
+            w.key("fx");
+            writeVector(w, s.fx);
+            w.key("jac");
+            writeMatrix(w, s.jac);
+            w.key("delta");
+            writeVector(w, s.delta);
+            w.endObject();
+        });
+        w.key("trace");
+        w.beginObject();
+        w.key("iterations");
+        w.beginArray();
+        x = NewtonSolver::solve(sys, x0, eps, sink);
+        w.endArray();
+        w.endObject();
+    }
+    else
+    {
+        x = NewtonSolver::solve(sys, x0, eps);
+    }
+
+    const Vector fx = sys.evaluate(x);
+    w.key("x");
+    writeVector(w, x);
+    w.key("fx");
+    writeVector(w, fx);
+    w.field("residual_inf", fx.normInf());
+    w.endObject();
+}
+
+NewtonSystemRequest NewtonSystemsService::parseRequest(const nlohmann::json& params)
+{
+    if (!params.is_object())
+    {
+        throw std::invalid_argument("Invalid request. Expected a JSON object.");
+    }
+
+    NewtonSystemRequest request;
+    if (const auto system = optionalNumber(params, "system"))
+    {
+        if (!(*system >= 1.0 && *system <= 4.0) || *system != std::floor(*system))
+        {
+            throw std::invalid_argument("Invalid system. Use 1, 2, 3, or 4.");
+        }
+        request.system = static_cast<int>(*system);
+    }
+    request.trace = optionalBool(params, "trace", request.trace);
+    if (const auto eps = optionalNumber(params, "eps"))
+    {
+        if (!(*eps > 0.0))
+        {
+            throw std::invalid_argument("Invalid eps. Must be a finite positive number.");
+        }
+        request.eps = *eps;
+    }
+    return request;
+}
@@ -0,0 +1,863 @@
+#include "service/RootFindingService.h"
+
+#include "nonlinear/MethodRace.h"
+
+#include "utils/JsonUtils.h"
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <initializer_list>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+// bisection, regula falsi, secant, Newton: the most workers a concurrent mode can use.
+static constexpr std::size_t kMethodCount = 4;
+
+static void writeStep(JsonWriter& w, const BisectionTraceStep& s)
+{
+    w.beginObject();
+    w.field("iter", s.iter);
+    w.field("a", s.a);
+    w.field("b", s.b);
+    w.field("p", s.p);
+    w.field("fp", s.fp);
+    w.field("errorBound", s.errorBound);
+    w.endObject();
+}
+
+static void writeStep(JsonWriter& w, const RegulaFalsiTraceStep& s)
+{
+    w.beginObject();
+    w.field("iter", s.iter);
+    w.field("a", s.a);
+    w.field("b", s.b);
+    w.field("p", s.p);
+    w.field("fp", s.fp);
+    w.endObject();
+}
+
+static void writeStep(JsonWriter& w, const SecantTraceStep& s)
+{
+    w.beginObject();
+    w.field("iter", s.iter);
+    w.field("x0", s.x0);
+    w.field("x1", s.x1);
+    w.field("p", s.p);
+    w.field("fp", s.fp);
+    w.endObject();
+}
+
+static void writeStep(JsonWriter& w, const NewtonTraceStep& s)
+{
+    w.beginObject();
+    w.field("iter", s.iter);
+    w.field("x", s.x);
+    w.field("fx", s.fx);
+    w.field("dfx", s.dfx);
+    w.field("xNext", s.xNext);
+    w.field("fxNext", s.fxNext);
+    w.endObject();
+}
+
+template <typename Step>
+static void writeSteps(JsonWriter& w, const std::vector<Step>& steps)
+{
+    w.beginArray();
+    for (const Step& s : steps)
+    {
+        writeStep(w, s);
+    }
+    w.endArray();
+}
+
+template <typename Step>
+static void writeDecimatedTrace(JsonWriter& w, const DecimatedTrace<Step>& trace, const TraceDecimation& decimation)
+{
+    if (!decimation.isFull())
+    {
+        w.field("traceSteps", trace.recorded());
+    }
+    w.key("trace");
+    writeSteps(w, trace.steps());
+}
+
+// "x" and "fx" of a method; a method stopped by the request's deadline also
+// gets its "status" (x is then the best iterate so far).
+static void writeOutcome(JsonWriter& w, const SolveOutcome<double>& outcome, const ScalarEquation& f)
+{
+    if (!outcome.completed())
+    {
+        w.field("status", solveStatusName(outcome.status));
+    }
+    w.field("x", outcome.x);
+    w.field("fx", f(outcome.x));
+}
+
+// Runs one method and writes its object. Full traces go to the writer as the
+// steps are produced instead of being collected first; decimated traces are
+// only known once the method has finished. `solve` takes the trace sink and
+// returns the SolveOutcome.
+template <typename Step, typename Solve>
+static void writeSequentialMethod(JsonWriter& w, const char* name, const ScalarEquation& f, const RootFindingRequest& request, Solve solve)
+{
+    w.beginObject();
+    w.field("name", name);
+
+    SolveOutcome<double> outcome{};
+    if (!request.trace)
+    {
+        NoTrace none;
+        outcome = solve(none);
+    }
+    else if (request.decimation.isFull())
+    {
+        auto sink = streamTo([&w](const Step& step) { writeStep(w, step); });
+        w.key("trace");
+        w.beginArray();
+        outcome = solve(sink);
+        w.endArray();
+    }
+    else
+    {
+        DecimatedTrace<Step> trace(request.decimation);
+        outcome = solve(trace);
+        writeDecimatedTrace(w, trace, request.decimation);
+    }
+
+    writeOutcome(w, outcome, f);
+    w.endObject();
+}
+
+namespace
+{
+    // NDJSON output of solveStream. Records are buffered and handed to the
+    // stream once the last flush is older than flushInterval (or right away
+    // when asked), so fast methods are not slowed down by a write per step.
+    class EventStream
+    {
+    private:
+        JsonWriter w;
+        std::chrono::steady_clock::time_point lastFlush;
+
+    public:
+        static constexpr std::chrono::milliseconds flushInterval{ 50 };
+
+        explicit EventStream(std::ostream& out)
+            : w(out), lastFlush(std::chrono::steady_clock::now())
+        {
+        }
+
+        JsonWriter& begin(const char* event)
+        {
+            w.beginObject();
+            w.field("event", event);
+            return w;
+        }
+
+        void end(bool flushNow)
+        {
+            w.endObject();
+            w.endLine();
+            const auto now = std::chrono::steady_clock::now();
+            if (flushNow || now - lastFlush >= flushInterval)
+            {
+                w.flush();
+                lastFlush = now;
+            }
+        }
+    };
+}
+
+// Runs one method for solveStream, emitting its steps as they are produced.
+// In stride mode only every limit-th step is sent, plus the last one.
+template <typename Step, typename Solve>
+static bool streamMethod(EventStream& events, const char* name, const ScalarEquation& f, const RootFindingRequest& request, Solve solve)
+{
+    const bool stride = (request.decimation.mode == TraceDecimationMode::Stride);
+    StrideSampler<Step> sampler(stride ? request.decimation.limit : 1);
+
+    auto emit = [&](const Step& step) {
+        JsonWriter& w = events.begin("step");
+        w.field("method", name);
+        w.key("step");
+        writeStep(w, step);
+        events.end(false);
+    };
+
+    SolveOutcome<double> outcome{};
+    try
+    {
+        if (!request.trace)
+        {
+            NoTrace none;
+            outcome = solve(none);
+        }
+        else
+        {
+            auto sink = streamTo([&](const Step& step) { sampler.record(step, emit); });
+            outcome = solve(sink);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        if (sampler.pending())
+        {
+            emit(*sampler.pending());
+        }
+        JsonWriter& w = events.begin("error");
+        w.field("method", name);
+        w.field("error", e.what());
+        events.end(true);
+        return false;
+    }
+    if (sampler.pending())
+    {
+        emit(*sampler.pending());
+    }
+
+    JsonWriter& w = events.begin("method");
+    w.field("name", name);
+    if (request.trace && stride)
+    {
+        w.field("traceSteps", sampler.recorded());
+    }
+    writeOutcome(w, outcome, f);
+    events.end(true);
+    return true;
+}
+
+// Columnar layout of each step type: an integer iteration column followed by
+// one Float64 column per field, in the same order as the JSON keys.
+static std::vector<ColumnSpec> stepColumns(std::initializer_list<const char*> fields, bool compress)
+{
+    std::vector<ColumnSpec> columns;
+    columns.push_back({ "iter", ColumnType::UInt64, compress ? ColumnEncoding::DeltaVarint : ColumnEncoding::Raw, 1 });
+    for (const char* field : fields)
+    {
+        columns.push_back({ field, ColumnType::Float64, compress ? ColumnEncoding::Xor : ColumnEncoding::Raw, 1 });
+    }
+    return columns;
+}
+
+static std::vector<ColumnSpec> columnsOf(const BisectionTraceStep*, bool compress)
+{
+    return stepColumns({ "a", "b", "p", "fp", "errorBound" }, compress);
+}
+
+static std::vector<ColumnSpec> columnsOf(const RegulaFalsiTraceStep*, bool compress)
+{
+    return stepColumns({ "a", "b", "p", "fp" }, compress);
+}
+
+static std::vector<ColumnSpec> columnsOf(const SecantTraceStep*, bool compress)
+{
+    return stepColumns({ "x0", "x1", "p", "fp" }, compress);
+}
+
+static std::vector<ColumnSpec> columnsOf(const NewtonTraceStep*, bool compress)
+{
+    return stepColumns({ "x", "fx", "dfx", "xNext", "fxNext" }, compress);
+}
+
+static void addStepRow(ColumnarTraceWriter& w, const BisectionTraceStep& s)
+{
+    w.addRow({ static_cast<double>(s.iter), s.a, s.b, s.p, s.fp, s.errorBound });
+}
+
+static void addStepRow(ColumnarTraceWriter& w, const RegulaFalsiTraceStep& s)
+{
+    w.addRow({ static_cast<double>(s.iter), s.a, s.b, s.p, s.fp });
+}
+
+static void addStepRow(ColumnarTraceWriter& w, const SecantTraceStep& s)
+{
+    w.addRow({ static_cast<double>(s.iter), s.x0, s.x1, s.p, s.fp });
+}
+
+static void addStepRow(ColumnarTraceWriter& w, const NewtonTraceStep& s)
+{
+    w.addRow({ static_cast<double>(s.iter), s.x, s.fx, s.dfx, s.xNext, s.fxNext });
+}
+
+template <typename Step>
+static void writeColumnarTable(ColumnarTraceWriter& w, const char* name, const std::vector<Step>& steps, bool compress)
+{
+    w.beginTable(name, columnsOf(static_cast<const Step*>(nullptr), compress));
+    for (const Step& s : steps)
+    {
+        addStepRow(w, s);
+    }
+    w.endTable();
+}
+
+// Columnar counterpart of writeSequentialMethod: one table per method (rows
+// appended while the solver runs for full traces) and the method object in
+// the metadata.
+template <typename Step, typename Solve>
+static void writeColumnarMethod(ColumnarTraceWriter& columns, JsonWriter& w, const char* name, const ScalarEquation& f,
+    const RootFindingRequest& request, bool compress, Solve solve)
+{
+    w.beginObject();
+    w.field("name", name);
+
+    SolveOutcome<double> outcome{};
+    if (!request.trace)
+    {
+        NoTrace none;
+        outcome = solve(none);
+    }
+    else if (request.decimation.isFull())
+    {
+        auto sink = streamTo([&columns](const Step& step) { addStepRow(columns, step); });
+        columns.beginTable(name, columnsOf(static_cast<const Step*>(nullptr), compress));
+        outcome = solve(sink);
+        columns.endTable();
+    }
+    else
+    {
+        DecimatedTrace<Step> trace(request.decimation);
+        outcome = solve(trace);
+        writeColumnarTable(columns, name, trace.steps(), compress);
+        w.field("traceSteps", trace.recorded());
+    }
+
+    writeOutcome(w, outcome, f);
+    w.endObject();
+}
+
+RootFindingProblem RootFindingService::problem(int eq, int interval)
+{
+    const bool secondInterval = (interval == 2);
+
+    if (eq == 1)
+    {
+        return {
+            1,
+            "x^2 - 4x + 4 - ln(x) = 0",
+            ScalarEquation([](double x) { return x * x - 4.0 * x + 4.0 - std::log(x); }),
+            [](double x) { return 2.0 * x - 4.0 - 1.0 / x; },
+            secondInterval ? 2.0 : 1.0,
+            secondInterval ? 4.0 : 2.0
+        };
+    }
+    if (eq == 2)
+    {
+        constexpr double pi = 3.14159265358979323846;
+        return {
+            2,
+            "x + 1 - 2 sin(pi x) = 0",
+            ScalarEquation([](double x) { return x + 1.0 - 2.0 * std::sin(pi * x); }),
+            [](double x) { return 1.0 - 2.0 * pi * std::cos(pi * x); },
+            secondInterval ? 0.5 : 0.0,
+            secondInterval ? 1.0 : 0.5
+        };
+    }
+    if (eq == 3)
+    {
+        return {
+            3,
+            "e^x - 3x^2 = 0",
+            ScalarEquation([](double x) { return std::exp(x) - 3.0 * x * x; }),
+            [](double x) { return std::exp(x) - 6.0 * x; },
+            secondInterval ? 3.0 : 0.0,
+            secondInterval ? 5.0 : 1.0
+        };
+    }
+    if (eq == 4)
+    {
+        return {
+            4,
+            "2x cos(2x) - (x-2)^2 = 0",
+            ScalarEquation([](double x) { return 2.0 * x * std::cos(2.0 * x) - (x - 2.0) * (x - 2.0); }),
+            [](double x) {
+                return 2.0 * std::cos(2.0 * x) - 4.0 * x * std::sin(2.0 * x) - 2.0 * (x - 2.0);
+            },
+            secondInterval ? 3.0 : 2.0,
+            secondInterval ? 4.0 : 3.0
+        };
+    }
+
+    throw std::invalid_argument("Invalid equation. Use 1-4.");
+}
+
+namespace
+{
+    // Traces recorded by the concurrent modes (one per method, in race order).
+    struct RecordedTraces
+    {
+        DecimatedTrace<BisectionTraceStep> bisection;
+        DecimatedTrace<RegulaFalsiTraceStep> regulaFalsi;
+        DecimatedTrace<SecantTraceStep> secant;
+        DecimatedTrace<NewtonTraceStep> newton;
+
+        explicit RecordedTraces(const TraceDecimation& decimation)
+            : bisection(decimation), regulaFalsi(decimation), secant(decimation), newton(decimation)
+        {
+        }
+    };
+}
+
+ResolvedRootFindingRequest RootFindingService::resolve(const RootFindingRequest& request, std::chrono::steady_clock::time_point start)
+{
+    RootFindingProblem p = RootFindingService::problem(request.eq, request.interval);
+
+    const double eps = request.eps.value_or(1e-7);
+    const double a = request.a.value_or(p.a);
+    const double b = request.b.value_or(p.b);
+    if (!(a < b))
+    {
+        throw std::invalid_argument("Invalid interval. Require a < b.");
+    }
+    if (request.eq == 1 && (a <= 0.0 || b <= 0.0))
+    {
+        throw std::invalid_argument("Invalid interval for eq(1). Require a>0 and b>0 because ln(x).");
+    }
+    const double x0 = request.x0.value_or((a + b) / 2.0);
+
+    StopCondition stop;
+    if (request.timeoutMs)
+    {
+        const double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        const double remaining = std::max(0.0, *request.timeoutMs - elapsed);
+        stop.deadline = Deadline::after(std::chrono::milliseconds(static_cast<long long>(std::ceil(remaining))));
+    }
+    return { std::move(p), eps, a, b, x0, stop };
+}
+
+static void writeHeader(JsonWriter& w, const RootFindingRequest& request, const ResolvedRootFindingRequest& r)
+{
+    w.field("kind", "rootfinding");
+    w.field("referat", "01");
+    w.field("eq", request.eq);
+    w.field("interval", request.interval);
+    w.field("eps", r.eps);
+    w.field("statement", r.problem.statement);
+    w.field("a", r.a);
+    w.field("b", r.b);
+    w.field("traceEnabled", request.trace);
+    if (request.trace && !request.decimation.isFull())
+    {
+        w.field("traceMode", request.decimation.modeName());
+        w.field("traceLimit", request.decimation.limit);
+    }
+    w.field("x0", r.x0);
+    if (request.timeoutMs)
+    {
+        w.field("timeoutMs", *request.timeoutMs);
+    }
+}
+
+static std::vector<RaceResult> runConcurrent(const RootFindingRequest& request, const ResolvedRootFindingRequest& r, RecordedTraces& traces)
+{
+    const bool traceMode = request.trace;
+
+    // A method stopped by the deadline ends the race as cancelled.
+    auto rootOf = [](const SolveOutcome<double>& outcome) {
+        if (!outcome.completed())
+        {
+            throw OperationCancelledException(std::string("method stopped: ") + solveStatusName(outcome.status));
+        }
+        return outcome.x;
+    };
+
+    MethodRace race;
+    race.add("bisection", [&](const ScalarEquation& e) {
+        NoTrace none;
+        return rootOf(traceMode ? RootFinding::bisection(e, r.a, r.b, r.eps, traces.bisection, r.stop) : RootFinding::bisection(e, r.a, r.b, r.eps, none, r.stop));
+    });
+    race.add("regulaFalsi", [&](const ScalarEquation& e) {
+        NoTrace none;
+        return rootOf(traceMode ? RootFinding::regulaFalsi(e, r.a, r.b, r.eps, traces.regulaFalsi, r.stop) : RootFinding::regulaFalsi(e, r.a, r.b, r.eps, none, r.stop));
+    });
+    race.add("secant", [&](const ScalarEquation& e) {
+        NoTrace none;
+        return rootOf(traceMode ? RootFinding::secant(e, r.a, r.b, r.eps, traces.secant, r.stop) : RootFinding::secant(e, r.a, r.b, r.eps, none, r.stop));
+    });
+    race.add("newton", [&](const ScalarEquation& e) {
+        NoTrace none;
+        return rootOf(traceMode ? RootFinding::newton(e, r.problem.derivative, r.x0, r.eps, traces.newton, r.stop) : RootFinding::newton(e, r.problem.derivative, r.x0, r.eps, none, r.stop));
+    });
+
+    const bool raceMode = (request.mode == RootFindingMode::Race);
+    ThreadPool pool(request.threads ? request.threads : race.size());
+    return race.run(r.problem.f, raceMode ? RaceMode::FirstToConverge : RaceMode::RunAll, pool);
+}
+
+static void writeRaceFields(JsonWriter& w, const RaceResult& result, const ScalarEquation& f)
+{
+    w.field("name", result.name);
+    w.field("status", MethodRace::statusName(result.status));
+    w.field("seconds", result.seconds);
+    if (result.status == RaceStatus::Converged)
+    {
+        w.field("x", result.x);
+        w.field("fx", f(result.x));
+    }
+    else
+    {
+        w.field("error", result.error);
+    }
+}
+
+static void writeWinner(JsonWriter& w, const std::vector<RaceResult>& results)
+{
+    for (const RaceResult& result : results)
+    {
+        if (result.winner)
+        {
+            w.field("winner", result.name);
+        }
+    }
+}
+
+static void solveSince(const RootFindingRequest& request, JsonWriter& w, Clock::time_point start)
+{
+    const ResolvedRootFindingRequest r = RootFindingService::resolve(request, start);
+    const ScalarEquation& f = r.problem.f;
+    const bool traceMode = request.trace;
+
+    w.beginObject();
+    writeHeader(w, request, r);
+
+    if (request.mode == RootFindingMode::Sequential)
+    {
+        w.key("methods");
+        w.beginArray();
+        writeSequentialMethod<BisectionTraceStep>(w, "bisection", f, request, [&](auto& t) {
+            return RootFinding::bisection(f, r.a, r.b, r.eps, t, r.stop);
+        });
+        writeSequentialMethod<RegulaFalsiTraceStep>(w, "regulaFalsi", f, request, [&](auto& t) {
+            return RootFinding::regulaFalsi(f, r.a, r.b, r.eps, t, r.stop);
+        });
+        writeSequentialMethod<SecantTraceStep>(w, "secant", f, request, [&](auto& t) {
+            return RootFinding::secant(f, r.a, r.b, r.eps, t, r.stop);
+        });
+        writeSequentialMethod<NewtonTraceStep>(w, "newton", f, request, [&](auto& t) {
+            return RootFinding::newton(f, r.problem.derivative, r.x0, r.eps, t, r.stop);
+        });
+        w.endArray();
+        w.endObject();
+        return;
+    }
+
+    // Concurrent methods record their traces; they are written in order once
+    // every method has finished (the writer is not shared across threads).
+    RecordedTraces traces(request.decimation);
+    const std::vector<RaceResult> results = runConcurrent(request, r, traces);
+
+    w.field("mode", request.mode == RootFindingMode::Race ? "race" : "parallel");
+    w.key("methods");
+    w.beginArray();
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        w.beginObject();
+        writeRaceFields(w, results[i], f);
+        if (traceMode)
+        {
+            switch (i)
+            {
+            case 0: writeDecimatedTrace(w, traces.bisection, request.decimation); break;
+            case 1: writeDecimatedTrace(w, traces.regulaFalsi, request.decimation); break;
+            case 2: writeDecimatedTrace(w, traces.secant, request.decimation); break;
+            default: writeDecimatedTrace(w, traces.newton, request.decimation); break;
+            }
+        }
+        w.endObject();
+    }
+    w.endArray();
+    writeWinner(w, results);
+    w.endObject();
+}
+
+void RootFindingService::solve(const RootFindingRequest& request, JsonWriter& w)
+{
+    solveSince(request, w, Clock::now());
+}
+
+bool RootFindingService::solveStream(const RootFindingRequest& request, std::ostream& out)
+{
+    if (request.mode != RootFindingMode::Sequential)
+    {
+        throw std::invalid_argument("Streaming runs the methods one after another. Use mode sequential.");
+    }
+    const TraceDecimationMode traceMode = request.decimation.mode;
+    if (request.trace && traceMode != TraceDecimationMode::Full && traceMode != TraceDecimationMode::Stride)
+    {
+        throw std::invalid_argument("Streaming supports traceMode full or stride.");
+    }
+
+    const ResolvedRootFindingRequest r = RootFindingService::resolve(request);
+    const ScalarEquation& f = r.problem.f;
+
+    EventStream events(out);
+    writeHeader(events.begin("header"), request, r);
+    events.end(true);
+
+    const bool ok =
+        streamMethod<BisectionTraceStep>(events, "bisection", f, request, [&](auto& t) {
+            return RootFinding::bisection(f, r.a, r.b, r.eps, t, r.stop);
+        })
+        && streamMethod<RegulaFalsiTraceStep>(events, "regulaFalsi", f, request, [&](auto& t) {
+            return RootFinding::regulaFalsi(f, r.a, r.b, r.eps, t, r.stop);
+        })
+        && streamMethod<SecantTraceStep>(events, "secant", f, request, [&](auto& t) {
+            return RootFinding::secant(f, r.a, r.b, r.eps, t, r.stop);
+        })
+        && streamMethod<NewtonTraceStep>(events, "newton", f, request, [&](auto& t) {
+            return RootFinding::newton(f, r.problem.derivative, r.x0, r.eps, t, r.stop);
+        });
+
+    if (ok)
+    {
+        events.begin("done");
+        events.end(true);
+    }
+    return ok;
+}
+
+void RootFindingService::solveColumnar(const RootFindingRequest& request, std::ostream& out, bool compress)
+{
+    const ResolvedRootFindingRequest r = RootFindingService::resolve(request);
+    const ScalarEquation& f = r.problem.f;
+    const bool traceMode = request.trace;
+
+    ColumnarTraceWriter columns(out);
+    std::ostringstream metadata;
+    JsonWriter w(metadata);
+    w.beginObject();
+    writeHeader(w, request, r);
+
+    if (request.mode == RootFindingMode::Sequential)
+    {
+        w.key("methods");
+        w.beginArray();
+        writeColumnarMethod<BisectionTraceStep>(columns, w, "bisection", f, request, compress, [&](auto& t) {
+            return RootFinding::bisection(f, r.a, r.b, r.eps, t, r.stop);
+        });
+        writeColumnarMethod<RegulaFalsiTraceStep>(columns, w, "regulaFalsi", f, request, compress, [&](auto& t) {
+            return RootFinding::regulaFalsi(f, r.a, r.b, r.eps, t, r.stop);
+        });
+        writeColumnarMethod<SecantTraceStep>(columns, w, "secant", f, request, compress, [&](auto& t) {
+            return RootFinding::secant(f, r.a, r.b, r.eps, t, r.stop);
+        });
+        writeColumnarMethod<NewtonTraceStep>(columns, w, "newton", f, request, compress, [&](auto& t) {
+            return RootFinding::newton(f, r.problem.derivative, r.x0, r.eps, t, r.stop);
+        });
+        w.endArray();
+    }
+    else
+    {
+        RecordedTraces traces(request.decimation);
+        const std::vector<RaceResult> results = runConcurrent(request, r, traces);
+        if (traceMode)
+        {
+            writeColumnarTable(columns, "bisection", traces.bisection.steps(), compress);
+            writeColumnarTable(columns, "regulaFalsi", traces.regulaFalsi.steps(), compress);
+            writeColumnarTable(columns, "secant", traces.secant.steps(), compress);
+            writeColumnarTable(columns, "newton", traces.newton.steps(), compress);
+        }
+
+        w.field("mode", request.mode == RootFindingMode::Race ? "race" : "parallel");
+        w.key("methods");
+        w.beginArray();
+        const std::size_t recorded[] = {
+            traces.bisection.recorded(), traces.regulaFalsi.recorded(), traces.secant.recorded(), traces.newton.recorded()
+        };
+        for (std::size_t i = 0; i < results.size(); i++)
+        {
+            w.beginObject();
+            writeRaceFields(w, results[i], f);
+            if (traceMode && !request.decimation.isFull())
+            {
+                w.field("traceSteps", recorded[i]);
+            }
+            w.endObject();
+        }
+        w.endArray();
+        writeWinner(w, results);
+    }
+
+    w.endObject();
+    w.flush();
+    columns.setMetadata(metadata.str());
+    columns.finish();
+}
+
+void RootFindingService::solveBatch(const std::vector<RootFindingRequest>& requests, JsonWriter& out, std::size_t threads)
+{
+    const Clock::time_point start = Clock::now();
+
+    // Each request is written into its own buffer, so the pool can finish
+    // them in any order and a failure halfway through drops only that result.
+    std::vector<std::string> results(requests.size());
+    std::vector<std::string> errors(requests.size());
+    std::vector<char> ok(requests.size(), 0);
+    auto solveOne = [&](std::size_t i) {
+        try
+        {
+            std::ostringstream buffer;
+            JsonWriter w(buffer);
+            solveSince(requests[i], w, start);
+            w.flush();
+            results[i] = buffer.str();
+            ok[i] = 1;
+        }
+        catch (const std::exception& e)
+        {
+            errors[i] = e.what();
+        }
+    };
+    const std::size_t wanted = std::min(threads > 0 ? threads : ThreadPool::defaultThreadCount(), requests.size());
+    if (wanted <= 1)
+    {
+        // On the calling thread: no pool to start for one worker.
+        for (std::size_t i = 0; i < requests.size(); i++)
+        {
+            solveOne(i);
+        }
+    }
+    else
+    {
+        ThreadPool pool(wanted);
+        pool.runBatch(requests.size(), solveOne);
+    }
+
+    out.beginArray();
+    for (std::size_t i = 0; i < requests.size(); i++)
+    {
+        out.beginObject();
+        out.field("ok", ok[i] != 0);
+        if (ok[i])
+        {
+            out.key("result");
+            out.rawValue(results[i]);
+        }
+        else
+        {
+            out.field("error", errors[i]);
+        }
+        out.endObject();
+    }
+    out.endArray();
+}
+
+RootFindingRequest RootFindingService::parseRequest(const json& params)
+{
+    if (!params.is_object())
+    {
+        throw std::invalid_argument("Invalid request. Expected a JSON object.");
+    }
+
+    RootFindingRequest request;
+    if (const auto eq = optionalNumber(params, "eq"))
+    {
+        request.eq = static_cast<int>(*eq);
+    }
+    if (const auto interval = optionalNumber(params, "interval"))
+    {
+        request.interval = static_cast<int>(*interval);
+    }
+    request.a = optionalNumber(params, "a");
+    request.b = optionalNumber(params, "b");
+    request.x0 = optionalNumber(params, "x0");
+    request.eps = optionalNumber(params, "eps");
+    request.timeoutMs = optionalNumber(params, "timeoutMs");
+
+    if (request.eps && !(*request.eps > 0.0))
+    {
+        throw std::invalid_argument("Invalid eps. Must be a finite positive number.");
+    }
+    if (request.timeoutMs && !(*request.timeoutMs > 0.0))
+    {
+        throw std::invalid_argument("Invalid timeoutMs. Must be a positive number.");
+    }
+    if (request.a.has_value() != request.b.has_value())
+    {
+        throw std::invalid_argument("Provide both a and b, or neither.");
+    }
+
+    request.trace = optionalBool(params, "trace", request.trace);
+
+    const auto mode = params.find("mode");
+    if (mode != params.end() && mode->is_string())
+    {
+        const std::string m = mode->get<std::string>();
+        if (m == "sequential")
+        {
+            request.mode = RootFindingMode::Sequential;
+        }
+        else if (m == "parallel")
+        {
+            request.mode = RootFindingMode::Parallel;
+        }
+        else if (m == "race")
+        {
+            request.mode = RootFindingMode::Race;
+        }
+        else
+        {
+            throw std::invalid_argument("Invalid mode. Use sequential, parallel or race.");
+        }
+    }
+
+    const auto traceMode = params.find("traceMode");
+    const auto traceLimit = optionalNumber(params, "traceLimit");
+    if (traceLimit && *traceLimit < 0.0)
+    {
+        throw std::invalid_argument("Invalid traceLimit. Must be non-negative.");
+    }
+    if (traceMode != params.end() && !traceMode->is_null())
+    {
+        if (!traceMode->is_string())
+        {
+            throw std::invalid_argument("Invalid traceMode. Use full, head-tail, stride or lttb.");
+        }
+        request.decimation = TraceDecimation::parse(traceMode->get<std::string>(), traceLimit ? static_cast<std::size_t>(*traceLimit) : 0);
+    }
+
+    if (const auto threads = optionalNumber(params, "threads"))
+    {
+        if (*threads < 0.0)
+        {
+            throw std::invalid_argument("Invalid threads. Must be non-negative.");
+        }
+        // Each worker is an OS thread and the value can come from any client:
+        // more than one per method or per hardware thread buys nothing.
+        const std::size_t limit = std::min(kMethodCount, ThreadPool::defaultThreadCount());
+        request.threads = static_cast<std::size_t>(std::min(*threads, static_cast<double>(limit)));
+    }
+
+    return request;
+}
+
+std::vector<RootFindingRequest> RootFindingService::parseBatch(const json& params)
+{
+    if (!params.is_array())
+    {
+        throw std::invalid_argument("Invalid batch. Expected a JSON array of requests.");
+    }
+
+    std::vector<RootFindingRequest> requests;
+    requests.reserve(params.size());
+    for (std::size_t i = 0; i < params.size(); i++)
+    {
+        try
+        {
+            requests.push_back(parseRequest(params[i]));
+        }
+        catch (const std::invalid_argument& e)
+        {
+            throw std::invalid_argument("Request " + std::to_string(i) + ": " + e.what());
+        }
+    }
+    return requests;
+}
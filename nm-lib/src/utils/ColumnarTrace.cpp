@@ -0,0 +1,745 @@
+#include "utils/ColumnarTrace.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char magic[4] = { 'N', 'M', 'T', 'C' };
+    constexpr std::uint16_t formatVersion = 1;
+    constexpr std::size_t headerSize = 12;
+    constexpr std::size_t trailerSize = 12;
+
+    bool littleEndianHost()
+    {
+        const std::uint16_t probe = 1;
+        unsigned char first = 0;
+        std::memcpy(&first, &probe, 1);
+        return first == 1;
+    }
+
+    std::uint64_t doubleBits(double v)
+    {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &v, sizeof(bits));
+        return bits;
+    }
+
+    double bitsToDouble(std::uint64_t bits)
+    {
+        double v = 0.0;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+
+    int leadingZeros(std::uint64_t x)
+    {
+        int n = 0;
+        for (std::uint64_t mask = std::uint64_t(1) << 63; mask && !(x & mask); mask >>= 1)
+        {
+            n++;
+        }
+        return n;
+    }
+
+    int trailingZeros(std::uint64_t x)
+    {
+        int n = 0;
+        while (n < 64 && !(x & 1))
+        {
+            x >>= 1;
+            n++;
+        }
+        return n;
+    }
+
+    void putLE(std::string& out, std::uint64_t v, int bytes)
+    {
+        for (int i = 0; i < bytes; i++)
+        {
+            out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void putString(std::string& out, const std::string& s)
+    {
+        if (s.size() > 0xFFFF)
+        {
+            throw std::invalid_argument("ColumnarTraceWriter: name too long");
+        }
+        putLE(out, s.size(), 2);
+        out += s;
+    }
+
+    // MSB-first bit stream used by the Xor encoding.
+    class BitWriter {
+    private:
+        std::string& out;
+        unsigned char current;
+        int used;
+
+    public:
+        explicit BitWriter(std::string& out)
+            : out(out), current(0), used(0)
+        {
+        }
+
+        void write(std::uint64_t value, int bits)
+        {
+            while (bits > 0)
+            {
+                const int room = 8 - used;
+                const int take = bits < room ? bits : room;
+                const std::uint64_t chunk = (value >> (bits - take)) & ((std::uint64_t(1) << take) - 1);
+                current = static_cast<unsigned char>(current | (chunk << (room - take)));
+                used += take;
+                bits -= take;
+                if (used == 8)
+                {
+                    out.push_back(static_cast<char>(current));
+                    current = 0;
+                    used = 0;
+                }
+            }
+        }
+
+        void finish()
+        {
+            if (used > 0)
+            {
+                out.push_back(static_cast<char>(current));
+                current = 0;
+                used = 0;
+            }
+        }
+    };
+
+    class BitReader {
+    private:
+        const unsigned char* data;
+        std::size_t size;
+        std::size_t bit;
+
+    public:
+        BitReader(const unsigned char* data, std::size_t size)
+            : data(data), size(size), bit(0)
+        {
+        }
+
+        std::uint64_t read(int bits)
+        {
+            std::uint64_t value = 0;
+            while (bits > 0)
+            {
+                const std::size_t byte = bit / 8;
+                if (byte >= size)
+                {
+                    throw std::runtime_error("ColumnarTraceReader: truncated Xor chunk");
+                }
+                const int offset = static_cast<int>(bit % 8);
+                const int room = 8 - offset;
+                const int take = bits < room ? bits : room;
+                const unsigned chunk = (data[byte] >> (room - take)) & ((1u << take) - 1);
+                value = (value << take) | chunk;
+                bit += static_cast<std::size_t>(take);
+                bits -= take;
+            }
+            return value;
+        }
+    };
+
+    void encodeChunk(std::string& out, const ColumnSpec& spec, const std::vector<double>& values)
+    {
+        const std::size_t width = spec.width;
+        if (spec.encoding == ColumnEncoding::Raw)
+        {
+            out.reserve(values.size() * 8);
+            for (double v : values)
+            {
+                const std::uint64_t bits = (spec.type == ColumnType::Float64)
+                    ? doubleBits(v)
+                    : static_cast<std::uint64_t>(v);
+                putLE(out, bits, 8);
+            }
+            return;
+        }
+
+        if (spec.encoding == ColumnEncoding::Xor)
+        {
+            std::vector<std::uint64_t> prev(width, 0);
+            BitWriter bits(out);
+            for (std::size_t i = 0; i < values.size(); i++)
+            {
+                const std::uint64_t cur = doubleBits(values[i]);
+                const std::uint64_t x = cur ^ prev[i % width];
+                prev[i % width] = cur;
+                if (x == 0)
+                {
+                    bits.write(0, 1);
+                    continue;
+                }
+                const int lz = leadingZeros(x);
+                const int tz = trailingZeros(x);
+                const int len = 64 - lz - tz;
+                bits.write(1, 1);
+                bits.write(static_cast<std::uint64_t>(lz), 6);
+                bits.write(static_cast<std::uint64_t>(len - 1), 6);
+                bits.write(x >> tz, len);
+            }
+            bits.finish();
+            return;
+        }
+
+        // DeltaVarint
+        std::vector<std::uint64_t> prev(width, 0);
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            const std::uint64_t cur = static_cast<std::uint64_t>(values[i]);
+            const std::int64_t delta = static_cast<std::int64_t>(cur - prev[i % width]);
+            prev[i % width] = cur;
+            std::uint64_t z = (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63);
+            while (z >= 0x80)
+            {
+                out.push_back(static_cast<char>((z & 0x7F) | 0x80));
+                z >>= 7;
+            }
+            out.push_back(static_cast<char>(z));
+        }
+    }
+
+    void validateSpec(const ColumnSpec& spec)
+    {
+        if (spec.width == 0)
+        {
+            throw std::invalid_argument("ColumnarTraceWriter: column width must be positive");
+        }
+        if (spec.encoding == ColumnEncoding::Xor && spec.type != ColumnType::Float64)
+        {
+            throw std::invalid_argument("ColumnarTraceWriter: Xor encoding requires a Float64 column");
+        }
+        if (spec.encoding == ColumnEncoding::DeltaVarint && spec.type != ColumnType::UInt64)
+        {
+            throw std::invalid_argument("ColumnarTraceWriter: DeltaVarint encoding requires a UInt64 column");
+        }
+    }
+}
+
+std::size_t ColumnarTable::columnIndex(const std::string& column) const
+{
+    for (std::size_t i = 0; i < columns.size(); i++)
+    {
+        if (columns[i].name == column)
+        {
+            return i;
+        }
+    }
+    throw std::invalid_argument("ColumnarTable: no column named " + column);
+}
+
+ColumnarTraceWriter::ColumnarTraceWriter(std::ostream& out, std::size_t rowsPerBlock)
+    : out(out),
+      rowsPerBlock(rowsPerBlock ? rowsPerBlock : 1),
+      position(0),
+      tableOpen(false),
+      finished(false),
+      pendingRows(0),
+      rowWidth(0)
+{
+    std::string header(magic, sizeof(magic));
+    putLE(header, formatVersion, 2);
+    putLE(header, 0, 2);
+    putLE(header, 0, 4);
+    writeBytes(header.data(), header.size());
+}
+
+ColumnarTraceWriter::~ColumnarTraceWriter()
+{
+    if (!finished)
+    {
+        try
+        {
+            finish();
+        }
+        catch (...)
+        {
+            // Destructors must not throw; an explicit finish() reports errors.
+        }
+    }
+}
+
+void ColumnarTraceWriter::writeBytes(const void* data, std::size_t n)
+{
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(n));
+    position += n;
+}
+
+void ColumnarTraceWriter::beginTable(const std::string& name, std::vector<ColumnSpec> columns)
+{
+    if (finished || tableOpen)
+    {
+        throw std::logic_error("ColumnarTraceWriter: beginTable while a table is open or after finish");
+    }
+    if (columns.empty())
+    {
+        throw std::invalid_argument("ColumnarTraceWriter: a table needs at least one column");
+    }
+
+    rowWidth = 0;
+    for (const ColumnSpec& spec : columns)
+    {
+        validateSpec(spec);
+        rowWidth += spec.width;
+    }
+
+    ColumnarTable table;
+    table.name = name;
+    table.columns = std::move(columns);
+    tables.push_back(std::move(table));
+
+    pending.assign(tables.back().columns.size(), std::vector<double>());
+    for (std::size_t c = 0; c < pending.size(); c++)
+    {
+        pending[c].reserve(rowsPerBlock * tables.back().columns[c].width);
+    }
+    pendingRows = 0;
+    tableOpen = true;
+}
+
+void ColumnarTraceWriter::addRow(const double* values, std::size_t count)
+{
+    if (!tableOpen)
+    {
+        throw std::logic_error("ColumnarTraceWriter: addRow without an open table");
+    }
+    if (count != rowWidth)
+    {
+        throw std::invalid_argument("ColumnarTraceWriter: row has the wrong number of values");
+    }
+
+    const std::vector<ColumnSpec>& columns = tables.back().columns;
+    for (std::size_t c = 0; c < columns.size(); c++)
+    {
+        pending[c].insert(pending[c].end(), values, values + columns[c].width);
+        values += columns[c].width;
+    }
+    pendingRows++;
+    tables.back().rowCount++;
+
+    if (pendingRows == rowsPerBlock)
+    {
+        flushBlock();
+    }
+}
+
+void ColumnarTraceWriter::addRow(std::initializer_list<double> values)
+{
+    addRow(values.begin(), values.size());
+}
+
+void ColumnarTraceWriter::flushBlock()
+{
+    if (pendingRows == 0)
+    {
+        return;
+    }
+
+    ColumnarTable& table = tables.back();
+    ColumnarBlock block;
+    block.rowCount = pendingRows;
+
+    std::string chunk;
+    for (std::size_t c = 0; c < table.columns.size(); c++)
+    {
+        // 8-byte alignment lets raw chunks be used in place as double arrays.
+        static const char zeros[8] = { 0 };
+        const std::size_t pad = static_cast<std::size_t>((8 - position % 8) % 8);
+        writeBytes(zeros, pad);
+
+        chunk.clear();
+        encodeChunk(chunk, table.columns[c], pending[c]);
+        block.offsets.push_back(position);
+        block.lengths.push_back(chunk.size());
+        writeBytes(chunk.data(), chunk.size());
+        pending[c].clear();
+    }
+
+    table.blocks.push_back(std::move(block));
+    pendingRows = 0;
+}
+
+void ColumnarTraceWriter::endTable()
+{
+    if (!tableOpen)
+    {
+        throw std::logic_error("ColumnarTraceWriter: endTable without an open table");
+    }
+    flushBlock();
+    tableOpen = false;
+}
+
+void ColumnarTraceWriter::setMetadata(std::string json)
+{
+    metadata = std::move(json);
+}
+
+void ColumnarTraceWriter::finish()
+{
+    if (finished)
+    {
+        return;
+    }
+    if (tableOpen)
+    {
+        endTable();
+    }
+    finished = true;
+
+    const std::uint64_t footerOffset = position;
+    std::string footer;
+    putLE(footer, metadata.size(), 4);
+    footer += metadata;
+    putLE(footer, tables.size(), 4);
+    for (const ColumnarTable& table : tables)
+    {
+        putString(footer, table.name);
+        putLE(footer, table.rowCount, 8);
+        putLE(footer, table.columns.size(), 2);
+        for (const ColumnSpec& spec : table.columns)
+        {
+            putString(footer, spec.name);
+            putLE(footer, static_cast<std::uint8_t>(spec.type), 1);
+            putLE(footer, static_cast<std::uint8_t>(spec.encoding), 1);
+            putLE(footer, spec.width, 4);
+        }
+        putLE(footer, table.blocks.size(), 4);
+        for (const ColumnarBlock& block : table.blocks)
+        {
+            putLE(footer, block.rowCount, 8);
+            for (std::size_t c = 0; c < table.columns.size(); c++)
+            {
+                putLE(footer, block.offsets[c], 8);
+                putLE(footer, block.lengths[c], 8);
+            }
+        }
+    }
+    putLE(footer, footerOffset, 8);
+    footer.append(magic, sizeof(magic));
+    writeBytes(footer.data(), footer.size());
+    out.flush();
+}
+
+namespace
+{
+    // Bounds-checked little-endian cursor over the footer.
+    class Cursor {
+    private:
+        const unsigned char* data;
+        std::size_t size;
+        std::size_t pos;
+
+    public:
+        Cursor(const unsigned char* data, std::size_t size, std::size_t pos)
+            : data(data), size(size), pos(pos)
+        {
+        }
+
+        std::uint64_t read(int bytes)
+        {
+            if (pos + static_cast<std::size_t>(bytes) > size)
+            {
+                throw std::runtime_error("ColumnarTraceReader: truncated footer");
+            }
+            std::uint64_t v = 0;
+            for (int i = 0; i < bytes; i++)
+            {
+                v |= static_cast<std::uint64_t>(data[pos + i]) << (8 * i);
+            }
+            pos += static_cast<std::size_t>(bytes);
+            return v;
+        }
+
+        std::string readString(std::size_t n)
+        {
+            if (pos + n > size)
+            {
+                throw std::runtime_error("ColumnarTraceReader: truncated footer");
+            }
+            std::string s(reinterpret_cast<const char*>(data + pos), n);
+            pos += n;
+            return s;
+        }
+    };
+
+    std::shared_ptr<const void> mapFile(const std::string& path, std::size_t& size)
+    {
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("ColumnarTraceReader: cannot open " + path);
+        }
+        LARGE_INTEGER length;
+        if (!GetFileSizeEx(file, &length) || length.QuadPart == 0)
+        {
+            CloseHandle(file);
+            throw std::runtime_error("ColumnarTraceReader: empty or unreadable file " + path);
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+        {
+            throw std::runtime_error("ColumnarTraceReader: cannot map " + path);
+        }
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!view)
+        {
+            throw std::runtime_error("ColumnarTraceReader: cannot map " + path);
+        }
+        size = static_cast<std::size_t>(length.QuadPart);
+        return std::shared_ptr<const void>(view, [](const void* p) { UnmapViewOfFile(p); });
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("ColumnarTraceReader: cannot open " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size == 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("ColumnarTraceReader: empty or unreadable file " + path);
+        }
+        const std::size_t length = static_cast<std::size_t>(st.st_size);
+        void* view = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+        {
+            throw std::runtime_error("ColumnarTraceReader: cannot map " + path);
+        }
+        size = length;
+        return std::shared_ptr<const void>(view, [length](const void* p) { ::munmap(const_cast<void*>(p), length); });
+#endif
+    }
+}
+
+ColumnarTraceReader ColumnarTraceReader::open(const std::string& path)
+{
+    ColumnarTraceReader reader;
+    reader.storage = mapFile(path, reader.size);
+    reader.data = static_cast<const unsigned char*>(reader.storage.get());
+    reader.parse();
+    return reader;
+}
+
+ColumnarTraceReader ColumnarTraceReader::fromBuffer(std::vector<unsigned char> bytes)
+{
+    auto owned = std::make_shared<std::vector<unsigned char>>(std::move(bytes));
+    ColumnarTraceReader reader;
+    reader.data = owned->data();
+    reader.size = owned->size();
+    reader.storage = std::shared_ptr<const void>(owned, owned->data());
+    reader.parse();
+    return reader;
+}
+
+void ColumnarTraceReader::parse()
+{
+    if (size < headerSize + trailerSize ||
+        std::memcmp(data, magic, sizeof(magic)) != 0 ||
+        std::memcmp(data + size - sizeof(magic), magic, sizeof(magic)) != 0)
+    {
+        throw std::runtime_error("ColumnarTraceReader: not an NMTC trace");
+    }
+
+    Cursor header(data, size, sizeof(magic));
+    if (header.read(2) != formatVersion)
+    {
+        throw std::runtime_error("ColumnarTraceReader: unsupported version");
+    }
+
+    Cursor tail(data, size, size - trailerSize);
+    const std::uint64_t footerOffset = tail.read(8);
+    if (footerOffset < headerSize || footerOffset > size - trailerSize)
+    {
+        throw std::runtime_error("ColumnarTraceReader: bad footer offset");
+    }
+
+    const std::size_t footerEnd = size - trailerSize;
+    Cursor c(data, footerEnd, static_cast<std::size_t>(footerOffset));
+    metadataText = c.readString(static_cast<std::size_t>(c.read(4)));
+
+    const std::uint64_t tableCount = c.read(4);
+    tableList.clear();
+    for (std::uint64_t t = 0; t < tableCount; t++)
+    {
+        ColumnarTable table;
+        table.name = c.readString(static_cast<std::size_t>(c.read(2)));
+        table.rowCount = c.read(8);
+        const std::uint64_t columnCount = c.read(2);
+        for (std::uint64_t k = 0; k < columnCount; k++)
+        {
+            ColumnSpec spec;
+            spec.name = c.readString(static_cast<std::size_t>(c.read(2)));
+            spec.type = static_cast<ColumnType>(c.read(1));
+            spec.encoding = static_cast<ColumnEncoding>(c.read(1));
+            spec.width = static_cast<std::uint32_t>(c.read(4));
+            if (spec.width == 0)
+            {
+                throw std::runtime_error("ColumnarTraceReader: zero-width column");
+            }
+            table.columns.push_back(std::move(spec));
+        }
+        const std::uint64_t blockCount = c.read(4);
+        for (std::uint64_t b = 0; b < blockCount; b++)
+        {
+            ColumnarBlock block;
+            block.rowCount = c.read(8);
+            for (std::uint64_t k = 0; k < columnCount; k++)
+            {
+                const std::uint64_t offset = c.read(8);
+                const std::uint64_t length = c.read(8);
+                if (offset > footerOffset || length > footerOffset - offset)
+                {
+                    throw std::runtime_error("ColumnarTraceReader: chunk outside the file");
+                }
+                block.offsets.push_back(offset);
+                block.lengths.push_back(length);
+            }
+            table.blocks.push_back(std::move(block));
+        }
+        tableList.push_back(std::move(table));
+    }
+}
+
+const std::string& ColumnarTraceReader::metadata() const
+{
+    return metadataText;
+}
+
+const std::vector<ColumnarTable>& ColumnarTraceReader::tables() const
+{
+    return tableList;
+}
+
+const ColumnarTable& ColumnarTraceReader::table(const std::string& name) const
+{
+    for (const ColumnarTable& t : tableList)
+    {
+        if (t.name == name)
+        {
+            return t;
+        }
+    }
+    throw std::invalid_argument("ColumnarTraceReader: no table named " + name);
+}
+
+const double* ColumnarTraceReader::rawChunk(const ColumnarTable& table, std::size_t block, std::size_t column) const
+{
+    const ColumnSpec& spec = table.columns.at(column);
+    if (spec.type != ColumnType::Float64 || spec.encoding != ColumnEncoding::Raw || !littleEndianHost())
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const double*>(data + table.blocks.at(block).offsets.at(column));
+}
+
+std::vector<double> ColumnarTraceReader::readColumn(const ColumnarTable& table, std::size_t column) const
+{
+    const ColumnSpec& spec = table.columns.at(column);
+    const std::size_t width = spec.width;
+
+    std::vector<double> values;
+    values.reserve(static_cast<std::size_t>(table.rowCount) * width);
+
+    for (const ColumnarBlock& block : table.blocks)
+    {
+        const unsigned char* chunk = data + block.offsets[column];
+        const std::size_t length = static_cast<std::size_t>(block.lengths[column]);
+        const std::size_t count = static_cast<std::size_t>(block.rowCount) * width;
+
+        if (spec.encoding == ColumnEncoding::Raw)
+        {
+            if (length < count * 8)
+            {
+                throw std::runtime_error("ColumnarTraceReader: truncated raw chunk");
+            }
+            for (std::size_t i = 0; i < count; i++)
+            {
+                std::uint64_t bits = 0;
+                for (int k = 0; k < 8; k++)
+                {
+                    bits |= static_cast<std::uint64_t>(chunk[i * 8 + k]) << (8 * k);
+                }
+                values.push_back(spec.type == ColumnType::Float64 ? bitsToDouble(bits) : static_cast<double>(bits));
+            }
+        }
+        else if (spec.encoding == ColumnEncoding::Xor)
+        {
+            std::vector<std::uint64_t> prev(width, 0);
+            BitReader bits(chunk, length);
+            for (std::size_t i = 0; i < count; i++)
+            {
+                std::uint64_t cur = prev[i % width];
+                if (bits.read(1))
+                {
+                    const int lz = static_cast<int>(bits.read(6));
+                    const int len = static_cast<int>(bits.read(6)) + 1;
+                    if (lz + len > 64)
+                    {
+                        throw std::runtime_error("ColumnarTraceReader: corrupt Xor chunk");
+                    }
+                    cur ^= bits.read(len) << (64 - lz - len);
+                }
+                prev[i % width] = cur;
+                values.push_back(bitsToDouble(cur));
+            }
+        }
+        else if (spec.encoding == ColumnEncoding::DeltaVarint)
+        {
+            std::vector<std::uint64_t> prev(width, 0);
+            std::size_t pos = 0;
+            for (std::size_t i = 0; i < count; i++)
+            {
+                std::uint64_t z = 0;
+                int shift = 0;
+                while (true)
+                {
+                    if (pos >= length || shift > 63)
+                    {
+                        throw std::runtime_error("ColumnarTraceReader: corrupt varint chunk");
+                    }
+                    const unsigned char byte = chunk[pos++];
+                    z |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                    if (!(byte & 0x80))
+                    {
+                        break;
+                    }
+                    shift += 7;
+                }
+                const std::uint64_t delta = (z >> 1) ^ (~(z & 1) + 1);
+                prev[i % width] += delta;
+                values.push_back(static_cast<double>(prev[i % width]));
+            }
+        }
+        else
+        {
+            throw std::runtime_error("ColumnarTraceReader: unknown column encoding");
+        }
+    }
+
+    return values;
+}
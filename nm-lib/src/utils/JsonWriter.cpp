@@ -0,0 +1,201 @@
+#include "utils/JsonWriter.h"
+
+#include <charconv>
+#include <cmath>
+
+namespace
+{
+    constexpr std::size_t flushThreshold = 1 << 16;
+}
+
+JsonWriter::JsonWriter(std::ostream& out)
+    : out(out), afterKey(false)
+{
+    buffer.reserve(flushThreshold + 256);
+}
+
+JsonWriter::~JsonWriter()
+{
+    flush();
+}
+
+void JsonWriter::flush()
+{
+    if (!buffer.empty())
+    {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+    out.flush();
+}
+
+void JsonWriter::raw(const char* s, std::size_t n)
+{
+    buffer.append(s, n);
+    if (buffer.size() >= flushThreshold)
+    {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+}
+
+void JsonWriter::separator()
+{
+    if (afterKey)
+    {
+        afterKey = false;
+        return;
+    }
+    if (!first.empty())
+    {
+        if (first.back())
+        {
+            first.back() = false;
+        }
+        else
+        {
+            raw(",", 1);
+        }
+    }
+}
+
+void JsonWriter::beginObject()
+{
+    separator();
+    raw("{", 1);
+    first.push_back(true);
+}
+
+void JsonWriter::endObject()
+{
+    first.pop_back();
+    raw("}", 1);
+}
+
+void JsonWriter::beginArray()
+{
+    separator();
+    raw("[", 1);
+    first.push_back(true);
+}
+
+void JsonWriter::endArray()
+{
+    first.pop_back();
+    raw("]", 1);
+}
+
+void JsonWriter::key(const std::string& name)
+{
+    separator();
+    writeString(name);
+    raw(":", 1);
+    afterKey = true;
+}
+
+void JsonWriter::value(double v)
+{
+    separator();
+    if (!std::isfinite(v))
+    {
+        raw("null", 4);
+        return;
+    }
+    char tmp[32];
+    const auto res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+    raw(tmp, static_cast<std::size_t>(res.ptr - tmp));
+}
+
+void JsonWriter::value(bool v)
+{
+    separator();
+    if (v)
+    {
+        raw("true", 4);
+    }
+    else
+    {
+        raw("false", 5);
+    }
+}
+
+void JsonWriter::value(const std::string& v)
+{
+    separator();
+    writeString(v);
+}
+
+void JsonWriter::value(const char* v)
+{
+    separator();
+    writeString(v);
+}
+
+void JsonWriter::null()
+{
+    separator();
+    raw("null", 4);
+}
+
+void JsonWriter::rawValue(const std::string& json)
+{
+    separator();
+    raw(json.data(), json.size());
+}
+
+void JsonWriter::endLine()
+{
+    raw("\n", 1);
+}
+
+void JsonWriter::writeUnsigned(unsigned long long v)
+{
+    char tmp[24];
+    const auto res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+    raw(tmp, static_cast<std::size_t>(res.ptr - tmp));
+}
+
+void JsonWriter::writeSigned(long long v)
+{
+    char tmp[24];
+    const auto res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+    raw(tmp, static_cast<std::size_t>(res.ptr - tmp));
+}
+
+void JsonWriter::writeString(const std::string& s)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    raw("\"", 1);
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < s.size(); i++)
+    {
+        const unsigned char c = static_cast<unsigned char>(s[i]);
+        if (c >= 0x20 && c != '"' && c != '\\')
+        {
+            // UTF-8 continuation bytes are passed through unchanged.
+            continue;
+        }
+
+        raw(s.data() + start, i - start);
+        start = i + 1;
+        switch (c)
+        {
+        case '"': raw("\\\"", 2); break;
+        case '\\': raw("\\\\", 2); break;
+        case '\n': raw("\\n", 2); break;
+        case '\r': raw("\\r", 2); break;
+        case '\t': raw("\\t", 2); break;
+        case '\b': raw("\\b", 2); break;
+        case '\f': raw("\\f", 2); break;
+        default:
+        {
+            const char esc[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+            raw(esc, 6);
+            break;
+        }
+        }
+    }
+    raw(s.data() + start, s.size() - start);
+    raw("\"", 1);
+}
@@ -1,6 +1,9 @@
 #include "utils/Rounding.h"
 
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 #include <stdexcept>
 
@@ -11,7 +14,13 @@ static long double roundHalfToEven(long double x)
         return x;
     }
 
-    const long double integerPart = std::floor(x);
+    // Below 2^63 the integer part and its parity come from one conversion;
+    // floor/fmod give the same values, only slower.
+    constexpr long double integerLimit = 9223372036854775808.0L;
+    const bool small = x >= 0.0L && x < integerLimit;
+    const std::uint64_t truncated = small ? static_cast<std::uint64_t>(x) : 0;
+
+    const long double integerPart = small ? static_cast<long double>(truncated) : std::floor(x);
     const long double fractionalPart = x - integerPart;
 
     constexpr long double eps = 1e-12L;
@@ -26,11 +35,121 @@ static long double roundHalfToEven(long double x)
     }
 
     // Tie case (first removed digit is 5 followed only by zeros): round to even.
-    const long double integerPartAsEvenCheck = std::fmod(integerPart, 2.0L);
-    const bool isEven = std::fabs(integerPartAsEvenCheck) < eps;
+    const bool isEven = small ? (truncated & 1u) == 0 : std::fabs(std::fmod(integerPart, 2.0L)) < eps;
     return isEven ? integerPart : (integerPart + 1.0L);
 }
 
+namespace
+{
+    // Scale powers (significantDigits - 1 - exponent) covered by the table;
+    // doubles have decimal exponents in [-324, 308].
+    constexpr int kMinScalePower = -330;
+    constexpr int kMaxScalePower = 360;
+
+    // Powers of ten that are exact doubles: 10^0 .. 10^22.
+    constexpr int kMaxExactPower = 22;
+
+    struct RoundingTables
+    {
+        std::array<long double, kMaxScalePower - kMinScalePower + 1> powers;
+        // floor(log10(10^k)) as the library computes it, for the values that
+        // land exactly on a power of ten (frequent once results are rounded).
+        std::array<int, kMaxExactPower + 1> exactPowerExponents;
+
+        long double power(int p) const
+        {
+            return powers[static_cast<std::size_t>(p - kMinScalePower)];
+        }
+    };
+
+    // pow(10, p) from the same library call the rounding always made, so the
+    // scaled values (and the results) are bit-identical to calling it each
+    // time. A plain function called through a volatile pointer keeps the table
+    // out of constant evaluation: the compiler's correctly rounded powers differ
+    // from libm's in the last bit for some p.
+    RoundingTables computeRoundingTables()
+    {
+        long double (*volatile power)(long double, long double) = std::pow;
+        long double (*volatile log10)(long double) = std::log10;
+
+        RoundingTables tables{};
+        for (int p = kMinScalePower; p <= kMaxScalePower; p++)
+        {
+            tables.powers[static_cast<std::size_t>(p - kMinScalePower)] = power(10.0L, static_cast<long double>(p));
+        }
+        for (int k = 0; k <= kMaxExactPower; k++)
+        {
+            tables.exactPowerExponents[static_cast<std::size_t>(k)] = static_cast<int>(std::floor(log10(tables.power(k))));
+        }
+        return tables;
+    }
+
+    const RoundingTables& roundingTables()
+    {
+        static const RoundingTables tables = computeRoundingTables();
+        return tables;
+    }
+
+    // floor(log10(absValue)) for a positive finite double. The binary exponent
+    // leaves two candidates, told apart by one comparison with the next power
+    // of ten; values within 1e-15 of that power (where the table entry may be
+    // inexact) take the log10 the rounding always used.
+    int decimalExponent(double absValue, const RoundingTables& tables)
+    {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &absValue, sizeof(bits));
+        // frexp's exponent, read from the bits; subnormals go through frexp.
+        int binaryExponent = static_cast<int>(bits >> 52) - 1022;
+        if (binaryExponent == -1022)
+        {
+            std::frexp(absValue, &binaryExponent);
+        }
+
+        // floor((binaryExponent - 1) * log10(2)), exact for every double exponent.
+        const int lower = ((binaryExponent - 1) * 78913) >> 18;
+        const long double next = tables.power(lower + 1);
+        const long double value = absValue;
+        if (std::fabs(value - next) <= next * 1e-15L)
+        {
+            if (value == next && lower + 1 >= 0 && lower + 1 <= kMaxExactPower)
+            {
+                return tables.exactPowerExponents[static_cast<std::size_t>(lower + 1)];
+            }
+            return static_cast<int>(std::floor(std::log10(value)));
+        }
+        return value > next ? lower + 1 : lower;
+    }
+
+    double roundNonZero(double value, int significantDigits, const RoundingTables& tables)
+    {
+        const double absValue = std::fabs(value);
+        const int scalePower = (significantDigits - 1) - decimalExponent(absValue, tables);
+
+        long double scale;
+        if (scalePower >= kMinScalePower && scalePower <= kMaxScalePower)
+        {
+            scale = tables.power(scalePower);
+        }
+        else
+        {
+            scale = std::pow(10.0L, static_cast<long double>(scalePower));
+        }
+
+        // Guard against overflow/underflow in scaling.
+        if (!std::isfinite(scale) || scale == 0.0L)
+        {
+            return value;
+        }
+
+        const long double sign = (value < 0.0) ? -1.0L : 1.0L;
+        const long double scaled = static_cast<long double>(absValue) * scale;
+        const long double roundedScaled = roundHalfToEven(scaled);
+        const long double result = (roundedScaled / scale) * sign;
+
+        return result;
+    }
+}
+
 double roundToSignificantDigits(double value, int significantDigits)
 {
     if (significantDigits <= 0)
@@ -43,22 +162,23 @@ double roundToSignificantDigits(double value, int significantDigits)
         return value;
     }
 
-    const long double absValue = std::fabs(static_cast<long double>(value));
-    const long double sign = (value < 0.0) ? -1.0L : 1.0L;
-
-    const long double exponent = std::floor(std::log10(absValue));
-    const long double scalePower = (significantDigits - 1) - exponent;
-    const long double scale = std::pow(10.0L, scalePower);
+    return roundNonZero(value, significantDigits, roundingTables());
+}
 
-    // Guard against overflow/underflow in scaling.
-    if (!std::isfinite(scale) || scale == 0.0L)
+void roundToSignificantDigits(double* values, std::size_t count, int significantDigits)
+{
+    if (significantDigits <= 0)
     {
-        return value;
+        throw std::invalid_argument("significantDigits must be positive");
     }
 
-    const long double scaled = absValue * scale;
-    const long double roundedScaled = roundHalfToEven(scaled);
-    const long double result = (roundedScaled / scale) * sign;
-
-    return result;
+    const RoundingTables& tables = roundingTables();
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const double value = values[i];
+        if (std::isfinite(value) && value != 0.0)
+        {
+            values[i] = roundNonZero(value, significantDigits, tables);
+        }
+    }
 }
@@ -0,0 +1,130 @@
+#include "utils/ThreadPool.h"
+
+#include <utility>
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+    : running(0), stopping(false)
+{
+    if (threadCount == 0)
+    {
+        threadCount = 1;
+    }
+
+    try
+    {
+        workers.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; i++)
+        {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+    catch (...)
+    {
+        // The destructor does not run for a half-built pool: stop and join
+        // the workers already started, or destroying them would terminate.
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        taskAvailable.notify_all();
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+        throw;
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::size() const
+{
+    return workers.size();
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(task));
+    }
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return queue.empty() && running == 0; });
+}
+
+void ThreadPool::runBatch(std::size_t count, const std::function<void(std::size_t)>& task)
+{
+    std::mutex doneMutex;
+    std::condition_variable doneCv;
+    std::size_t remaining = count;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        submit([&, i]()
+        {
+            task(i);
+            // Notified under the lock: once the caller sees remaining == 0 it
+            // returns and destroys doneMutex and doneCv.
+            std::lock_guard<std::mutex> lock(doneMutex);
+            remaining--;
+            doneCv.notify_one();
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCv.wait(lock, [&] { return remaining == 0; });
+}
+
+std::size_t ThreadPool::defaultThreadCount()
+{
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 2 : static_cast<std::size_t>(hw);
+}
+
+void ThreadPool::workerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty())
+            {
+                // stopping and nothing left to run
+                return;
+            }
+            task = std::move(queue.front());
+            queue.pop_front();
+            running++;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running--;
+            if (queue.empty() && running == 0)
+            {
+                idle.notify_all();
+            }
+        }
+    }
+}
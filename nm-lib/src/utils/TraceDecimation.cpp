@@ -0,0 +1,127 @@
+#include "utils/TraceDecimation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+bool TraceDecimation::isFull() const
+{
+    return mode == TraceDecimationMode::Full;
+}
+
+const char* TraceDecimation::modeName() const
+{
+    switch (mode)
+    {
+    case TraceDecimationMode::HeadTail:
+        return "head-tail";
+    case TraceDecimationMode::Stride:
+        return "stride";
+    case TraceDecimationMode::Lttb:
+        return "lttb";
+    default:
+        return "full";
+    }
+}
+
+TraceDecimation TraceDecimation::parse(const std::string& mode, std::size_t limit)
+{
+    TraceDecimation d;
+    if (mode == "full")
+    {
+        return d;
+    }
+    if (mode == "head-tail")
+    {
+        d.mode = TraceDecimationMode::HeadTail;
+        d.limit = limit ? limit : 250;
+    }
+    else if (mode == "stride")
+    {
+        d.mode = TraceDecimationMode::Stride;
+        d.limit = limit ? limit : 100;
+    }
+    else if (mode == "lttb")
+    {
+        d.mode = TraceDecimationMode::Lttb;
+        d.limit = limit ? limit : 500;
+        if (d.limit < 3)
+        {
+            throw std::invalid_argument("Invalid traceLimit. lttb keeps at least 3 points.");
+        }
+    }
+    else
+    {
+        throw std::invalid_argument("Invalid traceMode. Use full, head-tail, stride or lttb.");
+    }
+    return d;
+}
+
+double convergenceCurveValue(double residual)
+{
+    if (!std::isfinite(residual))
+    {
+        return 300.0;
+    }
+    return std::log10(std::max(std::fabs(residual), 1e-300));
+}
+
+std::vector<std::size_t> lttbSelect(const std::vector<double>& y, std::size_t threshold)
+{
+    const std::size_t n = y.size();
+    std::vector<std::size_t> selected;
+    if (threshold >= n || threshold < 3)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            selected.push_back(i);
+        }
+        return selected;
+    }
+
+    // Points 1..n-2 are split into threshold-2 buckets; each bucket keeps the
+    // point forming the largest triangle with the previously kept point and
+    // the average of the next bucket.
+    const double every = static_cast<double>(n - 2) / static_cast<double>(threshold - 2);
+    std::size_t a = 0;
+    selected.push_back(0);
+
+    for (std::size_t bucket = 0; bucket < threshold - 2; bucket++)
+    {
+        const std::size_t start = static_cast<std::size_t>(std::floor(bucket * every)) + 1;
+        const std::size_t end = std::min(static_cast<std::size_t>(std::floor((bucket + 1) * every)) + 1, n - 1);
+
+        const std::size_t nextStart = end;
+        const std::size_t nextEnd = std::min(static_cast<std::size_t>(std::floor((bucket + 2) * every)) + 1, n);
+        double avgX = 0.0;
+        double avgY = 0.0;
+        for (std::size_t j = nextStart; j < nextEnd; j++)
+        {
+            avgX += static_cast<double>(j);
+            avgY += y[j];
+        }
+        const double count = static_cast<double>(nextEnd - nextStart);
+        avgX /= count;
+        avgY /= count;
+
+        const double ax = static_cast<double>(a);
+        const double ay = y[a];
+        double maxArea = -1.0;
+        std::size_t best = start;
+        for (std::size_t j = start; j < end; j++)
+        {
+            const double area = std::fabs((ax - avgX) * (y[j] - ay) - (ax - static_cast<double>(j)) * (avgY - ay));
+            if (area > maxArea)
+            {
+                maxArea = area;
+                best = j;
+            }
+        }
+
+        selected.push_back(best);
+        a = best;
+    }
+
+    selected.push_back(n - 1);
+    return selected;
+}
@@ -1,8 +1,10 @@
 #include "NumericalMethods.h"
 
 #include <cmath>
+#include <complex>
 #include <cstdlib>
 #include <iostream>
+#include <vector>
 
 static bool nearlyEqual(double a, double b, double relTol = 1e-12, double absTol = 1e-12)
 {
@@ -37,6 +39,118 @@ int main()
     // Sign handling.
     expectEqual("-1.25 -> 2 sig digits", roundToSignificantDigits(-1.25, 2), -1.2);
 
+    // The bulk overload rounds in place, element by element like the scalar one.
+    double row[] = { 1.25, 1.35, 1250.0, 0.012349, -1.25, 0.0, 1000.0, 9.995e-7 };
+    const std::size_t count = sizeof(row) / sizeof(row[0]);
+    double expected[count];
+    for (std::size_t i = 0; i < count; i++) {
+        expected[i] = roundToSignificantDigits(row[i], 3);
+    }
+    roundToSignificantDigits(row, count, 3);
+    for (std::size_t i = 0; i < count; i++) {
+        if (row[i] != expected[i]) {
+            std::cerr << "FAIL: bulk rounding of element " << i << ": got " << row[i] << ", expected " << expected[i] << "\n";
+            std::exit(1);
+        }
+    }
+    std::cout << "OK: bulk rounding matches scalar rounding\n";
+
+    // Decimal<t> rounds every arithmetic result to t significant digits.
+    expectEqual("Decimal<2>: 1.2 + 0.05", (Decimal<2>(1.2) + Decimal<2>(0.05)).value(), 1.2);
+    expectEqual("Decimal<3>: 2 / 3", (Decimal<3>(2.0) / Decimal<3>(3.0)).value(), 0.667);
+
+    // Elimination in RuntimeDecimal reproduces solve(system, t) exactly.
+    const double entries[3][3] = { { 2.0, 1.0, -1.0 }, { -3.0, -1.0, 2.0 }, { -2.0, 1.0, 2.0 } };
+    Matrix A(3, 3);
+    for (std::size_t i = 0; i < 3; i++) {
+        for (std::size_t j = 0; j < 3; j++) {
+            A(i, j) = entries[i][j] / 7.0;
+        }
+    }
+    const LinearSystem system(A, Vector{ 8.0 / 3.0, -11.0, -3.0 });
+    for (int t = 2; t <= 6; t++) {
+        const Vector reference = GaussianElimination::solve(system, t);
+        DecimalPrecision precision(t);
+        const std::vector<RuntimeDecimal> x = GaussianElimination::solveAs<RuntimeDecimal>(system);
+        for (std::size_t i = 0; i < x.size(); i++) {
+            if (x[i].value() != reference[i]) {
+                std::cerr << "FAIL: Decimal elimination, t = " << t << ", x" << i + 1 << ": got " << x[i] << ", expected " << reference[i] << "\n";
+                std::exit(1);
+            }
+        }
+    }
+    std::cout << "OK: Decimal elimination matches solve(system, t)\n";
+
+    // Double-double keeps about 32 digits: 1/3 * 3 is 1 and sqrt(2)^2 is 2
+    // far below double's resolution.
+    const DoubleDouble third = DoubleDouble(1.0) / 3.0;
+    expectEqual("double-double 1/3 * 3 - 1", (third * 3.0 - 1.0).high(), 0.0);
+    const DoubleDouble root2 = sqrt(DoubleDouble(2.0));
+    if (!(std::fabs((root2 * root2 - 2.0).high()) < 1e-30) || third.toString(20) != "3.3333333333333333333e-01") {
+        std::cerr << "FAIL: double-double precision: sqrt(2) = " << root2.toString() << ", 1/3 = " << third.toString() << "\n";
+        std::exit(1);
+    }
+    std::cout << "OK: double-double keeps 32 digits\n";
+
+    // The containers and solvers are templates over the scalar: a complex
+    // system (an AC circuit's nodal equations) solves without conversions.
+    using Complex = std::complex<double>;
+    BasicMatrix<Complex> admittance(2, 2);
+    admittance(0, 0) = Complex(4.0, 1.0);
+    admittance(0, 1) = Complex(1.0, 0.0);
+    admittance(1, 0) = Complex(1.0, 0.0);
+    admittance(1, 1) = Complex(3.0, -1.0);
+    const BasicLinearSystem<Complex> circuit(admittance, BasicVector<Complex>{ Complex(5.0, 1.0), Complex(4.0, -1.0) });
+    const BasicVector<Complex> voltages = GaussianElimination::solve(circuit);
+    expectEqual("complex elimination, |x1 - 1|", std::abs(voltages[0] - 1.0), 0.0);
+    expectEqual("complex elimination, |x2 - 1|", std::abs(voltages[1] - 1.0), 0.0);
+    std::cout << "OK: complex elimination\n";
+
+    // Mixed-precision refinement reaches double accuracy from float factors
+    // when A is well conditioned, and falls back to a double solve when float
+    // cannot represent the problem: a Hilbert matrix (cond ~ 1e13) or entries
+    // beyond float's range, which would otherwise factor into infinities.
+    const IterativeRefinementResult refined = IterativeRefinement::solve(system);
+    const std::vector<double> direct = GaussianElimination::solveAs<double>(system);
+    if (refined.fellBack || refined.backwardError > 1e-15 || !nearlyEqual(refined.x[0], direct[0], 1e-13)
+        || !nearlyEqual(refined.x[1], direct[1], 1e-13) || !nearlyEqual(refined.x[2], direct[2], 1e-13)) {
+        std::cerr << "FAIL: refinement of a well-conditioned system: fellBack = " << refined.fellBack << " (" << refined.reason
+                  << "), backward error " << refined.backwardError << "\n";
+        std::exit(1);
+    }
+    std::cout << "OK: refinement of a well-conditioned system stays in float\n";
+
+    const std::size_t hilbertSize = 10;
+    Matrix hilbert(hilbertSize, hilbertSize);
+    Vector hilbertRhs(hilbertSize);
+    for (std::size_t i = 0; i < hilbertSize; i++) {
+        double sum = 0.0;
+        for (std::size_t j = 0; j < hilbertSize; j++) {
+            hilbert(i, j) = 1.0 / static_cast<double>(i + j + 1);
+            sum += hilbert(i, j);
+        }
+        hilbertRhs[i] = sum;
+    }
+    const IterativeRefinementResult hilbertResult = IterativeRefinement::solve(LinearSystem(hilbert, hilbertRhs));
+    if (!hilbertResult.fellBack || hilbertResult.backwardError > 1e-15) {
+        std::cerr << "FAIL: refinement of a Hilbert system: fellBack = " << hilbertResult.fellBack
+                  << ", backward error " << hilbertResult.backwardError << "\n";
+        std::exit(1);
+    }
+    std::cout << "OK: refinement of a Hilbert system falls back to double\n";
+
+    Matrix huge(2, 2);
+    huge(0, 0) = 1e300;
+    huge(0, 1) = 1.0;
+    huge(1, 1) = 1e300;
+    const IterativeRefinementResult hugeResult = IterativeRefinement::solve(LinearSystem(huge, Vector{ 1e300, 1e300 }));
+    if (!hugeResult.fellBack) {
+        std::cerr << "FAIL: refinement beyond float range did not fall back\n";
+        std::exit(1);
+    }
+    expectEqual("refinement beyond float range, x1", hugeResult.x[0], 1.0);
+    expectEqual("refinement beyond float range, x2", hugeResult.x[1], 1.0);
+
     std::cout << "All rounding checks passed.\n";
     return 0;
 }
@@ -1,14 +1,20 @@
 #include "NumericalMethods.h"
 
-#include "nlohmann/json.hpp"
+#include "service/RootFindingService.h"
+#include "utils/JsonWriter.h"
 
 #include <cmath>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <cctype>
 #include <optional>
+#include <vector>
 
-using nlohmann::json;
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#endif
 
 static void runEquation1(bool secondInterval)
 {
@@ -87,9 +93,27 @@ int main(int argc, char** argv)
     // Usage:
     //   tema1_rootfinding [--json] [--trace|--no-trace] <eq:1-4> <interval:1|2>
     //   tema1_rootfinding [--json] [--trace|--no-trace] --eq <1-4> [--interval <1|2>] [--a <num> --b <num>] [--x0 <num>] [--eps <num>]
+    //   (JSON mode only) [--parallel | --race] [--threads <n>]
+    //     --parallel runs the four methods concurrently, --race keeps only the first one to converge
+    //   [--columnar <file|->] [--no-compress]
+    //     writes the result as an NMTC columnar container (utils/ColumnarTrace.h) instead of JSON
+    //   [--trace-mode <full|head-tail|stride|lttb>] [--trace-limit <n>]
+    //     keeps only part of each trace (utils/TraceDecimation.h)
+    //   [--timeout-ms <n>]
+    //     deadline for the solve; methods still running report their best iterate and a status
+    //   [--stream]
+    //     newline-delimited JSON progress records, written while the methods run
+    //   --batch <file|-> [--threads <n>]
+    //     solves a JSON array of request objects (the worker's "params" keys) concurrently
+    //     and writes a JSON array of {ok, result|error} in the same order
     bool jsonMode = false;
     bool traceMode = false;
+    bool parallelMode = false;
+    bool raceMode = false;
+    bool compressColumns = true;
+    bool streamMode = false;
     int argi = 1;
+    std::optional<std::string> batchPath;
 
     std::optional<int> eqFlag;
     std::optional<int> intervalFlag;
@@ -97,6 +121,11 @@ int main(int argc, char** argv)
     std::optional<double> bFlag;
     std::optional<double> x0Flag;
     std::optional<double> epsFlag;
+    std::optional<int> threadsFlag;
+    std::optional<std::string> columnarPath;
+    std::string traceModeFlag = "full";
+    std::optional<int> traceLimitFlag;
+    std::optional<double> timeoutFlag;
 
     auto normFlag = [](const char* s) {
         std::string f = s ? std::string(s) : std::string();
@@ -166,6 +195,99 @@ int main(int argc, char** argv)
             argi++;
             continue;
         }
+        if (flag == "--parallel" || flag == "-parallel")
+        {
+            parallelMode = true;
+            argi++;
+            continue;
+        }
+        if (flag == "--race" || flag == "-race")
+        {
+            raceMode = true;
+            argi++;
+            continue;
+        }
+        if (flag == "--columnar")
+        {
+            if (argi + 1 >= argc)
+            {
+                std::cerr << "Missing value for --columnar (a file path or -)\n";
+                return 2;
+            }
+            columnarPath = std::string(argv[argi + 1]);
+            argi += 2;
+            continue;
+        }
+        if (flag == "--batch")
+        {
+            if (argi + 1 >= argc)
+            {
+                std::cerr << "Missing value for --batch (a file path or -)\n";
+                return 2;
+            }
+            batchPath = std::string(argv[argi + 1]);
+            argi += 2;
+            continue;
+        }
+        if (flag == "--stream")
+        {
+            streamMode = true;
+            argi++;
+            continue;
+        }
+        if (flag == "--no-compress")
+        {
+            compressColumns = false;
+            argi++;
+            continue;
+        }
+        if (flag == "--trace-mode")
+        {
+            if (argi + 1 >= argc)
+            {
+                std::cerr << "Missing value for --trace-mode\n";
+                return 2;
+            }
+            traceModeFlag = normFlag(argv[argi + 1]);
+            argi += 2;
+            continue;
+        }
+        if (flag == "--trace-limit")
+        {
+            const auto v = parseIntFlagValue(argi);
+            if (!v || *v <= 0)
+            {
+                std::cerr << "Missing/invalid value for --trace-limit\n";
+                return 2;
+            }
+            traceLimitFlag = *v;
+            argi += 2;
+            continue;
+        }
+        if (flag == "--timeout-ms")
+        {
+            const auto v = parseDoubleFlagValue(argi);
+            if (!v || !(*v > 0.0))
+            {
+                std::cerr << "Missing/invalid value for --timeout-ms\n";
+                return 2;
+            }
+            timeoutFlag = *v;
+            argi += 2;
+            continue;
+        }
+        if (flag == "--threads")
+        {
+            const auto v = parseIntFlagValue(argi);
+            if (!v || *v <= 0)
+            {
+                std::cerr << "Missing/invalid value for --threads\n";
+                return 2;
+            }
+            threadsFlag = *v;
+            argi += 2;
+            continue;
+        }
         if (flag == "--eq")
         {
             const auto v = parseIntFlagValue(argi);
@@ -241,6 +363,40 @@ int main(int argc, char** argv)
         break;
     }
 
+    if (batchPath)
+    {
+        try
+        {
+            nlohmann::json batch;
+            if (*batchPath == "-")
+            {
+                batch = nlohmann::json::parse(std::cin);
+            }
+            else
+            {
+                std::ifstream file(*batchPath);
+                if (!file)
+                {
+                    std::cerr << "Cannot read " << *batchPath << "\n";
+                    return 2;
+                }
+                batch = nlohmann::json::parse(file);
+            }
+            const std::vector<RootFindingRequest> requests = RootFindingService::parseBatch(batch);
+
+            JsonWriter w(std::cout);
+            RootFindingService::solveBatch(requests, w, threadsFlag ? static_cast<std::size_t>(*threadsFlag) : 0);
+            w.flush();
+            std::cout << "\n";
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << "\n";
+            return 2;
+        }
+        return 0;
+    }
+
     int eq = eqFlag.value_or(1);
     int interval = intervalFlag.value_or(1);
 
@@ -256,7 +412,7 @@ int main(int argc, char** argv)
 
     const bool secondInterval = (interval == 2);
 
-    if (!jsonMode)
+    if (!jsonMode && !columnarPath && !streamMode)
     {
         switch (eq) {
     case 1:
@@ -280,174 +436,91 @@ int main(int argc, char** argv)
     }
 
     // JSON mode: emit a stable schema for the frontend.
-    double eps = epsFlag.value_or(1e-7);
-    double a = 0.0;
-    double b = 0.0;
-    std::string statement;
-
-    ScalarEquation equation([](double) { return 0.0; });
-    Function1D derivative([](double) { return 0.0; });
-    double x0 = 0.0;
-
-    if (eq == 1)
-    {
-        statement = "x^2 - 4x + 4 - ln(x) = 0";
-        equation = ScalarEquation([](double x) { return x * x - 4.0 * x + 4.0 - std::log(x); });
-        derivative = [](double x) { return 2.0 * x - 4.0 - 1.0 / x; };
-        a = secondInterval ? 2.0 : 1.0;
-        b = secondInterval ? 4.0 : 2.0;
-    }
-    else if (eq == 2)
+    RootFindingRequest request;
+    request.eq = eq;
+    request.interval = interval;
+    request.a = aFlag;
+    request.b = bFlag;
+    request.x0 = x0Flag;
+    request.eps = epsFlag;
+    request.trace = traceMode;
+    request.timeoutMs = timeoutFlag;
+    if (raceMode)
     {
-        constexpr double pi = 3.14159265358979323846;
-        statement = "x + 1 - 2 sin(pi x) = 0";
-        equation = ScalarEquation([&](double x) { return x + 1.0 - 2.0 * std::sin(pi * x); });
-        derivative = Function1D([&](double x) { return 1.0 - 2.0 * pi * std::cos(pi * x); });
-        a = secondInterval ? 0.5 : 0.0;
-        b = secondInterval ? 1.0 : 0.5;
+        request.mode = RootFindingMode::Race;
     }
-    else if (eq == 3)
+    else if (parallelMode)
     {
-        statement = "e^x - 3x^2 = 0";
-        equation = ScalarEquation([](double x) { return std::exp(x) - 3.0 * x * x; });
-        derivative = [](double x) { return std::exp(x) - 6.0 * x; };
-        a = secondInterval ? 3.0 : 0.0;
-        b = secondInterval ? 5.0 : 1.0;
+        request.mode = RootFindingMode::Parallel;
     }
-    else if (eq == 4)
+    request.threads = threadsFlag ? static_cast<std::size_t>(*threadsFlag) : 0;
+    try
     {
-        statement = "2x cos(2x) - (x-2)^2 = 0";
-        equation = ScalarEquation([](double x) { return 2.0 * x * std::cos(2.0 * x) - (x - 2.0) * (x - 2.0); });
-        derivative = [](double x) {
-            return 2.0 * std::cos(2.0 * x) - 4.0 * x * std::sin(2.0 * x) - 2.0 * (x - 2.0);
-        };
-        a = secondInterval ? 3.0 : 2.0;
-        b = secondInterval ? 4.0 : 3.0;
+        request.decimation = TraceDecimation::parse(traceModeFlag, traceLimitFlag ? static_cast<std::size_t>(*traceLimitFlag) : 0);
     }
-    else
+    catch (const std::exception& e)
     {
-        std::cerr << "Invalid equation. Use 1-4.\n";
+        std::cerr << e.what() << "\n";
         return 2;
     }
 
-    // Optional overrides from CLI.
-    if (aFlag) a = *aFlag;
-    if (bFlag) b = *bFlag;
-    if (!(a < b))
-    {
-        std::cerr << "Invalid interval. Require a < b.\n";
-        return 2;
-    }
-    if (eq == 1 && (a <= 0.0 || b <= 0.0))
+    if (columnarPath)
     {
-        std::cerr << "Invalid interval for eq(1). Require a>0 and b>0 because ln(x).\n";
-        return 2;
-    }
-
-    x0 = x0Flag.value_or((a + b) / 2.0);
-
-    BisectionTrace bisTrace;
-    RegulaFalsiTrace rfTrace;
-    SecantTrace secTrace;
-    NewtonTrace newtTrace;
-
-    const double xBis = RootFinding::bisection(equation, a, b, eps, traceMode ? &bisTrace : nullptr);
-    const double xRf = RootFinding::regulaFalsi(equation, a, b, eps, traceMode ? &rfTrace : nullptr);
-    const double xSec = RootFinding::secant(equation, a, b, eps, traceMode ? &secTrace : nullptr);
-    const double xNew = RootFinding::newton(equation, derivative, x0, eps, traceMode ? &newtTrace : nullptr);
-
-    auto bisTraceToJson = [&](const BisectionTrace& t) {
-        json arr = json::array();
-        for (const auto& s : t.steps)
+        try
         {
-            arr.push_back({
-                { "iter", s.iter },
-                { "a", s.a },
-                { "b", s.b },
-                { "p", s.p },
-                { "fp", s.fp },
-                { "errorBound", s.errorBound }
-            });
+            if (*columnarPath == "-")
+            {
+#if defined(_WIN32)
+                _setmode(_fileno(stdout), _O_BINARY);
+#endif
+                RootFindingService::solveColumnar(request, std::cout, compressColumns);
+            }
+            else
+            {
+                std::ofstream file(*columnarPath, std::ios::binary);
+                if (!file)
+                {
+                    std::cerr << "Cannot write " << *columnarPath << "\n";
+                    return 2;
+                }
+                RootFindingService::solveColumnar(request, file, compressColumns);
+            }
         }
-        return arr;
-    };
-
-    auto rfTraceToJson = [&](const RegulaFalsiTrace& t) {
-        json arr = json::array();
-        for (const auto& s : t.steps)
+        catch (const std::exception& e)
         {
-            arr.push_back({
-                { "iter", s.iter },
-                { "a", s.a },
-                { "b", s.b },
-                { "p", s.p },
-                { "fp", s.fp }
-            });
+            std::cerr << e.what() << "\n";
+            return 2;
         }
-        return arr;
-    };
+        return 0;
+    }
 
-    auto secTraceToJson = [&](const SecantTrace& t) {
-        json arr = json::array();
-        for (const auto& s : t.steps)
+    if (streamMode)
+    {
+        try
         {
-            arr.push_back({
-                { "iter", s.iter },
-                { "x0", s.x0 },
-                { "x1", s.x1 },
-                { "p", s.p },
-                { "fp", s.fp }
-            });
+            // A solver failure is reported by the last record.
+            return RootFindingService::solveStream(request, std::cout) ? 0 : 2;
         }
-        return arr;
-    };
-
-    auto newtTraceToJson = [&](const NewtonTrace& t) {
-        json arr = json::array();
-        for (const auto& s : t.steps)
+        catch (const std::exception& e)
         {
-            arr.push_back({
-                { "iter", s.iter },
-                { "x", s.x },
-                { "fx", s.fx },
-                { "dfx", s.dfx },
-                { "xNext", s.xNext },
-                { "fxNext", s.fxNext }
-            });
+            std::cerr << e.what() << "\n";
+            return 2;
         }
-        return arr;
-    };
+    }
 
-    json j;
-    j["kind"] = "rootfinding";
-    j["referat"] = "01";
-    j["eq"] = eq;
-    j["interval"] = interval;
-    j["eps"] = eps;
-    j["statement"] = statement;
-    j["a"] = a;
-    j["b"] = b;
-    j["traceEnabled"] = traceMode;
-    j["x0"] = x0;
-    j["methods"] = json::array();
-
-    json mBis = { { "name", "bisection" }, { "x", xBis }, { "fx", equation(xBis) } };
-    if (traceMode) mBis["trace"] = bisTraceToJson(bisTrace);
-    j["methods"].push_back(mBis);
-
-    json mRf = { { "name", "regulaFalsi" }, { "x", xRf }, { "fx", equation(xRf) } };
-    if (traceMode) mRf["trace"] = rfTraceToJson(rfTrace);
-    j["methods"].push_back(mRf);
-
-    json mSec = { { "name", "secant" }, { "x", xSec }, { "fx", equation(xSec) } };
-    if (traceMode) mSec["trace"] = secTraceToJson(secTrace);
-    j["methods"].push_back(mSec);
-
-    json mNew = { { "name", "newton" }, { "x", xNew }, { "fx", equation(xNew) } };
-    if (traceMode) mNew["trace"] = newtTraceToJson(newtTrace);
-    j["methods"].push_back(mNew);
-
-    std::cout << j.dump(2) << "\n";
+    try
+    {
+        // Streamed compact output: steps are written as they are computed.
+        JsonWriter w(std::cout);
+        RootFindingService::solve(request, w);
+        w.flush();
+        std::cout << "\n";
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
 
     return 0;
 }
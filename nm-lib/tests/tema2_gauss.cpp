@@ -1,147 +1,13 @@
 #include "NumericalMethods.h"
 
-#include "utils/JsonUtils.h"
+#include "service/LinearSystemsService.h"
 
-#include "nlohmann/json.hpp"
-
-#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <cctype>
-
-using nlohmann::json;
-
-static double residualInf(const Matrix& A, const Vector& x, const Vector& b)
-{
-    const std::size_t n = b.size();
-    double maxAbs = 0.0;
-    for (std::size_t i = 0; i < n; i++)
-    {
-        double s = 0.0;
-        for (std::size_t j = 0; j < n; j++)
-        {
-            s += A(i, j) * x[j];
-        }
-        const double ri = s - b[i];
-        const double ai = std::fabs(ri);
-        if (ai > maxAbs)
-        {
-            maxAbs = ai;
-        }
-    }
-    return maxAbs;
-}
-
-static LinearSystem system1()
-{
-    Matrix A(3, 3);
-    Vector b(3);
-
-    A(0, 0) = 3.03;
-    A(0, 1) = -12.1;
-    A(0, 2) = 14.0;
-    b[0] = -119.0;
-
-    A(1, 0) = -3.03;
-    A(1, 1) = 12.1;
-    A(1, 2) = -7.0;
-    b[1] = 120.0;
-
-    A(2, 0) = 6.11;
-    A(2, 1) = -14.2;
-    A(2, 2) = 21.0;
-    b[2] = -139.0;
-
-    return LinearSystem(A, b);
-}
-
-static LinearSystem system2()
-{
-    Matrix A(3, 3);
-    Vector b(3);
-
-    A(0, 0) = 3.333;
-    A(0, 1) = 15920.0;
-    A(0, 2) = 10.333;
-    b[0] = 7953.0;
-
-    A(1, 0) = 2.222;
-    A(1, 1) = 16.71;
-    A(1, 2) = 9.612;
-    b[1] = 0.965;
-
-    A(2, 0) = -1.5611;
-    A(2, 1) = 5.1792;
-    A(2, 2) = -1.6855;
-    b[2] = 2714.0;
-
-    return LinearSystem(A, b);
-}
-
-static LinearSystem system3()
-{
-    Matrix A(4, 4);
-    Vector b(4);
-
-    A(0, 0) = 2.12;
-    A(0, 1) = -2.12;
-    A(0, 2) = 51.3;
-    A(0, 3) = 100.0;
-    b[0] = 3.14159265358979323846;
-
-    A(1, 0) = 0.333;
-    A(1, 1) = -0.333;
-    A(1, 2) = -12.2;
-    A(1, 3) = 19.7;
-    b[1] = std::sqrt(2.0);
-
-    A(2, 0) = 6.19;
-    A(2, 1) = 8.20;
-    A(2, 2) = -1.0;
-    A(2, 3) = -2.01;
-    b[2] = 0.0;
-
-    A(3, 0) = -5.73;
-    A(3, 1) = 6.12;
-    A(3, 2) = 1.0;
-    A(3, 3) = -1.0;
-    b[3] = -1.0;
-
-    return LinearSystem(A, b);
-}
-
-static LinearSystem system4()
-{
-    Matrix A(4, 4);
-    Vector b(4);
-
-    const double pi = 3.14159265358979323846;
-    A(0, 0) = pi;
-    A(0, 1) = std::sqrt(2.0);
-    A(0, 2) = -1.0;
-    A(0, 3) = 1.0;
-    b[0] = 0.0;
-
-    A(1, 0) = std::exp(1.0);
-    A(1, 1) = -1.0;
-    A(1, 2) = 1.0;
-    A(1, 3) = 2.0;
-    b[1] = 1.0;
-
-    A(2, 0) = 1.0;
-    A(2, 1) = 1.0;
-    A(2, 2) = -std::sqrt(3.0);
-    A(2, 3) = 1.0;
-    b[2] = 2.0;
-
-    A(3, 0) = -1.0;
-    A(3, 1) = -1.0;
-    A(3, 2) = 1.0;
-    A(3, 3) = -std::sqrt(5.0);
-    b[3] = 3.0;
-
-    return LinearSystem(A, b);
-}
+#include <vector>
 
 static void printVector(const Vector& x)
 {
@@ -157,9 +23,12 @@ static void printVector(const Vector& x)
 
 int main(int argc, char** argv)
 {
-    // Usage: tema2_gauss [--json] [--trace|--no-trace] <system:1-4>
+    // Usage: tema2_gauss [--json] [--trace|--no-trace] [--sweep[=<tmin>-<tmax>]] <system:1-4>
+    // --sweep solves for every t in tmin..tmax (default 2-16) concurrently.
     bool jsonMode = false;
     bool traceMode = false;
+    bool sweepMode = false;
+    GaussSweepRequest sweep;
     int argi = 1;
 
     auto normFlag = [](const char* s) {
@@ -200,6 +69,27 @@ int main(int argc, char** argv)
             argi++;
             continue;
         }
+        if (flag == "--sweep" || flag.rfind("--sweep=", 0) == 0)
+        {
+            sweepMode = true;
+            const std::size_t eq = flag.find('=');
+            const std::size_t dash = flag.find('-', eq == std::string::npos ? flag.size() : eq + 1);
+            if (eq != std::string::npos)
+            {
+                try
+                {
+                    sweep.minDigits = std::stoi(flag.substr(eq + 1));
+                    sweep.maxDigits = dash == std::string::npos ? sweep.minDigits : std::stoi(flag.substr(dash + 1));
+                }
+                catch (const std::exception&)
+                {
+                    std::cerr << "Invalid --sweep range. Use --sweep=<tmin>-<tmax>.\n";
+                    return 2;
+                }
+            }
+            argi++;
+            continue;
+        }
         break;
     }
 
@@ -209,81 +99,74 @@ int main(int argc, char** argv)
         which = std::stoi(argv[argi]);
     }
 
-    LinearSystem sys = system1();
-    switch (which) {
-    case 1:
-        sys = system1();
-        break;
-    case 2:
-        sys = system2();
-        break;
-    case 3:
-        sys = system3();
-        break;
-    case 4:
-        sys = system4();
-        break;
-    default:
-        std::cerr << "Invalid system. Use 1-4.\n";
-        return 2;
+    LinearSystem sys = LinearSystemsService::gaussSystem(1);
+    try
+    {
+        sys = LinearSystemsService::gaussSystem(which);
     }
-
-    const int significantDigits = 3;
-    GaussianEliminationTrace trace;
-    Vector x = GaussianElimination::solve(sys, significantDigits, traceMode ? &trace : nullptr);
-
-    if (!jsonMode)
+    catch (const std::invalid_argument& e)
     {
-        std::cout << "Solution x = ";
-        printVector(x);
-        return 0;
+        std::cerr << e.what() << "\n";
+        return 2;
     }
 
-    json j;
-    j["kind"] = "gauss";
-    j["referat"] = "01";
-    j["system"] = which;
-    j["significantDigits"] = significantDigits;
-    j["A"] = matrixToJson(sys.matrix());
-    j["b"] = vectorToJson(sys.rhs());
-    j["x"] = vectorToJson(x);
-    j["residual_inf"] = residualInf(sys.matrix(), x, sys.rhs());
-
-    j["traceEnabled"] = traceMode;
-    if (traceMode)
+    if (sweepMode)
     {
-        json steps = json::array();
-        for (const auto& s : trace.forwardSteps)
+        sweep.system = which;
+        try
         {
-            steps.push_back({
-                { "k", s.k },
-                { "pivotRow", s.pivotRow },
-                { "swapped", s.swapped },
-                { "A", matrixToJson(s.A) },
-                { "b", vectorToJson(s.b) }
-            });
+            if (jsonMode)
+            {
+                JsonWriter w(std::cout);
+                LinearSystemsService::sweepGauss(sweep, w);
+                w.flush();
+                std::cout << "\n";
+                return 0;
+            }
+
+            ThreadPool pool(sweep.threads > 0 ? sweep.threads : ThreadPool::defaultThreadCount());
+            const std::vector<PrecisionSweepRow> rows = PrecisionSweep::run(sys, sweep.minDigits, sweep.maxDigits, pool);
+            std::cout << " t  relative error  residual      growth     time [ms]\n";
+            for (const PrecisionSweepRow& row : rows)
+            {
+                std::cout << std::setw(2) << row.significantDigits << "  ";
+                if (!row.solved)
+                {
+                    std::cout << "failed: " << row.error << "\n";
+                    continue;
+                }
+                std::cout << std::scientific << std::setprecision(3)
+                          << std::setw(14) << row.relativeError << "  "
+                          << std::setw(10) << row.residual << "  "
+                          << std::defaultfloat << std::setprecision(6)
+                          << std::setw(9) << row.growthFactor << "  "
+                          << std::fixed << std::setprecision(3)
+                          << std::setw(9) << row.seconds * 1000.0 << std::defaultfloat << "\n";
+            }
         }
-
-        json ops = json::array();
-        for (const auto& op : trace.operations)
+        catch (const std::exception& e)
         {
-            ops.push_back({
-                { "phase", op.phase },
-                { "op", op.op },
-                { "A", matrixToJson(op.A) },
-                { "b", vectorToJson(op.b) },
-                { "hasSolveValue", op.hasSolveValue },
-                { "solveIndex", op.solveIndex },
-                { "solveValue", op.solveValue }
-            });
+            std::cerr << e.what() << "\n";
+            return 2;
         }
+        return 0;
+    }
 
-        j["trace"] = {
-            { "forwardElimination", steps },
-            { "operations", ops }
-        };
+    GaussRequest request;
+    request.system = which;
+    request.trace = traceMode;
+
+    if (!jsonMode)
+    {
+        Vector x = GaussianElimination::solve(sys, request.significantDigits);
+        std::cout << "Solution x = ";
+        printVector(x);
+        return 0;
     }
 
-    std::cout << j.dump(2) << "\n";
+    JsonWriter w(std::cout);
+    LinearSystemsService::solveGauss(request, w);
+    w.flush();
+    std::cout << "\n";
     return 0;
 }
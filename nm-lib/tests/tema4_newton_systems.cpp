@@ -1,16 +1,19 @@
 #include "NumericalMethods.h"
-#include "utils/JsonUtils.h"
 
-#include "nlohmann/json.hpp"
+#include "service/NewtonSystemsService.h"
+#include "utils/ColumnarTrace.h"
+#include "utils/JsonUtils.h"
 
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <vector>
 #include <cctype>
 
-using nlohmann::json;
-
 static void printVector(const Vector& x)
 {
     std::cout << "[";
@@ -25,154 +28,13 @@ static void printVector(const Vector& x)
     std::cout << "]\n";
 }
 
-static NonlinearSystem system1()
-{
-    // Referat 02 — Tema 2 — (1)
-    // f1 = x1 + 2 x2^2 - x2 - 2 x3 = 0
-    // f2 = x2 - 8 x2^2 + 10 x3 = 0
-    // f3 = x2 (7 x2 x3)^{-1} - 1 = 0  => (for x2 != 0) 1/(7 x3) - 1 = 0
-    VectorFunction F = [](const Vector& x) {
-        Vector fx(3);
-        const double x1 = x[0];
-        const double x2 = x[1];
-        const double x3 = x[2];
-
-        fx[0] = x1 + 2.0 * x2 * x2 - x2 - 2.0 * x3;
-        fx[1] = x2 - 8.0 * x2 * x2 + 10.0 * x3;
-        fx[2] = (1.0 / (7.0 * x3)) - 1.0;
-        return fx;
-    };
-
-    JacobianFunction J = [](const Vector& x) {
-        Matrix jac(3, 3);
-        const double x2 = x[1];
-        const double x3 = x[2];
-
-        jac(0, 0) = 1.0;
-        jac(0, 1) = 4.0 * x2 - 1.0;
-        jac(0, 2) = -2.0;
-
-        jac(1, 0) = 0.0;
-        jac(1, 1) = 1.0 - 16.0 * x2;
-        jac(1, 2) = 10.0;
-
-        jac(2, 0) = 0.0;
-        jac(2, 1) = 0.0;
-        jac(2, 2) = -(1.0 / (7.0 * x3 * x3));
-
-        return jac;
-    };
-
-    return NonlinearSystem(F, J);
-}
-
-static NonlinearSystem system2()
-{
-    // (2)
-    // f1 = x1^2 + x2 - 37 = 0
-    // f2 = x1 - x2^2 - 5 = 0
-    // f3 = x1 + x2 + x3 - 3 = 0
-    VectorFunction F = [](const Vector& x) {
-        Vector fx(3);
-        const double x1 = x[0];
-        const double x2 = x[1];
-        const double x3 = x[2];
-        fx[0] = x1 * x1 + x2 - 37.0;
-        fx[1] = x1 - x2 * x2 - 5.0;
-        fx[2] = x1 + x2 + x3 - 3.0;
-        return fx;
-    };
-
-    JacobianFunction J = [](const Vector& x) {
-        Matrix jac(3, 3);
-        const double x1 = x[0];
-        const double x2 = x[1];
-
-        jac(0, 0) = 2.0 * x1;
-        jac(0, 1) = 1.0;
-        jac(0, 2) = 0.0;
-
-        jac(1, 0) = 1.0;
-        jac(1, 1) = -2.0 * x2;
-        jac(1, 2) = 0.0;
-
-        jac(2, 0) = 1.0;
-        jac(2, 1) = 1.0;
-        jac(2, 2) = 1.0;
-
-        return jac;
-    };
-
-    return NonlinearSystem(F, J);
-}
-
-static NonlinearSystem system3()
-{
-    // (3)
-    // f1 = x1^2 + x2^2 - x1 = 0
-    // f2 = x1^2 - x2^2 - x2 = 0
-    VectorFunction F = [](const Vector& x) {
-        Vector fx(2);
-        const double x1 = x[0];
-        const double x2 = x[1];
-        fx[0] = x1 * x1 + x2 * x2 - x1;
-        fx[1] = x1 * x1 - x2 * x2 - x2;
-        return fx;
-    };
-
-    JacobianFunction J = [](const Vector& x) {
-        Matrix jac(2, 2);
-        const double x1 = x[0];
-        const double x2 = x[1];
-
-        jac(0, 0) = 2.0 * x1 - 1.0;
-        jac(0, 1) = 2.0 * x2;
-
-        jac(1, 0) = 2.0 * x1;
-        jac(1, 1) = -2.0 * x2 - 1.0;
-
-        return jac;
-    };
-
-    return NonlinearSystem(F, J);
-}
-
-static NonlinearSystem system4()
-{
-    // (4)
-    // f1 = 3x1^2 - x2^2 = 0
-    // f2 = 3x1 x2^2 - x1^3 - 1 = 0
-    VectorFunction F = [](const Vector& x) {
-        Vector fx(2);
-        const double x1 = x[0];
-        const double x2 = x[1];
-        fx[0] = 3.0 * x1 * x1 - x2 * x2;
-        fx[1] = 3.0 * x1 * x2 * x2 - x1 * x1 * x1 - 1.0;
-        return fx;
-    };
-
-    JacobianFunction J = [](const Vector& x) {
-        Matrix jac(2, 2);
-        const double x1 = x[0];
-        const double x2 = x[1];
-
-        jac(0, 0) = 6.0 * x1;
-        jac(0, 1) = -2.0 * x2;
-
-        jac(1, 0) = 3.0 * x2 * x2 - 3.0 * x1 * x1;
-        jac(1, 1) = 6.0 * x1 * x2;
-
-        return jac;
-    };
-
-    return NonlinearSystem(F, J);
-}
-
 int main(int argc, char** argv)
 {
-    // Usage: tema4_newton_systems [--json] [--trace|--no-trace] <system:1|2|3|4>
+    // Usage: tema4_newton_systems [--json] [--trace|--no-trace] [--columnar <file>] <system:1|2|3|4>
+    //   --columnar writes the iterations as an NMTC container (utils/ColumnarTrace.h)
     bool jsonMode = false;
     bool traceMode = false;
+    std::string columnarPath;
     int argi = 1;
 
     auto normFlag = [](const char* s) {
@@ -213,6 +75,12 @@ int main(int argc, char** argv)
             argi++;
             continue;
         }
+        if (flag == "--columnar" && argi + 1 < argc)
+        {
+            columnarPath = argv[argi + 1];
+            argi += 2;
+            continue;
+        }
         break;
     }
 
@@ -234,85 +102,98 @@ int main(int argc, char** argv)
         return 2;
     }
 
-    NonlinearSystem sys = system1();
-    Vector x0(3);
-    std::string statement;
-
-    if (which == 1)
-    {
-        sys = system1();
-        x0 = Vector{ 0.3, 0.5, 0.14 };
-        statement = "x1 + 2x2^2 - x2 - 2x3 = 0;  x2 - 8x2^2 + 10x3 = 0;  1/(7x3) - 1 = 0";
-    }
-    else if (which == 2)
-    {
-        sys = system2();
-        x0 = Vector{ 6.0, 6.0, -9.0 };
-        statement = "x1^2 + x2 - 37 = 0;  x1 - x2^2 - 5 = 0;  x1 + x2 + x3 - 3 = 0";
-    }
-    else if (which == 3)
-    {
-        sys = system3();
-        x0 = Vector{ 0.5, 0.5 };
-        statement = "x1^2 + x2^2 - x1 = 0;  x1^2 - x2^2 - x2 = 0";
-    }
-    else if (which == 4)
-    {
-        sys = system4();
-        x0 = Vector{ 1.0, 2.0 };
-        statement = "3x1^2 - x2^2 = 0;  3x1 x2^2 - x1^3 - 1 = 0";
-    }
-    else
-    {
-        std::cerr << "Invalid system. Use 1, 2, 3, or 4.\n";
-        return 2;
-    }
+    const NewtonSystemProblem problem = NewtonSystemsService::problem(which);
+    const NonlinearSystem& sys = problem.system;
+    const Vector& x0 = problem.x0;
+    const std::string& statement = problem.statement;
 
     const double eps = 1e-5;
-    NewtonSystemTrace trace;
-    Vector x = NewtonSolver::solve(sys, x0, eps, traceMode ? &trace : nullptr);
 
-    if (jsonMode)
+    if (!columnarPath.empty())
     {
-        const Vector fx = sys.evaluate(x);
+        std::ofstream file(columnarPath, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "Cannot write " << columnarPath << "\n";
+            return 2;
+        }
 
-        auto traceToJson = [&](const NewtonSystemTrace& t) {
-            json arr = json::array();
-            for (const auto& s : t.steps)
+        // x, fx and delta are n wide per row, jac is n*n (row-major).
+        const std::uint32_t n = static_cast<std::uint32_t>(x0.size());
+        ColumnarTraceWriter columns(file);
+        columns.beginTable("iterations", {
+            { "iter", ColumnType::UInt64, ColumnEncoding::DeltaVarint, 1 },
+            { "x", ColumnType::Float64, ColumnEncoding::Xor, n },
+            { "fx", ColumnType::Float64, ColumnEncoding::Xor, n },
+            { "jac", ColumnType::Float64, ColumnEncoding::Xor, n * n },
+            { "delta", ColumnType::Float64, ColumnEncoding::Xor, n }
+        });
+        std::vector<double> row;
+        auto sink = streamTo([&](const NewtonSystemTraceStep& s) {
+            row.assign(1, static_cast<double>(s.iter));
+            for (std::size_t i = 0; i < n; i++)
+            {
+                row.push_back(s.x[i]);
+            }
+            for (std::size_t i = 0; i < n; i++)
+            {
+                row.push_back(s.fx[i]);
+            }
+            for (std::size_t i = 0; i < n; i++)
             {
-                arr.push_back(json{
-                    { "iter", s.iter },
-                    { "x", vectorToJson(s.x) },
-                    { "fx", vectorToJson(s.fx) },
-                    { "jac", matrixToJson(s.jac) },
-                    { "delta", vectorToJson(s.delta) }
-                });
+                for (std::size_t j = 0; j < n; j++)
+                {
+                    row.push_back(s.jac(i, j));
+                }
             }
-            return arr;
-        };
+            for (std::size_t i = 0; i < n; i++)
+            {
+                row.push_back(s.delta[i]);
+            }
+            columns.addRow(row.data(), row.size());
+        });
+        const Vector x = NewtonSolver::solve(sys, x0, eps, sink);
+        columns.endTable();
 
-        json j;
-        j["kind"] = "newton_systems";
-        j["referat"] = "02";
-        j["system"] = which;
-        j["eps"] = eps;
-        j["statement"] = statement;
-        j["x0"] = vectorToJson(x0);
-        j["x"] = vectorToJson(x);
-        j["fx"] = vectorToJson(fx);
-        j["residual_inf"] = fx.normInf();
+        const Vector fx = sys.evaluate(x);
+        std::ostringstream metadata;
+        JsonWriter w(metadata);
+        w.beginObject();
+        w.field("kind", "newton_systems");
+        w.field("referat", "02");
+        w.field("system", which);
+        w.field("eps", eps);
+        w.field("statement", statement);
+        w.key("x0");
+        writeVector(w, x0);
+        w.key("x");
+        writeVector(w, x);
+        w.key("fx");
+        writeVector(w, fx);
+        w.field("residual_inf", fx.normInf());
+        w.endObject();
+        w.flush();
+        columns.setMetadata(metadata.str());
+        columns.finish();
+        return 0;
+    }
 
-        j["traceEnabled"] = traceMode;
-        if (traceMode)
-        {
-            j["trace"] = {
-                { "iterations", traceToJson(trace) }
-            };
-        }
-        std::cout << j.dump(2) << "\n";
+    if (jsonMode)
+    {
+        NewtonSystemRequest request;
+        request.system = which;
+        request.trace = traceMode;
+        request.eps = eps;
+
+        JsonWriter w(std::cout);
+        NewtonSystemsService::solve(request, w);
+        w.flush();
+        std::cout << "\n";
         return 0;
     }
 
+    Vector x = NewtonSolver::solve(sys, x0, eps);
+
     std::cout << "Solution x = ";
     printVector(x);
     return 0;
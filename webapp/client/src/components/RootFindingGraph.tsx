@@ -3,7 +3,7 @@ import { useEffect, useMemo, useRef, useState } from 'react';
 import { clamp } from '../features/rootfinding/number';
 import { rowsFromStep } from '../features/rootfinding/rows';
 import { computePlotDerived } from '../features/rootfinding/plotDerived';
-import { useRootFindingTrace } from '../features/rootfinding/useRootFindingTrace';
+import { useNmWasm, useRootFindingTrace } from '../features/rootfinding/useRootFindingTrace';
 import type { EqId, IntervalId, RootFindingGraphSpec } from '../features/rootfinding/types';
 
 import { RootFindingHeaderControls } from './rootfinding/RootFindingHeaderControls';
@@ -29,25 +29,34 @@ export function RootFindingGraph({ spec }: { spec: RootFindingGraphSpec }) {
     setIsVizLayout(Boolean(el.closest('.markdownWide')));
   }, []);
 
-  const { loading, error, payload } = useRootFindingTrace({ eq, interval });
+  const { loading, error, payload } = useRootFindingTrace({ eq, interval, live: spec.live });
+  const nm = useNmWasm();
 
   useEffect(() => {
     setIdx(0);
   }, [eq, interval, spec.method]);
 
+  // Keep the position reached by a live stream once it ends.
+  useEffect(() => {
+    if (spec.live && loading) setIdx(Number.MAX_SAFE_INTEGER);
+  }, [spec.live, loading]);
+
   const methodTrace = useMemo(() => {
     const m = payload?.methods?.find((mm) => mm.name === spec.method);
     return m?.trace ?? [];
   }, [payload, spec.method]);
 
   const steps = methodTrace;
-  const safeIdx = clamp(idx, 0, Math.max(0, steps.length - 1));
+  // While a live solve is streaming, show the newest step.
+  const following = Boolean(spec.live) && loading;
+  const safeIdx = following ? Math.max(0, steps.length - 1) : clamp(idx, 0, Math.max(0, steps.length - 1));
   const step = steps[safeIdx];
 
   const derived = useMemo(() => {
     if (!payload) return null;
-    return computePlotDerived({ eq, payload, method: spec.method });
-  }, [payload, eq, spec.method]);
+    const sample = nm ? (xs: Float64Array) => nm.evalEquation(eq, xs) : undefined;
+    return computePlotDerived({ eq, payload, method: spec.method, sample });
+  }, [payload, eq, spec.method, nm]);
 
   const title = spec.title ?? `${spec.method} — ecuația ${eq}, intervalul ${interval}`;
   const rows = useMemo(() => rowsFromStep(step, spec.method), [step, spec.method]);
@@ -1,9 +1,24 @@
-import type { EqId, IntervalId, RootFindingTracePayload } from './types';
+import { readColumnarTrace, rowsOfTable } from './columnarTrace';
+import type {
+  EqId,
+  IntervalId,
+  RootFindingBatchEntry,
+  RootFindingBatchRequest,
+  RootFindingMethod,
+  RootFindingTraceStep,
+  RootFindingTracePayload,
+} from './types';
+
+// The widget plots at most a few hundred points; long traces are thinned by the
+// solver with LTTB so the convergence curve keeps its shape.
+export const TRACE_DECIMATION = { traceMode: 'lttb', traceLimit: 500 } as const;
 
 export function buildRootFindingTraceUrl(params: { eq: EqId; interval: IntervalId }): string {
   const qs = new URLSearchParams();
   qs.set('eq', String(params.eq));
   qs.set('interval', String(params.interval));
+  qs.set('traceMode', TRACE_DECIMATION.traceMode);
+  qs.set('traceLimit', String(TRACE_DECIMATION.traceLimit));
   return `/api/rootfinding/trace?${qs.toString()}`;
 }
 
@@ -11,7 +26,12 @@ export async function fetchRootFindingTrace(params: {
   url: string;
   signal: AbortSignal;
 }): Promise<RootFindingTracePayload> {
-  const res = await fetch(params.url, { signal: params.signal });
+  // Ask for the binary columnar form; servers without it answer with JSON.
+  const url = `${params.url}${params.url.includes('?') ? '&' : '?'}format=columnar`;
+  const res = await fetch(url, { signal: params.signal });
+  if (res.ok && res.headers.get('content-type')?.startsWith('application/x-nmtc')) {
+    return payloadFromColumnar(await res.arrayBuffer());
+  }
   const bodyText = await res.text();
 
   if (!res.ok) {
@@ -26,3 +46,131 @@ export async function fetchRootFindingTrace(params: {
 
   return JSON.parse(bodyText) as RootFindingTracePayload;
 }
+
+// The container's metadata is the JSON payload without traces; each traced
+// method has a table of the same name.
+function payloadFromColumnar(buffer: ArrayBuffer): RootFindingTracePayload {
+  const trace = readColumnarTrace(buffer);
+  const payload = trace.metadata as RootFindingTracePayload;
+  const byName = new Map(trace.tables.map((t) => [t.name, t]));
+  return {
+    ...payload,
+    methods: payload.methods.map((m) => {
+      const table = byName.get(m.name);
+      return table ? { ...m, trace: rowsOfTable(table) as RootFindingTraceStep[] } : m;
+    }),
+  };
+}
+
+// Solves several parameter sets in one round trip (e.g. a parameter sweep).
+// Entries come back in request order; a failed set only fails its own entry.
+export async function fetchRootFindingBatch(params: {
+  requests: RootFindingBatchRequest[];
+  signal?: AbortSignal;
+}): Promise<RootFindingBatchEntry[]> {
+  const res = await fetch('/api/rootfinding/batch', {
+    method: 'POST',
+    headers: { 'Content-Type': 'application/json' },
+    body: JSON.stringify({ requests: params.requests }),
+    signal: params.signal,
+  });
+  const bodyText = await res.text();
+  if (!res.ok) {
+    let msg = bodyText;
+    try {
+      const j = JSON.parse(bodyText) as { error?: string };
+      if (typeof j?.error === 'string') msg = j.error;
+    } catch {
+      // Not JSON; report the raw body.
+    }
+    throw new Error(msg);
+  }
+  return (JSON.parse(bodyText) as { results: RootFindingBatchEntry[] }).results;
+}
+
+export function buildRootFindingStreamUrl(params: { eq: EqId; interval: IntervalId }): string {
+  const qs = new URLSearchParams();
+  qs.set('eq', String(params.eq));
+  qs.set('interval', String(params.interval));
+  return `/api/rootfinding/stream?${qs.toString()}`;
+}
+
+// Records of RootFindingService::solveStream, one per SSE message.
+type StreamRecord =
+  | ({ event: 'header' } & Omit<RootFindingTracePayload, 'methods'>)
+  | { event: 'step'; method: RootFindingMethod['name']; step: RootFindingTraceStep }
+  | { event: 'method'; name: RootFindingMethod['name']; x: number; fx: number; traceSteps?: number }
+  | { event: 'done' }
+  | { event: 'error'; method?: string; error: string };
+
+// Follows a streamed solve. onUpdate gets the payload received so far, at most
+// once per animation frame (trace arrays grow in place between updates).
+// The returned function closes the stream; the server then stops the solver.
+export function streamRootFindingTrace(params: {
+  url: string;
+  onUpdate: (payload: RootFindingTracePayload) => void;
+  onDone: () => void;
+  onError: (message: string) => void;
+}): () => void {
+  const source = new EventSource(params.url);
+  let payload: RootFindingTracePayload | null = null;
+  let frame = 0;
+
+  const close = () => {
+    source.close();
+    if (frame) cancelAnimationFrame(frame);
+    frame = 0;
+  };
+  const publish = () => {
+    frame = 0;
+    if (payload) params.onUpdate({ ...payload, methods: payload.methods.map((m) => ({ ...m })) });
+  };
+  const methodNamed = (name: RootFindingMethod['name']): RootFindingMethod => {
+    if (!payload) throw new Error('Stream record before the header.');
+    let m = payload.methods.find((mm) => mm.name === name);
+    if (!m) {
+      m = { name, trace: [] };
+      payload.methods.push(m);
+    }
+    return m;
+  };
+
+  source.onmessage = (ev: MessageEvent<string>) => {
+    const record = JSON.parse(ev.data) as StreamRecord;
+    switch (record.event) {
+      case 'header': {
+        const { event: _event, ...header } = record;
+        payload = { ...header, methods: [] };
+        break;
+      }
+      case 'step':
+        (methodNamed(record.method).trace ??= []).push(record.step);
+        break;
+      case 'method': {
+        const m = methodNamed(record.name);
+        m.x = record.x;
+        m.fx = record.fx;
+        if (record.traceSteps !== undefined) m.traceSteps = record.traceSteps;
+        break;
+      }
+      case 'done':
+        close();
+        publish();
+        params.onDone();
+        return;
+      case 'error':
+        close();
+        publish();
+        params.onError(record.method ? `${record.method}: ${record.error}` : record.error);
+        return;
+    }
+    if (!frame) frame = requestAnimationFrame(publish);
+  };
+  // The server ends every stream with done/error, so this is a lost or refused connection.
+  source.onerror = () => {
+    close();
+    params.onError('Lost the connection to the solver stream.');
+  };
+
+  return close;
+}
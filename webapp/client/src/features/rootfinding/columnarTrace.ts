@@ -0,0 +1,224 @@
+// Reader for NMTC columnar trace containers (nm-lib/include/utils/ColumnarTrace.h),
+// served by /api/rootfinding/trace?format=columnar. Columns come back as Float64Arrays;
+// raw single-block columns are views over the response buffer (no copy).
+
+export type ColumnarTable = {
+  name: string;
+  rowCount: number;
+  // Column name -> rowCount * width values (row-major when width > 1).
+  columns: Record<string, Float64Array>;
+  widths: Record<string, number>;
+};
+
+export type ColumnarTrace = {
+  metadata: unknown;
+  tables: ColumnarTable[];
+};
+
+const MAGIC = 'NMTC';
+const TYPE_FLOAT64 = 1;
+const ENC_RAW = 0;
+const ENC_XOR = 1;
+const ENC_DELTA_VARINT = 2;
+
+type ColumnInfo = { name: string; type: number; encoding: number; width: number };
+type BlockInfo = { rowCount: number; offsets: number[]; lengths: number[] };
+
+class Cursor {
+  constructor(
+    private view: DataView,
+    public pos: number,
+  ) {}
+
+  u8(): number {
+    return this.view.getUint8(this.pos++);
+  }
+  u16(): number {
+    const v = this.view.getUint16(this.pos, true);
+    this.pos += 2;
+    return v;
+  }
+  u32(): number {
+    const v = this.view.getUint32(this.pos, true);
+    this.pos += 4;
+    return v;
+  }
+  u64(): number {
+    const lo = this.view.getUint32(this.pos, true);
+    const hi = this.view.getUint32(this.pos + 4, true);
+    this.pos += 8;
+    return hi * 2 ** 32 + lo;
+  }
+  text(n: number): string {
+    const bytes = new Uint8Array(this.view.buffer, this.view.byteOffset + this.pos, n);
+    this.pos += n;
+    return new TextDecoder().decode(bytes);
+  }
+}
+
+function magicAt(view: DataView, pos: number): boolean {
+  for (let i = 0; i < 4; i++) {
+    if (view.getUint8(pos + i) !== MAGIC.charCodeAt(i)) return false;
+  }
+  return true;
+}
+
+// MSB-first bit reader over one Xor chunk.
+class BitReader {
+  private bit = 0;
+  constructor(private bytes: Uint8Array) {}
+
+  // n <= 32
+  read(n: number): number {
+    let v = 0;
+    while (n > 0) {
+      const byte = this.bit >>> 3;
+      if (byte >= this.bytes.length) throw new Error('Truncated Xor chunk.');
+      const offset = this.bit & 7;
+      const room = 8 - offset;
+      const take = n < room ? n : room;
+      const chunk = (this.bytes[byte] >>> (room - take)) & ((1 << take) - 1);
+      v = v * (1 << take) + chunk;
+      this.bit += take;
+      n -= take;
+    }
+    return v >>> 0;
+  }
+}
+
+function decodeXor(bytes: Uint8Array, count: number, width: number, out: DataView, outIndex: number): void {
+  const prevHi = new Uint32Array(width);
+  const prevLo = new Uint32Array(width);
+  const bits = new BitReader(bytes);
+  for (let i = 0; i < count; i++) {
+    const c = i % width;
+    if (bits.read(1)) {
+      const lz = bits.read(6);
+      const len = bits.read(6) + 1;
+      const tz = 64 - lz - len;
+      let hi = len > 32 ? bits.read(len - 32) : 0;
+      let lo = bits.read(len > 32 ? 32 : len);
+      if (tz >= 32) {
+        hi = tz === 64 ? 0 : lo << (tz - 32);
+        lo = 0;
+      } else if (tz > 0) {
+        hi = (hi << tz) | (lo >>> (32 - tz));
+        lo = lo << tz;
+      }
+      prevHi[c] = (prevHi[c] ^ hi) >>> 0;
+      prevLo[c] = (prevLo[c] ^ lo) >>> 0;
+    }
+    out.setUint32((outIndex + i) * 8, prevLo[c], true);
+    out.setUint32((outIndex + i) * 8 + 4, prevHi[c], true);
+  }
+}
+
+function decodeDeltaVarint(bytes: Uint8Array, count: number, width: number, out: Float64Array, outIndex: number): void {
+  const prev = new Float64Array(width);
+  let pos = 0;
+  for (let i = 0; i < count; i++) {
+    let z = 0;
+    let scale = 1;
+    for (;;) {
+      if (pos >= bytes.length) throw new Error('Truncated varint chunk.');
+      const b = bytes[pos++];
+      z += (b & 0x7f) * scale;
+      if (!(b & 0x80)) break;
+      scale *= 128;
+    }
+    const delta = z % 2 === 1 ? -(z + 1) / 2 : z / 2;
+    const c = i % width;
+    prev[c] += delta;
+    out[outIndex + i] = prev[c];
+  }
+}
+
+export function readColumnarTrace(buffer: ArrayBuffer): ColumnarTrace {
+  const view = new DataView(buffer);
+  const size = buffer.byteLength;
+  if (size < 24 || !magicAt(view, 0) || !magicAt(view, size - 4)) {
+    throw new Error('Not an NMTC trace.');
+  }
+  if (view.getUint16(4, true) !== 1) throw new Error('Unsupported NMTC version.');
+
+  const footerOffset = new Cursor(view, size - 12).u64();
+  const c = new Cursor(view, footerOffset);
+  const metadataText = c.text(c.u32());
+  const metadata: unknown = metadataText ? JSON.parse(metadataText) : null;
+
+  const tables: ColumnarTable[] = [];
+  const tableCount = c.u32();
+  for (let t = 0; t < tableCount; t++) {
+    const name = c.text(c.u16());
+    const rowCount = c.u64();
+    const columnInfo: ColumnInfo[] = [];
+    const columnCount = c.u16();
+    for (let k = 0; k < columnCount; k++) {
+      const colName = c.text(c.u16());
+      const type = c.u8();
+      const encoding = c.u8();
+      const width = c.u32();
+      columnInfo.push({ name: colName, type, encoding, width });
+    }
+    const blocks: BlockInfo[] = [];
+    const blockCount = c.u32();
+    for (let b = 0; b < blockCount; b++) {
+      const block: BlockInfo = { rowCount: c.u64(), offsets: [], lengths: [] };
+      for (let k = 0; k < columnCount; k++) {
+        block.offsets.push(c.u64());
+        block.lengths.push(c.u64());
+      }
+      blocks.push(block);
+    }
+
+    const columns: Record<string, Float64Array> = {};
+    const widths: Record<string, number> = {};
+    columnInfo.forEach((col, k) => {
+      widths[col.name] = col.width;
+      const raw64 = col.type === TYPE_FLOAT64 && col.encoding === ENC_RAW;
+      if (raw64 && blocks.length === 1) {
+        columns[col.name] = new Float64Array(buffer, blocks[0].offsets[k], blocks[0].rowCount * col.width);
+        return;
+      }
+      const out = new Float64Array(rowCount * col.width);
+      const outView = new DataView(out.buffer);
+      let index = 0;
+      for (const block of blocks) {
+        const count = block.rowCount * col.width;
+        const bytes = new Uint8Array(buffer, block.offsets[k], block.lengths[k]);
+        if (col.encoding === ENC_RAW) {
+          const src = new DataView(buffer, block.offsets[k], count * 8);
+          for (let i = 0; i < count; i++) {
+            out[index + i] = raw64
+              ? src.getFloat64(i * 8, true)
+              : src.getUint32(i * 8 + 4, true) * 2 ** 32 + src.getUint32(i * 8, true);
+          }
+        } else if (col.encoding === ENC_XOR) {
+          decodeXor(bytes, count, col.width, outView, index);
+        } else if (col.encoding === ENC_DELTA_VARINT) {
+          decodeDeltaVarint(bytes, count, col.width, out, index);
+        } else {
+          throw new Error(`Unknown NMTC column encoding ${col.encoding}.`);
+        }
+        index += count;
+      }
+      columns[col.name] = out;
+    });
+
+    tables.push({ name, rowCount, columns, widths });
+  }
+
+  return { metadata, tables };
+}
+
+// Row objects for one table (width-1 columns only), e.g. for the step tables.
+export function rowsOfTable(table: ColumnarTable): Array<Record<string, number>> {
+  const keys = Object.keys(table.columns).filter((k) => table.widths[k] === 1);
+  const rows: Array<Record<string, number>> = new Array(table.rowCount);
+  for (let i = 0; i < table.rowCount; i++) {
+    const row: Record<string, number> = {};
+    for (const k of keys) row[k] = table.columns[k][i];
+    rows[i] = row;
+  }
+  return rows;
+}
@@ -17,6 +17,8 @@ export function clampInterval(v: number): IntervalId {
   return 1;
 }
 
+// TypeScript copy of the nm-lib equations, only used to sample the plot when the
+// WASM build (features/rootfinding/wasm.ts) is not available.
 export function evalEquation(eq: EqId, x: number): number {
   switch (eq) {
     case 1:
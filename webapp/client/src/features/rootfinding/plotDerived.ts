@@ -17,6 +17,8 @@ export function computePlotDerived(params: {
   eq: EqId;
   payload: RootFindingTracePayload;
   method: RootFindingMethodName;
+  // Batch evaluator for f (the WASM build of the library); falls back to evalEquation.
+  sample?: (xs: Float64Array) => Float64Array;
 }): PlotDerived {
   const xs = getAllXValues(params.eq, params.payload, params.method);
   let xMin = Math.min(...xs);
@@ -26,13 +28,18 @@ export function computePlotDerived(params: {
   if (params.eq === 1) xMin = Math.max(xMin, 1e-6);
 
   const samples = 520;
-  const pts: PlotPoint[] = [];
+  const xsGrid = new Float64Array(samples);
   for (let i = 0; i < samples; i++) {
     const t = i / (samples - 1);
-    const x = xMin + (xMax - xMin) * t;
-    const y = evalEquation(params.eq, x);
+    xsGrid[i] = xMin + (xMax - xMin) * t;
+  }
+  const ysGrid = params.sample ? params.sample(xsGrid) : xsGrid.map((x) => evalEquation(params.eq, x));
+
+  const pts: PlotPoint[] = [];
+  for (let i = 0; i < samples; i++) {
+    const y = ysGrid[i];
     if (!Number.isFinite(y)) continue;
-    pts.push({ x, y });
+    pts.push({ x: xsGrid[i], y });
   }
 
   let yMin = Infinity;
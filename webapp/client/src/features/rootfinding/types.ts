@@ -10,7 +10,13 @@ export type RootFindingTraceStep =
 
 export type RootFindingMethod = {
   name: RootFindingMethodName;
+  // Set when the solver's deadline stopped the method; x is its last iterate.
+  status?: 'cancelled' | 'deadlineExceeded';
+  // Steps the method ran; present when the trace was decimated.
+  traceSteps?: number;
   trace?: RootFindingTraceStep[];
+  x?: number;
+  fx?: number;
 };
 
 export type RootFindingTracePayload = {
@@ -23,13 +29,33 @@ export type RootFindingTracePayload = {
   b: number;
   x0?: number;
   traceEnabled: boolean;
+  traceMode?: 'head-tail' | 'stride' | 'lttb';
+  traceLimit?: number;
+  timeoutMs?: number;
   methods: RootFindingMethod[];
 };
 
+// One parameter set of POST /api/rootfinding/batch.
+export type RootFindingBatchRequest = {
+  eq: EqId;
+  interval: IntervalId;
+  a?: number;
+  b?: number;
+  x0?: number;
+  eps?: number;
+  trace?: boolean;
+  traceMode?: 'full' | 'head-tail' | 'stride' | 'lttb';
+  traceLimit?: number;
+};
+
+export type RootFindingBatchEntry = { ok: true; result: RootFindingTracePayload } | { ok: false; error: string };
+
 export type RootFindingGraphSpec = {
   type: 'rootfinding-graph';
   title?: string;
   eq: EqId;
   interval: IntervalId;
   method: RootFindingMethodName;
+  // Stream the solve from /api/rootfinding/stream and draw steps as they arrive.
+  live?: boolean;
 };
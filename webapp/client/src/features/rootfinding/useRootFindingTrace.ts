@@ -1,9 +1,16 @@
 import { useEffect, useMemo, useRef, useState } from 'react';
-import { buildRootFindingTraceUrl, fetchRootFindingTrace } from './api';
+import { buildRootFindingStreamUrl, buildRootFindingTraceUrl, fetchRootFindingTrace, streamRootFindingTrace } from './api';
 import type { EqId, IntervalId, RootFindingTracePayload } from './types';
+import { loadNmWasm, solveRootFindingLocally, type NmWasm } from './wasm';
 
-export function useRootFindingTrace(params: { eq: EqId; interval: IntervalId }) {
-  const requestUrl = useMemo(() => buildRootFindingTraceUrl(params), [params.eq, params.interval]);
+// With `live` the solve is streamed (see streamRootFindingTrace): payload grows
+// while loading is true, and the stream is closed when the params change or
+// the component unmounts.
+export function useRootFindingTrace(params: { eq: EqId; interval: IntervalId; live?: boolean }) {
+  const requestUrl = useMemo(
+    () => (params.live ? buildRootFindingStreamUrl(params) : buildRootFindingTraceUrl(params)),
+    [params.eq, params.interval, params.live],
+  );
 
   const [loading, setLoading] = useState(true);
   const [error, setError] = useState<string>('');
@@ -19,8 +26,25 @@ export function useRootFindingTrace(params: { eq: EqId; interval: IntervalId })
     setLoading(true);
     setError('');
 
-    fetchRootFindingTrace({ url: requestUrl, signal: ac.signal })
+    if (params.live) {
+      setPayload(null);
+      const stop = streamRootFindingTrace({
+        url: requestUrl,
+        onUpdate: setPayload,
+        onDone: () => setLoading(false),
+        onError: (message) => {
+          setError(message);
+          setLoading(false);
+        },
+      });
+      return stop;
+    }
+
+    // Solve in the browser when the WASM build is available, otherwise ask the API.
+    solveRootFindingLocally({ eq: params.eq, interval: params.interval })
+      .then((local) => local ?? fetchRootFindingTrace({ url: requestUrl, signal: ac.signal }))
       .then((j) => {
+        if (ac.signal.aborted) return;
         setPayload(j);
       })
       .catch((e: unknown) => {
@@ -39,3 +63,20 @@ export function useRootFindingTrace(params: { eq: EqId; interval: IntervalId })
 
   return { requestUrl, loading, error, payload };
 }
+
+// The WASM module once it has loaded (null while loading or when not built).
+export function useNmWasm(): NmWasm | null {
+  const [nm, setNm] = useState<NmWasm | null>(null);
+
+  useEffect(() => {
+    let alive = true;
+    loadNmWasm().then((m) => {
+      if (alive) setNm(m);
+    });
+    return () => {
+      alive = false;
+    };
+  }, []);
+
+  return nm;
+}
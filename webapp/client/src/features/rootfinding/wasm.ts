@@ -0,0 +1,39 @@
+import type { EqId, IntervalId, RootFindingTracePayload } from './types';
+import { TRACE_DECIMATION } from './api';
+
+// Client-side nm-lib (WebAssembly build from webapp/wasm, served from /wasm/).
+// When the module has not been built the loaders resolve to null and callers
+// fall back to the API / the TypeScript equation definitions.
+
+export type NmWasm = {
+  solveRootFinding(paramsJson: string): string;
+  evalEquation(eq: number, xs: Float64Array): Float64Array;
+};
+
+type NmWasmFactory = () => Promise<NmWasm>;
+
+let modulePromise: Promise<NmWasm | null> | null = null;
+
+export function loadNmWasm(): Promise<NmWasm | null> {
+  if (!modulePromise) {
+    const url = new URL('/wasm/nmlib.mjs', window.location.origin).href;
+    modulePromise = import(/* @vite-ignore */ url)
+      .then((m: { default: NmWasmFactory }) => m.default())
+      .catch(() => null);
+  }
+  return modulePromise;
+}
+
+export async function solveRootFindingLocally(params: {
+  eq: EqId;
+  interval: IntervalId;
+}): Promise<RootFindingTracePayload | null> {
+  const nm = await loadNmWasm();
+  if (!nm) return null;
+
+  const r = JSON.parse(nm.solveRootFinding(JSON.stringify({ eq: params.eq, interval: params.interval, trace: true, ...TRACE_DECIMATION }))) as
+    | { ok: true; result: RootFindingTracePayload }
+    | { ok: false; error: string };
+  if (!r.ok) throw new Error(r.error);
+  return r.result;
+}
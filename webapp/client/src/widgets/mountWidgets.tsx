@@ -18,13 +18,14 @@ function parseWidgetJson(text: string): WidgetSpec | null {
       const interval = Number(parsed.interval);
       const method = typeof parsed.method === 'string' ? parsed.method : '';
       const title = typeof parsed.title === 'string' ? parsed.title : undefined;
+      const live = parsed.live === true;
 
       const isEq = eq === 1 || eq === 2 || eq === 3 || eq === 4;
       const isInterval = interval === 1 || interval === 2;
       const isMethod = method === 'bisection' || method === 'regulaFalsi' || method === 'secant' || method === 'newton';
       if (!isEq || !isInterval || !isMethod) return null;
 
-      return { type: 'rootfinding-graph', title, eq, interval, method };
+      return { type: 'rootfinding-graph', title, eq, interval, method, live };
     }
 
     return null;
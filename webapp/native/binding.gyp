@@ -0,0 +1,53 @@
+{
+  "targets": [
+    {
+      "target_name": "nmlib",
+      "sources": [
+        "src/addon.cpp",
+        "../../nm-lib/src/core/AlignedAllocator.cpp",
+        "../../nm-lib/src/core/Arena.cpp",
+        "../../nm-lib/src/core/Decimal.cpp",
+        "../../nm-lib/src/core/DoubleDouble.cpp",
+        "../../nm-lib/src/core/Matrix.cpp",
+        "../../nm-lib/src/core/Vector.cpp",
+        "../../nm-lib/src/linear/GaussSeidel.cpp",
+        "../../nm-lib/src/linear/GaussianElimination.cpp",
+        "../../nm-lib/src/linear/IterativeRefinement.cpp",
+        "../../nm-lib/src/linear/Jacobi.cpp",
+        "../../nm-lib/src/linear/LinearSystem.cpp",
+        "../../nm-lib/src/linear/PrecisionSweep.cpp",
+        "../../nm-lib/src/nonlinear/MethodRace.cpp",
+        "../../nm-lib/src/nonlinear/Newton.cpp",
+        "../../nm-lib/src/nonlinear/NonlinearSystem.cpp",
+        "../../nm-lib/src/nonlinear/RootFinding.cpp",
+        "../../nm-lib/src/nonlinear/ScalarEquation.cpp",
+        "../../nm-lib/src/service/LinearSystemsService.cpp",
+        "../../nm-lib/src/service/NewtonSystemsService.cpp",
+        "../../nm-lib/src/service/RootFindingService.cpp",
+        "../../nm-lib/src/utils/ColumnarTrace.cpp",
+        "../../nm-lib/src/utils/JsonWriter.cpp",
+        "../../nm-lib/src/utils/Rounding.cpp",
+        "../../nm-lib/src/utils/ThreadPool.cpp",
+        "../../nm-lib/src/utils/TraceDecimation.cpp"
+      ],
+      "include_dirs": [
+        "../../nm-lib/include",
+        "../../nm-lib/src"
+      ],
+      "cflags!": ["-fno-exceptions", "-fno-rtti"],
+      "cflags_cc!": ["-fno-exceptions", "-fno-rtti"],
+      "cflags_cc": ["-std=c++17", "-O2"],
+      "xcode_settings": {
+        "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
+        "GCC_ENABLE_CPP_RTTI": "YES",
+        "CLANG_CXX_LANGUAGE_STANDARD": "c++17"
+      },
+      "msvs_settings": {
+        "VCCLCompilerTool": {
+          "ExceptionHandling": 1,
+          "AdditionalOptions": ["/std:c++17"]
+        }
+      }
+    }
+  ]
+}
@@ -0,0 +1,2 @@
+// Loads the compiled addon (build/Release/nmlib.node).
+module.exports = require('./build/Release/nmlib.node');
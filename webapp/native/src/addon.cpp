@@ -0,0 +1,991 @@
+// Node-API addon exposing nm-lib solvers in-process.
+//
+// Every solver call returns a Promise. Inputs are copied on the JS thread,
+// the solve runs on the libuv threadpool (napi_async_work), and results come
+// back as plain objects whose vectors and traces are Float64Arrays:
+//
+//   rootFinding({ eq, interval, a?, b?, x0?, eps?, trace?, traceMode?, traceLimit?, timeoutMs? })
+//     -> { eq, interval, eps, statement, a, b, x0, traceEnabled, traceMode?, traceLimit?, timeoutMs?,
+//          methods: [{ name, status?, x, fx, traceSteps?, trace?: { iter, a, b, p, ... } }] }
+//   rootFindingColumnar({ ...same params, compress? }) -> Buffer (NMTC container)
+//   rootFindingBatch([params, ...], threads?)
+//     -> [{ ok: true, result: <rootFinding result> } | { ok: false, error }, ...] in input order
+//   gaussianElimination(A, b, significantDigits) -> { x }
+//   jacobi(A, b, x0, iterations, trace?)          -> { x, trace?: { iter, x } }
+//   gaussSeidel(A, b, x0, iterations, trace?)     -> { x, trace?: { iter, x } }
+//   newtonSystem({ system, eps?, trace? })
+//     -> { system, statement, x0, x, fx, trace?: { iter, x, fx, jac, delta } }
+//
+// Matrices are row-major Float64Arrays of length n*n; per-step vectors in a
+// trace are concatenated (step k of an n-vector lives at [k*n, (k+1)*n)).
+
+#include <node_api.h>
+
+#include "NumericalMethods.h"
+
+#include "service/NewtonSystemsService.h"
+#include "service/RootFindingService.h"
+
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+// ---- small N-API helpers --------------------------------------------------
+
+struct JsError
+{
+    std::string message;
+};
+
+void check(napi_env env, napi_status status)
+{
+    if (status != napi_ok)
+    {
+        const napi_extended_error_info* info = nullptr;
+        napi_get_last_error_info(env, &info);
+        throw JsError{ (info && info->error_message) ? info->error_message : "N-API call failed" };
+    }
+}
+
+napi_value makeNumber(napi_env env, double v)
+{
+    napi_value out;
+    check(env, napi_create_double(env, v, &out));
+    return out;
+}
+
+napi_value makeString(napi_env env, const std::string& s)
+{
+    napi_value out;
+    check(env, napi_create_string_utf8(env, s.c_str(), s.size(), &out));
+    return out;
+}
+
+napi_value makeBool(napi_env env, bool v)
+{
+    napi_value out;
+    check(env, napi_get_boolean(env, v, &out));
+    return out;
+}
+
+napi_value makeFloat64Array(napi_env env, const double* data, std::size_t count)
+{
+    void* raw = nullptr;
+    napi_value buffer;
+    check(env, napi_create_arraybuffer(env, count * sizeof(double), &raw, &buffer));
+    if (count)
+    {
+        std::memcpy(raw, data, count * sizeof(double));
+    }
+    napi_value out;
+    check(env, napi_create_typedarray(env, napi_float64_array, count, buffer, 0, &out));
+    return out;
+}
+
+napi_value makeFloat64Array(napi_env env, const std::vector<double>& v)
+{
+    return makeFloat64Array(env, v.data(), v.size());
+}
+
+napi_value makeFloat64Array(napi_env env, const Vector& v)
+{
+    std::vector<double> tmp(v.size());
+    for (std::size_t i = 0; i < v.size(); i++)
+    {
+        tmp[i] = v[i];
+    }
+    return makeFloat64Array(env, tmp);
+}
+
+void setNamed(napi_env env, napi_value obj, const char* key, napi_value value)
+{
+    check(env, napi_set_named_property(env, obj, key, value));
+}
+
+napi_value makeObject(napi_env env)
+{
+    napi_value out;
+    check(env, napi_create_object(env, &out));
+    return out;
+}
+
+std::optional<napi_value> getNamed(napi_env env, napi_value obj, const char* key)
+{
+    bool has = false;
+    check(env, napi_has_named_property(env, obj, key, &has));
+    if (!has)
+    {
+        return std::nullopt;
+    }
+    napi_value v;
+    check(env, napi_get_named_property(env, obj, key, &v));
+    napi_valuetype type;
+    check(env, napi_typeof(env, v, &type));
+    if (type == napi_undefined || type == napi_null)
+    {
+        return std::nullopt;
+    }
+    return v;
+}
+
+double toNumber(napi_env env, napi_value v, const char* what)
+{
+    napi_valuetype type;
+    check(env, napi_typeof(env, v, &type));
+    if (type != napi_number)
+    {
+        throw JsError{ std::string("Invalid ") + what + ". Must be a number." };
+    }
+    double out = 0.0;
+    check(env, napi_get_value_double(env, v, &out));
+    return out;
+}
+
+std::optional<double> optionalNumber(napi_env env, napi_value obj, const char* key)
+{
+    const auto v = getNamed(env, obj, key);
+    if (!v)
+    {
+        return std::nullopt;
+    }
+    return toNumber(env, *v, key);
+}
+
+bool optionalBool(napi_env env, napi_value obj, const char* key, bool fallback)
+{
+    const auto v = getNamed(env, obj, key);
+    if (!v)
+    {
+        return fallback;
+    }
+    bool out = fallback;
+    check(env, napi_get_value_bool(env, *v, &out));
+    return out;
+}
+
+std::optional<std::string> optionalString(napi_env env, napi_value obj, const char* key)
+{
+    const auto v = getNamed(env, obj, key);
+    if (!v)
+    {
+        return std::nullopt;
+    }
+    napi_valuetype type;
+    check(env, napi_typeof(env, *v, &type));
+    if (type != napi_string)
+    {
+        throw JsError{ std::string("Invalid ") + key + ". Must be a string." };
+    }
+    std::size_t length = 0;
+    check(env, napi_get_value_string_utf8(env, *v, nullptr, 0, &length));
+    std::string out(length, '\0');
+    check(env, napi_get_value_string_utf8(env, *v, out.data(), length + 1, &length));
+    return out;
+}
+
+std::vector<double> toDoubles(napi_env env, napi_value v, const char* what)
+{
+    bool isTyped = false;
+    check(env, napi_is_typedarray(env, v, &isTyped));
+    if (isTyped)
+    {
+        napi_typedarray_type type;
+        std::size_t length = 0;
+        void* data = nullptr;
+        check(env, napi_get_typedarray_info(env, v, &type, &length, &data, nullptr, nullptr));
+        if (type != napi_float64_array)
+        {
+            throw JsError{ std::string("Invalid ") + what + ". Expected a Float64Array." };
+        }
+        const double* d = static_cast<const double*>(data);
+        return std::vector<double>(d, d + length);
+    }
+
+    bool isArray = false;
+    check(env, napi_is_array(env, v, &isArray));
+    if (!isArray)
+    {
+        throw JsError{ std::string("Invalid ") + what + ". Expected a Float64Array or number[]." };
+    }
+    uint32_t length = 0;
+    check(env, napi_get_array_length(env, v, &length));
+    std::vector<double> out(length);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        napi_value el;
+        check(env, napi_get_element(env, v, i, &el));
+        out[i] = toNumber(env, el, what);
+    }
+    return out;
+}
+
+Vector toVector(const std::vector<double>& v)
+{
+    Vector out(v.size());
+    for (std::size_t i = 0; i < v.size(); i++)
+    {
+        out[i] = v[i];
+    }
+    return out;
+}
+
+LinearSystem toLinearSystem(const std::vector<double>& a, const std::vector<double>& b)
+{
+    const std::size_t n = b.size();
+    if (n == 0 || a.size() != n * n)
+    {
+        throw JsError{ "Invalid system. A must have length n*n where n = b.length > 0." };
+    }
+    Matrix A(n, n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        for (std::size_t j = 0; j < n; j++)
+        {
+            A(i, j) = a[i * n + j];
+        }
+    }
+    return LinearSystem(A, toVector(b));
+}
+
+napi_value getArg(napi_env env, napi_callback_info info, std::size_t index, std::size_t expected, std::vector<napi_value>& args)
+{
+    if (args.empty())
+    {
+        std::size_t argc = expected;
+        args.resize(expected);
+        check(env, napi_get_cb_info(env, info, &argc, args.data(), nullptr, nullptr));
+        if (argc < expected)
+        {
+            napi_value undef;
+            check(env, napi_get_undefined(env, &undef));
+            for (std::size_t i = argc; i < expected; i++)
+            {
+                args[i] = undef;
+            }
+        }
+    }
+    return args[index];
+}
+
+// ---- async job plumbing ---------------------------------------------------
+
+// A job copies its inputs on the JS thread (constructor), solves on a
+// threadpool thread (execute) and builds the JS result back on the JS thread
+// (result). Library exceptions become Promise rejections with code
+// "NM_SOLVER_ERROR" so callers can tell bad input from internal failures.
+class Job {
+public:
+    virtual ~Job() = default;
+    virtual void execute() = 0;
+    virtual napi_value result(napi_env env) = 0;
+
+    napi_async_work work = nullptr;
+    napi_deferred deferred = nullptr;
+    std::string error;
+};
+
+void executeJob(napi_env, void* data)
+{
+    Job* job = static_cast<Job*>(data);
+    try
+    {
+        job->execute();
+    }
+    catch (const std::exception& e)
+    {
+        job->error = e.what();
+    }
+    catch (...)
+    {
+        job->error = "unknown solver error";
+    }
+}
+
+void completeJob(napi_env env, napi_status, void* data)
+{
+    std::unique_ptr<Job> job(static_cast<Job*>(data));
+
+    napi_value settled = nullptr;
+    bool ok = job->error.empty();
+    if (ok)
+    {
+        try
+        {
+            settled = job->result(env);
+        }
+        catch (const JsError& e)
+        {
+            ok = false;
+            job->error = e.message;
+        }
+    }
+
+    if (ok)
+    {
+        napi_resolve_deferred(env, job->deferred, settled);
+    }
+    else
+    {
+        napi_value message;
+        napi_value code;
+        napi_value err;
+        napi_create_string_utf8(env, job->error.c_str(), job->error.size(), &message);
+        napi_create_string_utf8(env, "NM_SOLVER_ERROR", NAPI_AUTO_LENGTH, &code);
+        napi_create_error(env, code, message, &err);
+        napi_reject_deferred(env, job->deferred, err);
+    }
+
+    napi_delete_async_work(env, job->work);
+}
+
+napi_value queueJob(napi_env env, std::unique_ptr<Job> job, const char* name)
+{
+    napi_value promise;
+    check(env, napi_create_promise(env, &job->deferred, &promise));
+
+    napi_value resourceName;
+    check(env, napi_create_string_utf8(env, name, NAPI_AUTO_LENGTH, &resourceName));
+    check(env, napi_create_async_work(env, nullptr, resourceName, executeJob, completeJob, job.get(), &job->work));
+    check(env, napi_queue_async_work(env, job->work));
+
+    job.release();
+    return promise;
+}
+
+// Wraps a binding so JsError turns into a thrown JS TypeError.
+template <typename F>
+napi_value guarded(napi_env env, F&& body)
+{
+    try
+    {
+        return body();
+    }
+    catch (const JsError& e)
+    {
+        napi_throw_type_error(env, nullptr, e.message.c_str());
+        return nullptr;
+    }
+    catch (const std::exception& e)
+    {
+        napi_throw_error(env, "NM_SOLVER_ERROR", e.what());
+        return nullptr;
+    }
+}
+
+// ---- root finding -----------------------------------------------------------
+
+class RootFindingJob : public Job {
+public:
+    RootFindingRequest request;
+    // timeoutMs counts from here, so time spent queued on the threadpool is included.
+    std::chrono::steady_clock::time_point received = std::chrono::steady_clock::now();
+
+    RootFindingProblem problem = RootFindingService::problem(4, 1);
+    double a = 0.0;
+    double b = 0.0;
+    double x0 = 0.0;
+    double eps = 0.0;
+    double xBis = 0.0;
+    double xRf = 0.0;
+    double xSec = 0.0;
+    double xNew = 0.0;
+    SolveStatus statusBis = SolveStatus::Completed;
+    SolveStatus statusRf = SolveStatus::Completed;
+    SolveStatus statusSec = SolveStatus::Completed;
+    SolveStatus statusNew = SolveStatus::Completed;
+    DecimatedTrace<BisectionTraceStep> bisTrace;
+    DecimatedTrace<RegulaFalsiTraceStep> rfTrace;
+    DecimatedTrace<SecantTraceStep> secTrace;
+    DecimatedTrace<NewtonTraceStep> newtTrace;
+
+    void execute() override
+    {
+        // The deadline covers the whole job; a method that hits it returns its
+        // current estimate and the ones after it stop before their first step.
+        ResolvedRootFindingRequest resolved = RootFindingService::resolve(request, received);
+        problem = std::move(resolved.problem);
+        eps = resolved.eps;
+        a = resolved.a;
+        b = resolved.b;
+        x0 = resolved.x0;
+        const StopCondition& stop = resolved.stop;
+
+        if (!request.trace)
+        {
+            NoTrace none;
+            record(RootFinding::bisection(problem.f, a, b, eps, none, stop), xBis, statusBis);
+            record(RootFinding::regulaFalsi(problem.f, a, b, eps, none, stop), xRf, statusRf);
+            record(RootFinding::secant(problem.f, a, b, eps, none, stop), xSec, statusSec);
+            record(RootFinding::newton(problem.f, problem.derivative, x0, eps, none, stop), xNew, statusNew);
+            return;
+        }
+
+        bisTrace = DecimatedTrace<BisectionTraceStep>(request.decimation);
+        rfTrace = DecimatedTrace<RegulaFalsiTraceStep>(request.decimation);
+        secTrace = DecimatedTrace<SecantTraceStep>(request.decimation);
+        newtTrace = DecimatedTrace<NewtonTraceStep>(request.decimation);
+        record(RootFinding::bisection(problem.f, a, b, eps, bisTrace, stop), xBis, statusBis);
+        record(RootFinding::regulaFalsi(problem.f, a, b, eps, rfTrace, stop), xRf, statusRf);
+        record(RootFinding::secant(problem.f, a, b, eps, secTrace, stop), xSec, statusSec);
+        record(RootFinding::newton(problem.f, problem.derivative, x0, eps, newtTrace, stop), xNew, statusNew);
+    }
+
+    static void record(const SolveOutcome<double>& outcome, double& x, SolveStatus& status)
+    {
+        x = outcome.x;
+        status = outcome.status;
+    }
+
+    template <typename Step, typename... Fields>
+    static napi_value columns(napi_env env, const std::vector<Step>& steps, std::pair<const char*, Fields Step::*>... fields)
+    {
+        napi_value out = makeObject(env);
+        std::vector<double> iter(steps.size());
+        for (std::size_t i = 0; i < steps.size(); i++)
+        {
+            iter[i] = static_cast<double>(steps[i].iter);
+        }
+        setNamed(env, out, "iter", makeFloat64Array(env, iter));
+
+        auto column = [&](const char* key, double Step::*member) {
+            std::vector<double> col(steps.size());
+            for (std::size_t i = 0; i < steps.size(); i++)
+            {
+                col[i] = steps[i].*member;
+            }
+            setNamed(env, out, key, makeFloat64Array(env, col));
+        };
+        (column(fields.first, fields.second), ...);
+        return out;
+    }
+
+    template <typename Step>
+    napi_value method(napi_env env, const char* name, double x, SolveStatus status, const DecimatedTrace<Step>& recorded, napi_value trace)
+    {
+        napi_value m = makeObject(env);
+        setNamed(env, m, "name", makeString(env, name));
+        if (status != SolveStatus::Completed)
+        {
+            setNamed(env, m, "status", makeString(env, solveStatusName(status)));
+        }
+        setNamed(env, m, "x", makeNumber(env, x));
+        setNamed(env, m, "fx", makeNumber(env, problem.f(x)));
+        if (trace)
+        {
+            if (!request.decimation.isFull())
+            {
+                setNamed(env, m, "traceSteps", makeNumber(env, static_cast<double>(recorded.recorded())));
+            }
+            setNamed(env, m, "trace", trace);
+        }
+        return m;
+    }
+
+    napi_value result(napi_env env) override
+    {
+        using P = std::pair<const char*, double BisectionTraceStep::*>;
+        using R = std::pair<const char*, double RegulaFalsiTraceStep::*>;
+        using S = std::pair<const char*, double SecantTraceStep::*>;
+        using N = std::pair<const char*, double NewtonTraceStep::*>;
+        const bool t = request.trace;
+
+        napi_value out = makeObject(env);
+        setNamed(env, out, "kind", makeString(env, "rootfinding"));
+        setNamed(env, out, "referat", makeString(env, "01"));
+        setNamed(env, out, "eq", makeNumber(env, request.eq));
+        setNamed(env, out, "interval", makeNumber(env, request.interval));
+        setNamed(env, out, "eps", makeNumber(env, eps));
+        setNamed(env, out, "statement", makeString(env, problem.statement));
+        setNamed(env, out, "a", makeNumber(env, a));
+        setNamed(env, out, "b", makeNumber(env, b));
+        setNamed(env, out, "traceEnabled", makeBool(env, t));
+        if (t && !request.decimation.isFull())
+        {
+            setNamed(env, out, "traceMode", makeString(env, request.decimation.modeName()));
+            setNamed(env, out, "traceLimit", makeNumber(env, static_cast<double>(request.decimation.limit)));
+        }
+        if (request.timeoutMs)
+        {
+            setNamed(env, out, "timeoutMs", makeNumber(env, *request.timeoutMs));
+        }
+        setNamed(env, out, "x0", makeNumber(env, x0));
+
+        napi_value methods;
+        check(env, napi_create_array_with_length(env, 4, &methods));
+        check(env, napi_set_element(env, methods, 0, method(env, "bisection", xBis, statusBis, bisTrace, t ? columns(env, bisTrace.steps(),
+            P{ "a", &BisectionTraceStep::a }, P{ "b", &BisectionTraceStep::b }, P{ "p", &BisectionTraceStep::p },
+            P{ "fp", &BisectionTraceStep::fp }, P{ "errorBound", &BisectionTraceStep::errorBound }) : nullptr)));
+        check(env, napi_set_element(env, methods, 1, method(env, "regulaFalsi", xRf, statusRf, rfTrace, t ? columns(env, rfTrace.steps(),
+            R{ "a", &RegulaFalsiTraceStep::a }, R{ "b", &RegulaFalsiTraceStep::b }, R{ "p", &RegulaFalsiTraceStep::p },
+            R{ "fp", &RegulaFalsiTraceStep::fp }) : nullptr)));
+        check(env, napi_set_element(env, methods, 2, method(env, "secant", xSec, statusSec, secTrace, t ? columns(env, secTrace.steps(),
+            S{ "x0", &SecantTraceStep::x0 }, S{ "x1", &SecantTraceStep::x1 }, S{ "p", &SecantTraceStep::p },
+            S{ "fp", &SecantTraceStep::fp }) : nullptr)));
+        check(env, napi_set_element(env, methods, 3, method(env, "newton", xNew, statusNew, newtTrace, t ? columns(env, newtTrace.steps(),
+            N{ "x", &NewtonTraceStep::x }, N{ "fx", &NewtonTraceStep::fx }, N{ "dfx", &NewtonTraceStep::dfx },
+            N{ "xNext", &NewtonTraceStep::xNext }, N{ "fxNext", &NewtonTraceStep::fxNext }) : nullptr)));
+        setNamed(env, out, "methods", methods);
+        return out;
+    }
+};
+
+// Reads the /api/rootfinding/trace style params object into a request.
+void readRootFindingRequest(napi_env env, napi_value params, RootFindingRequest& request)
+{
+    napi_valuetype type;
+    check(env, napi_typeof(env, params, &type));
+    if (type == napi_object)
+    {
+        if (const auto eq = optionalNumber(env, params, "eq")) request.eq = static_cast<int>(*eq);
+        if (const auto interval = optionalNumber(env, params, "interval")) request.interval = static_cast<int>(*interval);
+        request.a = optionalNumber(env, params, "a");
+        request.b = optionalNumber(env, params, "b");
+        request.x0 = optionalNumber(env, params, "x0");
+        request.eps = optionalNumber(env, params, "eps");
+        request.trace = optionalBool(env, params, "trace", true);
+        request.timeoutMs = optionalNumber(env, params, "timeoutMs");
+        const auto traceMode = optionalString(env, params, "traceMode");
+        const auto traceLimit = optionalNumber(env, params, "traceLimit");
+        if (traceLimit && !(*traceLimit >= 0.0))
+        {
+            throw JsError{ "Invalid traceLimit. Must be non-negative." };
+        }
+        if (traceMode)
+        {
+            try
+            {
+                request.decimation = TraceDecimation::parse(*traceMode, traceLimit ? static_cast<std::size_t>(*traceLimit) : 0);
+            }
+            catch (const std::invalid_argument& e)
+            {
+                throw JsError{ e.what() };
+            }
+        }
+    }
+    if (request.eps && !(*request.eps > 0.0))
+    {
+        throw JsError{ "Invalid eps. Must be a finite positive number." };
+    }
+    if (request.timeoutMs && !(*request.timeoutMs > 0.0))
+    {
+        throw JsError{ "Invalid timeoutMs. Must be a positive number." };
+    }
+    if (request.a.has_value() != request.b.has_value())
+    {
+        throw JsError{ "Provide both a and b, or neither." };
+    }
+}
+
+napi_value RootFindingBinding(napi_env env, napi_callback_info info)
+{
+    return guarded(env, [&]() {
+        std::vector<napi_value> args;
+        napi_value params = getArg(env, info, 0, 1, args);
+
+        auto job = std::make_unique<RootFindingJob>();
+        readRootFindingRequest(env, params, job->request);
+        return queueJob(env, std::move(job), "nm-lib:rootFinding");
+    });
+}
+
+// Several independent solves on one nm-lib ThreadPool inside a single libuv
+// job; each entry keeps its own result or error (RootFindingService::solveBatch).
+class RootFindingBatchJob : public Job {
+public:
+    std::vector<std::unique_ptr<RootFindingJob>> items;
+    std::size_t threads = 0;
+
+    void execute() override
+    {
+        if (items.empty())
+        {
+            return;
+        }
+
+        const std::size_t wanted = threads > 0 ? threads : ThreadPool::defaultThreadCount();
+        ThreadPool pool(std::min(wanted, items.size()));
+        for (auto& item : items)
+        {
+            RootFindingJob* job = item.get();
+            // Each job's timeoutMs already counts from when the batch was received.
+            pool.submit([job]() { executeJob(nullptr, job); });
+        }
+        pool.wait();
+    }
+
+    napi_value result(napi_env env) override
+    {
+        napi_value out;
+        check(env, napi_create_array_with_length(env, items.size(), &out));
+        for (std::size_t i = 0; i < items.size(); i++)
+        {
+            napi_value entry = makeObject(env);
+            const bool ok = items[i]->error.empty();
+            setNamed(env, entry, "ok", makeBool(env, ok));
+            if (ok)
+            {
+                setNamed(env, entry, "result", items[i]->result(env));
+            }
+            else
+            {
+                setNamed(env, entry, "error", makeString(env, items[i]->error.c_str()));
+            }
+            check(env, napi_set_element(env, out, static_cast<uint32_t>(i), entry));
+        }
+        return out;
+    }
+};
+
+napi_value RootFindingBatchBinding(napi_env env, napi_callback_info info)
+{
+    return guarded(env, [&]() {
+        std::vector<napi_value> args;
+        napi_value list = getArg(env, info, 0, 2, args);
+        bool isArray = false;
+        check(env, napi_is_array(env, list, &isArray));
+        if (!isArray)
+        {
+            throw JsError{ "Invalid batch. Expected an array of requests." };
+        }
+
+        auto job = std::make_unique<RootFindingBatchJob>();
+        napi_valuetype type;
+        check(env, napi_typeof(env, args[1], &type));
+        if (type != napi_undefined)
+        {
+            const double threads = toNumber(env, args[1], "threads");
+            if (!(threads >= 0.0))
+            {
+                throw JsError{ "Invalid threads. Must be non-negative." };
+            }
+            job->threads = static_cast<std::size_t>(threads);
+        }
+
+        uint32_t length = 0;
+        check(env, napi_get_array_length(env, list, &length));
+        for (uint32_t i = 0; i < length; i++)
+        {
+            napi_value params;
+            check(env, napi_get_element(env, list, i, &params));
+            auto item = std::make_unique<RootFindingJob>();
+            try
+            {
+                readRootFindingRequest(env, params, item->request);
+            }
+            catch (const JsError& e)
+            {
+                throw JsError{ "Request " + std::to_string(i) + ": " + e.message };
+            }
+            job->items.push_back(std::move(item));
+        }
+        return queueJob(env, std::move(job), "nm-lib:rootFindingBatch");
+    });
+}
+
+// Same solve, returned as an NMTC columnar container (nm-lib utils/ColumnarTrace.h) in a Buffer.
+class RootFindingColumnarJob : public Job {
+public:
+    RootFindingRequest request;
+    bool compress = true;
+    std::string bytes;
+
+    void execute() override
+    {
+        std::ostringstream out;
+        RootFindingService::solveColumnar(request, out, compress);
+        bytes = out.str();
+    }
+
+    napi_value result(napi_env env) override
+    {
+        napi_value buffer;
+        check(env, napi_create_buffer_copy(env, bytes.size(), bytes.data(), nullptr, &buffer));
+        return buffer;
+    }
+};
+
+napi_value RootFindingColumnarBinding(napi_env env, napi_callback_info info)
+{
+    return guarded(env, [&]() {
+        std::vector<napi_value> args;
+        napi_value params = getArg(env, info, 0, 1, args);
+
+        auto job = std::make_unique<RootFindingColumnarJob>();
+        readRootFindingRequest(env, params, job->request);
+        napi_valuetype type;
+        check(env, napi_typeof(env, params, &type));
+        if (type == napi_object)
+        {
+            job->compress = optionalBool(env, params, "compress", true);
+        }
+        return queueJob(env, std::move(job), "nm-lib:rootFindingColumnar");
+    });
+}
+
+// ---- linear systems ---------------------------------------------------------
+
+class GaussianJob : public Job {
+public:
+    std::vector<double> a;
+    std::vector<double> b;
+    int significantDigits = 16;
+    std::vector<double> x;
+
+    void execute() override
+    {
+        const Vector solution = GaussianElimination::solve(toLinearSystem(a, b), significantDigits);
+        x.resize(solution.size());
+        for (std::size_t i = 0; i < x.size(); i++)
+        {
+            x[i] = solution[i];
+        }
+    }
+
+    napi_value result(napi_env env) override
+    {
+        napi_value out = makeObject(env);
+        setNamed(env, out, "x", makeFloat64Array(env, x));
+        return out;
+    }
+};
+
+napi_value GaussianBinding(napi_env env, napi_callback_info info)
+{
+    return guarded(env, [&]() {
+        std::vector<napi_value> args;
+        auto job = std::make_unique<GaussianJob>();
+        job->a = toDoubles(env, getArg(env, info, 0, 3, args), "A");
+        job->b = toDoubles(env, getArg(env, info, 1, 3, args), "b");
+
+        napi_valuetype type;
+        check(env, napi_typeof(env, args[2], &type));
+        if (type != napi_undefined)
+        {
+            const double t = toNumber(env, args[2], "significantDigits");
+            if (!(t >= 1.0 && t <= 17.0))
+            {
+                throw JsError{ "Invalid significantDigits. Use 1..17." };
+            }
+            job->significantDigits = static_cast<int>(t);
+        }
+        return queueJob(env, std::move(job), "nm-lib:gaussianElimination");
+    });
+}
+
+enum class IterativeKind
+{
+    Jacobi,
+    GaussSeidel
+};
+
+class IterativeJob : public Job {
+public:
+    IterativeKind kind = IterativeKind::Jacobi;
+    std::vector<double> a;
+    std::vector<double> b;
+    std::vector<double> x0;
+    std::size_t iterations = 0;
+    bool trace = false;
+
+    Vector x{ 0.0 };
+    IterativeMethodTrace steps;
+
+    void execute() override
+    {
+        const LinearSystem system = toLinearSystem(a, b);
+        const Vector start = toVector(x0);
+        IterativeMethodTrace* t = trace ? &steps : nullptr;
+        x = (kind == IterativeKind::Jacobi)
+            ? JacobiSolver::iterate(system, start, iterations, t)
+            : GaussSeidelSolver::iterate(system, start, iterations, t);
+    }
+
+    napi_value result(napi_env env) override
+    {
+        napi_value out = makeObject(env);
+        setNamed(env, out, "x", makeFloat64Array(env, x));
+        if (trace)
+        {
+            const std::size_t n = b.size();
+            std::vector<double> iter(steps.steps.size());
+            std::vector<double> xs(steps.steps.size() * n);
+            for (std::size_t k = 0; k < steps.steps.size(); k++)
+            {
+                iter[k] = static_cast<double>(steps.steps[k].iter);
+                for (std::size_t i = 0; i < n; i++)
+                {
+                    xs[k * n + i] = steps.steps[k].x[i];
+                }
+            }
+            napi_value t = makeObject(env);
+            setNamed(env, t, "iter", makeFloat64Array(env, iter));
+            setNamed(env, t, "x", makeFloat64Array(env, xs));
+            setNamed(env, out, "trace", t);
+        }
+        return out;
+    }
+};
+
+napi_value iterativeBinding(napi_env env, napi_callback_info info, IterativeKind kind)
+{
+    return guarded(env, [&]() {
+        std::vector<napi_value> args;
+        auto job = std::make_unique<IterativeJob>();
+        job->kind = kind;
+        job->a = toDoubles(env, getArg(env, info, 0, 5, args), "A");
+        job->b = toDoubles(env, args[1], "b");
+        job->x0 = toDoubles(env, args[2], "x0");
+        const double iterations = toNumber(env, args[3], "iterations");
+        if (!(iterations >= 0.0 && iterations <= 1e7))
+        {
+            throw JsError{ "Invalid iterations. Use 0..1e7." };
+        }
+        job->iterations = static_cast<std::size_t>(iterations);
+
+        napi_valuetype type;
+        check(env, napi_typeof(env, args[4], &type));
+        if (type == napi_boolean)
+        {
+            check(env, napi_get_value_bool(env, args[4], &job->trace));
+        }
+        return queueJob(env, std::move(job), kind == IterativeKind::Jacobi ? "nm-lib:jacobi" : "nm-lib:gaussSeidel");
+    });
+}
+
+napi_value JacobiBinding(napi_env env, napi_callback_info info)
+{
+    return iterativeBinding(env, info, IterativeKind::Jacobi);
+}
+
+napi_value GaussSeidelBinding(napi_env env, napi_callback_info info)
+{
+    return iterativeBinding(env, info, IterativeKind::GaussSeidel);
+}
+
+// ---- Newton for systems -----------------------------------------------------
+
+// JS callbacks cannot run on the threadpool, so Newton is exposed for the
+// course systems (tema4) by id.
+class NewtonSystemJob : public Job {
+public:
+    int which = 4;
+    double eps = 1e-5;
+    bool trace = false;
+
+    NewtonSystemProblem problem = NewtonSystemsService::problem(4);
+    Vector x{ 0.0 };
+    Vector fx{ 0.0 };
+    NewtonSystemTrace steps;
+
+    void execute() override
+    {
+        problem = NewtonSystemsService::problem(which);
+        x = NewtonSolver::solve(problem.system, problem.x0, eps, trace ? &steps : nullptr);
+        fx = problem.system.evaluate(x);
+    }
+
+    napi_value result(napi_env env) override
+    {
+        napi_value out = makeObject(env);
+        setNamed(env, out, "system", makeNumber(env, which));
+        setNamed(env, out, "statement", makeString(env, problem.statement));
+        setNamed(env, out, "eps", makeNumber(env, eps));
+        setNamed(env, out, "x0", makeFloat64Array(env, problem.x0));
+        setNamed(env, out, "x", makeFloat64Array(env, x));
+        setNamed(env, out, "fx", makeFloat64Array(env, fx));
+        setNamed(env, out, "residual_inf", makeNumber(env, fx.normInf()));
+        if (trace)
+        {
+            const std::size_t n = x.size();
+            const std::size_t count = steps.steps.size();
+            std::vector<double> iter(count);
+            std::vector<double> xs(count * n);
+            std::vector<double> fxs(count * n);
+            std::vector<double> deltas(count * n);
+            std::vector<double> jacs(count * n * n);
+            for (std::size_t k = 0; k < count; k++)
+            {
+                const NewtonSystemTraceStep& s = steps.steps[k];
+                iter[k] = static_cast<double>(s.iter);
+                for (std::size_t i = 0; i < n; i++)
+                {
+                    xs[k * n + i] = s.x[i];
+                    fxs[k * n + i] = s.fx[i];
+                    deltas[k * n + i] = s.delta[i];
+                    for (std::size_t j = 0; j < n; j++)
+                    {
+                        jacs[(k * n + i) * n + j] = s.jac(i, j);
+                    }
+                }
+            }
+            napi_value t = makeObject(env);
+            setNamed(env, t, "iter", makeFloat64Array(env, iter));
+            setNamed(env, t, "x", makeFloat64Array(env, xs));
+            setNamed(env, t, "fx", makeFloat64Array(env, fxs));
+            setNamed(env, t, "jac", makeFloat64Array(env, jacs));
+            setNamed(env, t, "delta", makeFloat64Array(env, deltas));
+            setNamed(env, out, "trace", t);
+        }
+        return out;
+    }
+};
+
+napi_value NewtonSystemBinding(napi_env env, napi_callback_info info)
+{
+    return guarded(env, [&]() {
+        std::vector<napi_value> args;
+        napi_value params = getArg(env, info, 0, 1, args);
+
+        auto job = std::make_unique<NewtonSystemJob>();
+        napi_valuetype type;
+        check(env, napi_typeof(env, params, &type));
+        if (type == napi_object)
+        {
+            if (const auto which = optionalNumber(env, params, "system")) job->which = static_cast<int>(*which);
+            if (const auto eps = optionalNumber(env, params, "eps")) job->eps = *eps;
+            job->trace = optionalBool(env, params, "trace", false);
+        }
+        if (job->which < 1 || job->which > 4)
+        {
+            throw JsError{ "Invalid system. Use 1, 2, 3, or 4." };
+        }
+        if (!(job->eps > 0.0))
+        {
+            throw JsError{ "Invalid eps. Must be a finite positive number." };
+        }
+        return queueJob(env, std::move(job), "nm-lib:newtonSystem");
+    });
+}
+
+} // namespace
+
+static napi_value Init(napi_env env, napi_value exports)
+{
+    const napi_property_descriptor props[] = {
+        { "rootFinding", nullptr, RootFindingBinding, nullptr, nullptr, nullptr, napi_enumerable, nullptr },
+        { "rootFindingBatch", nullptr, RootFindingBatchBinding, nullptr, nullptr, nullptr, napi_enumerable, nullptr },
+        { "rootFindingColumnar", nullptr, RootFindingColumnarBinding, nullptr, nullptr, nullptr, napi_enumerable, nullptr },
+        { "gaussianElimination", nullptr, GaussianBinding, nullptr, nullptr, nullptr, napi_enumerable, nullptr },
+        { "jacobi", nullptr, JacobiBinding, nullptr, nullptr, nullptr, napi_enumerable, nullptr },
+        { "gaussSeidel", nullptr, GaussSeidelBinding, nullptr, nullptr, nullptr, napi_enumerable, nullptr },
+        { "newtonSystem", nullptr, NewtonSystemBinding, nullptr, nullptr, nullptr, napi_enumerable, nullptr },
+    };
+    napi_define_properties(env, exports, sizeof(props) / sizeof(props[0]), props);
+    return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -3,11 +3,29 @@ import cors from 'cors';
 import { getChapterHtmlBySlug, getMarkdownPageHtml, listChapters, listMarkdownPages } from './content.js';
 import path from 'path';
 import fs from 'fs';
+import readline from 'node:readline';
 import { fileURLToPath } from 'url';
-import { execFile } from 'node:child_process';
-import { promisify } from 'node:util';
+import { SolverError } from './solverPool.js';
+import {
+  columnarAvailable,
+  computeRootFinding,
+  computeRootFindingBatch,
+  computeRootFindingColumnar,
+  type RootFindingParams,
+  SolverUnavailableError,
+  spawnRootFindingStream,
+  stoppedEarly,
+} from './rootFinding.js';
+import { getResultCache } from './resultCache.js';
 
-const execFileAsync = promisify(execFile);
+const COLUMNAR_CONTENT_TYPE = 'application/x-nmtc';
+const TRACE_MODES = ['full', 'head-tail', 'stride', 'lttb'];
+// Streams are for long solves, so they get more time than the 15 s of a plain request.
+// The driver's own deadline ends the methods first, so they still report their last iterate.
+const STREAM_TIMEOUT_MS = 120_000;
+const STREAM_DEADLINE_MS = STREAM_TIMEOUT_MS - 5_000;
+// Parameter sets per /api/rootfinding/batch call; they share one 15 s solve.
+const BATCH_LIMIT = 64;
 
 const app = express();
 app.use(cors());
@@ -67,104 +85,238 @@ app.get('/api/chapters/:id', async (req, res) => {
   }
 });
 
-app.get('/api/rootfinding/trace', async (req, res) => {
-  try {
-    const eq = req.query.eq === undefined ? 4 : Number(req.query.eq);
-    const interval = req.query.interval === undefined ? 1 : Number(req.query.interval);
-    const isEq = eq === 1 || eq === 2 || eq === 3 || eq === 4;
-    const isInterval = interval === 1 || interval === 2;
-    if (!isEq || !isInterval) {
-      res.status(400).json({ error: 'Invalid query. Use ?eq=1..4&interval=1|2' });
-      return;
+// Request parameters shared by the trace and stream endpoints, or the 400 message.
+function parseRootFindingQuery(query: express.Request['query']): { params: RootFindingParams } | { error: string } {
+  const eq = query.eq === undefined ? 4 : Number(query.eq);
+  const interval = query.interval === undefined ? 1 : Number(query.interval);
+  const isEq = eq === 1 || eq === 2 || eq === 3 || eq === 4;
+  const isInterval = interval === 1 || interval === 2;
+  if (!isEq || !isInterval) {
+    return { error: 'Invalid query. Use ?eq=1..4&interval=1|2' };
+  }
+
+  const aRaw = typeof query.a === 'string' ? query.a : undefined;
+  const bRaw = typeof query.b === 'string' ? query.b : undefined;
+  const x0Raw = typeof query.x0 === 'string' ? query.x0 : undefined;
+  const epsRaw = typeof query.eps === 'string' ? query.eps : undefined;
+  const traceModeRaw = typeof query.traceMode === 'string' ? query.traceMode : undefined;
+  const traceLimitRaw = typeof query.traceLimit === 'string' ? query.traceLimit : undefined;
+
+  const params: RootFindingParams = { eq, interval, trace: true };
+
+  if (aRaw !== undefined || bRaw !== undefined) {
+    if (aRaw === undefined || bRaw === undefined) {
+      return { error: 'Provide both a and b, or neither.' };
+    }
+    const a = Number(aRaw);
+    const b = Number(bRaw);
+    if (!Number.isFinite(a) || !Number.isFinite(b)) {
+      return { error: 'Invalid a/b. Must be finite numbers.' };
+    }
+    params.a = a;
+    params.b = b;
+  }
+  if (x0Raw !== undefined) {
+    const x0 = Number(x0Raw);
+    if (!Number.isFinite(x0)) {
+      return { error: 'Invalid x0. Must be a finite number.' };
+    }
+    params.x0 = x0;
+  }
+  if (epsRaw !== undefined) {
+    const eps = Number(epsRaw);
+    if (!Number.isFinite(eps) || eps <= 0) {
+      return { error: 'Invalid eps. Must be a finite positive number.' };
+    }
+    params.eps = eps;
+  }
+  // Trace decimation (see nm-lib/include/utils/TraceDecimation.h); the solver applies the defaults.
+  if (traceModeRaw !== undefined) {
+    if (!TRACE_MODES.includes(traceModeRaw)) {
+      return { error: `Invalid traceMode. Use ${TRACE_MODES.join(', ')}.` };
     }
+    params.traceMode = traceModeRaw;
+  }
+  if (traceLimitRaw !== undefined) {
+    const traceLimit = Number(traceLimitRaw);
+    if (!Number.isInteger(traceLimit) || traceLimit <= 0) {
+      return { error: 'Invalid traceLimit. Must be a positive integer.' };
+    }
+    params.traceLimit = traceLimit;
+  }
+  return { params };
+}
 
-    const aRaw = typeof req.query.a === 'string' ? req.query.a : undefined;
-    const bRaw = typeof req.query.b === 'string' ? req.query.b : undefined;
-    const x0Raw = typeof req.query.x0 === 'string' ? req.query.x0 : undefined;
-    const epsRaw = typeof req.query.eps === 'string' ? req.query.eps : undefined;
-
-    // Locate the compiled C++ test binary that emits the trace JSON.
-    // Works for both dev (tsx) and prod (dist) because __dirname is set from import.meta.url.
-    const __dirname = path.dirname(fileURLToPath(import.meta.url));
-    const repoRoot = path.resolve(__dirname, '../../../');
-
-    const candidates = [
-      path.resolve(repoRoot, 'nm-lib/bin/tests/tema1_rootfinding.exe'),
-      path.resolve(repoRoot, 'nm-lib/bin/tests/tema1_rootfinding'),
-    ];
-    const exePath = candidates.find((p) => fs.existsSync(p));
-    if (!exePath) {
-      res.status(500).json({
-        error:
-          'Rootfinding binary not found. Build the C++ tests (VS Code task: build (tests)) so nm-lib/bin/tests/tema1_rootfinding(.exe) exists.',
-        lookedFor: candidates,
-      });
+app.get('/api/rootfinding/trace', async (req, res) => {
+  try {
+    const parsed = parseRootFindingQuery(req.query);
+    if ('error' in parsed) {
+      res.status(400).json({ error: parsed.error });
       return;
     }
+    const { params } = parsed;
 
-    const args: string[] = ['--json', '--trace', '--eq', String(eq), '--interval', String(interval)];
+    try {
+      const cache = await getResultCache(repoRoot);
 
-    if (aRaw !== undefined || bRaw !== undefined) {
-      if (aRaw === undefined || bRaw === undefined) {
-        res.status(400).json({ error: 'Provide both a and b, or neither.' });
+      // ?format=columnar answers with an NMTC container (typed columns, no JSON parse
+      // on the client); without a columnar backend the JSON form is returned.
+      if (req.query.format === 'columnar' && columnarAvailable(repoRoot)) {
+        const { body, source } = await cache.get(
+          'rootfinding.columnar',
+          params,
+          () => computeRootFindingColumnar(repoRoot, params),
+          (b) => !stoppedEarly(b),
+        );
+        res.set('X-Cache', source).type(COLUMNAR_CONTENT_TYPE).send(body);
         return;
       }
-      const a = Number(aRaw);
-      const b = Number(bRaw);
-      if (!Number.isFinite(a) || !Number.isFinite(b)) {
-        res.status(400).json({ error: 'Invalid a/b. Must be finite numbers.' });
+
+      const { body, source } = await cache.get(
+        'rootfinding',
+        params,
+        async () => Buffer.from(JSON.stringify(await computeRootFinding(repoRoot, params))),
+        (b) => !stoppedEarly(b),
+      );
+      res.set('X-Cache', source).type('application/json').send(body);
+    } catch (e: unknown) {
+      if (e instanceof SolverError) {
+        res.status(400).json({ error: e.message });
         return;
       }
-      args.push('--a', String(a), '--b', String(b));
-    }
-    if (x0Raw !== undefined) {
-      const x0 = Number(x0Raw);
-      if (!Number.isFinite(x0)) {
-        res.status(400).json({ error: 'Invalid x0. Must be a finite number.' });
+      if (e instanceof SolverUnavailableError) {
+        res.status(500).json({ error: e.message, lookedFor: e.lookedFor });
         return;
       }
-      args.push('--x0', String(x0));
+      res.status(500).json({ error: 'Failed to compute rootfinding trace.' });
     }
-    if (epsRaw !== undefined) {
-      const eps = Number(epsRaw);
-      if (!Number.isFinite(eps) || eps <= 0) {
-        res.status(400).json({ error: 'Invalid eps. Must be a finite positive number.' });
-        return;
-      }
-      args.push('--eps', String(eps));
+  } catch {
+    res.status(500).json({ error: 'Failed to handle request.' });
+  }
+});
+
+// Several parameter sets in one round trip: POST { requests: [{ eq, interval, ... }, ...] }
+// with the /trace query keys (as JSON values, plus trace: false to skip the traces).
+// The sets are solved in parallel by one backend call; the answer is
+// { results: [{ ok: true, result } | { ok: false, error }, ...] } in request order.
+app.post('/api/rootfinding/batch', express.json({ limit: '256kb' }), async (req, res) => {
+  const requests: unknown = req.body?.requests;
+  if (!Array.isArray(requests) || requests.length === 0 || requests.length > BATCH_LIMIT) {
+    res.status(400).json({ error: `Expected { requests: [...] } with 1..${BATCH_LIMIT} parameter sets.` });
+    return;
+  }
+
+  const list: RootFindingParams[] = [];
+  for (const [i, item] of requests.entries()) {
+    if (item === null || typeof item !== 'object' || Array.isArray(item)) {
+      res.status(400).json({ error: `Request ${i}: expected an object.` });
+      return;
     }
-    try {
-      const { stdout } = await execFileAsync(exePath, args, {
-        cwd: repoRoot,
-        timeout: 15_000,
-        maxBuffer: 5 * 1024 * 1024,
-        windowsHide: true,
-      });
-
-      const text = String(stdout ?? '').trim();
-      const payload = JSON.parse(text);
-      res.json(payload);
+    const query = Object.fromEntries(Object.entries(item).map(([k, v]) => [k, String(v)]));
+    const parsed = parseRootFindingQuery(query);
+    if ('error' in parsed) {
+      res.status(400).json({ error: `Request ${i}: ${parsed.error}` });
       return;
-    } catch (e: unknown) {
-      const errObj = e as { stderr?: unknown; stdout?: unknown; message?: unknown; code?: unknown };
-      const stderr = typeof errObj?.stderr === 'string' ? errObj.stderr : '';
-      const stdout = typeof errObj?.stdout === 'string' ? errObj.stdout : '';
-
-      const cleaned = (stderr || stdout || '').toString().trim();
-      if (cleaned) {
-        // Treat as a user/config error (bad interval, invalid eq, etc.).
-        res.status(400).json({ error: cleaned.split('\r\n').join('\n') });
-        return;
-      }
+    }
+    if ((item as { trace?: unknown }).trace === false) parsed.params.trace = false;
+    list.push(parsed.params);
+  }
 
-      res.status(500).json({ error: 'Failed to compute rootfinding trace.' });
+  try {
+    const cache = await getResultCache(repoRoot);
+    const { body, source } = await cache.get(
+      'rootfinding.batch',
+      list,
+      async () => Buffer.from(JSON.stringify({ results: await computeRootFindingBatch(repoRoot, list) })),
+      (b) => !stoppedEarly(b),
+    );
+    res.set('X-Cache', source).type('application/json').send(body);
+  } catch (e: unknown) {
+    if (e instanceof SolverError) {
+      res.status(400).json({ error: e.message });
       return;
     }
-  } catch {
-    res.status(500).json({ error: 'Failed to handle request.' });
+    if (e instanceof SolverUnavailableError) {
+      res.status(500).json({ error: e.message, lookedFor: e.lookedFor });
+      return;
+    }
+    res.status(500).json({ error: 'Failed to compute rootfinding batch.' });
   }
 });
 
+// Live progress of one solve as Server-Sent Events: every NDJSON record of
+// `tema1_rootfinding --stream` becomes one `data:` message, sent as soon as the
+// driver writes it. The driver is killed when the client disconnects.
+app.get('/api/rootfinding/stream', (req, res) => {
+  const parsed = parseRootFindingQuery(req.query);
+  if ('error' in parsed) {
+    res.status(400).json({ error: parsed.error });
+    return;
+  }
+
+  let child: ReturnType<typeof spawnRootFindingStream>;
+  try {
+    child = spawnRootFindingStream(repoRoot, { ...parsed.params, timeoutMs: STREAM_DEADLINE_MS });
+  } catch (e: unknown) {
+    if (e instanceof SolverUnavailableError) {
+      res.status(500).json({ error: e.message, lookedFor: e.lookedFor });
+      return;
+    }
+    res.status(500).json({ error: 'Failed to start the solver.' });
+    return;
+  }
+
+  res.writeHead(200, {
+    'Content-Type': 'text/event-stream',
+    'Cache-Control': 'no-cache',
+    Connection: 'keep-alive',
+    'X-Accel-Buffering': 'no',
+  });
+  res.flushHeaders();
+
+  // Stop reading from the driver while the socket is backed up.
+  const send = (data: string) => {
+    if (!res.write(`data: ${data}\n\n`)) {
+      child.stdout.pause();
+      res.once('drain', () => child.stdout.resume());
+    }
+  };
+
+  const lines = readline.createInterface({ input: child.stdout });
+  lines.on('line', (line) => {
+    if (line) send(line);
+  });
+
+  // Parameter errors are printed on stderr before any record.
+  let stderr = '';
+  child.stderr.on('data', (chunk: Buffer) => {
+    stderr += chunk.toString('utf8');
+  });
+
+  const timer = setTimeout(() => {
+    send(JSON.stringify({ event: 'error', error: 'Solver timed out.' }));
+    child.kill();
+  }, STREAM_TIMEOUT_MS);
+
+  child.on('close', (code) => {
+    clearTimeout(timer);
+    if (code !== 0 && stderr.trim()) {
+      send(JSON.stringify({ event: 'error', error: stderr.trim() }));
+    }
+    res.end();
+  });
+  child.on('error', () => {
+    clearTimeout(timer);
+    res.end();
+  });
+
+  // Also fires after a normal end, when the driver has already exited.
+  res.on('close', () => {
+    clearTimeout(timer);
+    child.kill();
+  });
+});
+
 const __dirname = path.dirname(fileURLToPath(import.meta.url));
 const repoRoot = path.resolve(__dirname, '../../../');
 
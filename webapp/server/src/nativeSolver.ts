@@ -0,0 +1,82 @@
+import { createRequire } from 'node:module';
+import fs from 'fs';
+import path from 'path';
+
+// In-process access to nm-lib through the Node-API addon (webapp/native).
+// Solves run on the libuv threadpool; traces come back as Float64Array columns.
+
+export type TraceColumns = Record<string, Float64Array>;
+
+export type NativeRootFindingResult = {
+  kind: 'rootfinding';
+  referat: string;
+  eq: number;
+  interval: number;
+  eps: number;
+  statement: string;
+  a: number;
+  b: number;
+  x0: number;
+  traceEnabled: boolean;
+  traceMode?: string;
+  traceLimit?: number;
+  timeoutMs?: number;
+  methods: Array<{ name: string; status?: string; x: number; fx: number; traceSteps?: number; trace?: TraceColumns }>;
+};
+
+// One entry of a batch, in request order.
+export type NativeBatchEntry = { ok: true; result: NativeRootFindingResult } | { ok: false; error: string };
+
+export type NativeSolver = {
+  rootFinding(params: Record<string, number | boolean | string>): Promise<NativeRootFindingResult>;
+  // NMTC columnar container (nm-lib utils/ColumnarTrace.h); absent in older addon builds.
+  rootFindingColumnar?(params: Record<string, number | boolean | string>): Promise<Buffer>;
+  // Several solves on one thread pool; absent in older addon builds.
+  rootFindingBatch?(requests: Array<Record<string, number | boolean | string>>, threads?: number): Promise<NativeBatchEntry[]>;
+  gaussianElimination(A: Float64Array, b: Float64Array, significantDigits?: number): Promise<{ x: Float64Array }>;
+  jacobi(A: Float64Array, b: Float64Array, x0: Float64Array, iterations: number, trace?: boolean): Promise<{ x: Float64Array; trace?: TraceColumns }>;
+  gaussSeidel(A: Float64Array, b: Float64Array, x0: Float64Array, iterations: number, trace?: boolean): Promise<{ x: Float64Array; trace?: TraceColumns }>;
+  newtonSystem(params: { system: number; eps?: number; trace?: boolean }): Promise<Record<string, unknown>>;
+};
+
+// Rejections from the addon carry this code when the solver refused the input.
+export const NATIVE_SOLVER_ERROR = 'NM_SOLVER_ERROR';
+
+let cached: NativeSolver | null | undefined;
+
+export function loadNativeSolver(repoRoot: string): NativeSolver | null {
+  if (cached !== undefined) return cached;
+  cached = null;
+  if (process.env.NM_DISABLE_NATIVE === '1') return cached;
+
+  const addonPath = path.resolve(repoRoot, 'webapp/native/build/Release/nmlib.node');
+  if (!fs.existsSync(addonPath)) return cached;
+  try {
+    const require = createRequire(import.meta.url);
+    cached = require(addonPath) as NativeSolver;
+  } catch {
+    // ABI mismatch or missing runtime: fall back to the worker pool.
+    cached = null;
+  }
+  return cached;
+}
+
+// Converts columnar traces back to the row-per-step JSON the client expects.
+export function rowsFromColumns(columns: TraceColumns): Array<Record<string, number>> {
+  const keys = Object.keys(columns);
+  const count = columns.iter?.length ?? 0;
+  const rows: Array<Record<string, number>> = new Array(count);
+  for (let i = 0; i < count; i++) {
+    const row: Record<string, number> = {};
+    for (const k of keys) row[k] = columns[k][i];
+    rows[i] = row;
+  }
+  return rows;
+}
+
+export function rootFindingPayload(result: NativeRootFindingResult): unknown {
+  return {
+    ...result,
+    methods: result.methods.map((m) => (m.trace ? { ...m, trace: rowsFromColumns(m.trace) } : m)),
+  };
+}
@@ -0,0 +1,44 @@
+import path from 'path';
+import { fileURLToPath } from 'url';
+import { closeSolverPool, columnarAvailable, computeRootFinding, computeRootFindingColumnar } from './rootFinding.js';
+import { getResultCache } from './resultCache.js';
+
+// Fills the on-disk result cache with the default rootfinding traces
+// (every equation x interval, default eps/x0) for the current nm-lib build,
+// so a fresh server answers the common requests without solving.
+// Run after the solver binaries are built: `npm run precompute -w server`.
+
+const __dirname = path.dirname(fileURLToPath(import.meta.url));
+const repoRoot = path.resolve(__dirname, '../../../');
+
+async function main(): Promise<void> {
+  const cache = await getResultCache(repoRoot);
+  let count = 0;
+  for (const eq of [1, 2, 3, 4]) {
+    for (const interval of [1, 2]) {
+      // Same shapes the API builds for ?eq=..&interval=.. with no overrides and
+      // for the client's default decimation (client/src/features/rootfinding/api.ts).
+      for (const params of [
+        { eq, interval, trace: true },
+        { eq, interval, trace: true, traceMode: 'lttb', traceLimit: 500 },
+      ]) {
+        await cache.put('rootfinding', params, Buffer.from(JSON.stringify(await computeRootFinding(repoRoot, params))));
+        count++;
+        if (columnarAvailable(repoRoot)) {
+          await cache.put('rootfinding.columnar', params, await computeRootFindingColumnar(repoRoot, params));
+          count++;
+        }
+      }
+    }
+  }
+  // eslint-disable-next-line no-console
+  console.log(`Precomputed ${count} rootfinding results for build ${cache.buildHash}.`);
+}
+
+main()
+  .catch((e: unknown) => {
+    // eslint-disable-next-line no-console
+    console.error(e instanceof Error ? e.message : e);
+    process.exitCode = 1;
+  })
+  .finally(closeSolverPool);
@@ -0,0 +1,204 @@
+import { createHash } from 'node:crypto';
+import fs from 'fs';
+import path from 'path';
+import { solverArtifacts } from './rootFinding.js';
+
+// Cache for solver results. Solves are deterministic for a given build of
+// nm-lib, so a result is keyed by the canonical request plus a hash of the
+// solver binaries. Two tiers:
+// - memory: LRU of encoded response bodies bounded by size, answers repeats
+//   without re-encoding;
+// - disk: one file per key under <dir>/<build>/, survives restarts and can be
+//   filled ahead of time (see precompute.ts).
+// Bodies are opaque bytes (JSON text or an NMTC container).
+// Concurrent requests for the same key share one computation.
+
+export type CacheSource = 'memory' | 'disk' | 'miss';
+
+export type CachedResult = { body: Buffer; source: CacheSource };
+
+export type ResultCacheOptions = {
+  buildHash: string;
+  dir?: string | null;
+  maxBytes?: number;
+};
+
+// Sorted keys, -0 folded into 0; anything JSON.stringify accepts otherwise.
+export function canonicalJson(value: unknown): string {
+  if (typeof value === 'number') return JSON.stringify(Object.is(value, -0) ? 0 : value);
+  if (Array.isArray(value)) return `[${value.map(canonicalJson).join(',')}]`;
+  if (value && typeof value === 'object') {
+    const obj = value as Record<string, unknown>;
+    const keys = Object.keys(obj)
+      .filter((k) => obj[k] !== undefined)
+      .sort();
+    return `{${keys.map((k) => `${JSON.stringify(k)}:${canonicalJson(obj[k])}`).join(',')}}`;
+  }
+  return JSON.stringify(value);
+}
+
+// Content hash of the solver artifacts; a rebuild of nm-lib invalidates every entry.
+export async function hashFiles(files: string[]): Promise<string> {
+  const h = createHash('sha256');
+  for (const file of [...files].sort()) {
+    h.update(path.basename(file));
+    h.update('\0');
+    await new Promise<void>((resolve, reject) => {
+      const stream = fs.createReadStream(file);
+      stream.on('data', (chunk) => h.update(chunk));
+      stream.on('end', resolve);
+      stream.on('error', reject);
+    });
+  }
+  return h.digest('hex').slice(0, 16);
+}
+
+export class ResultCache {
+  private memory = new Map<string, Buffer>();
+  private memoryBytes = 0;
+  private inFlight = new Map<string, Promise<Buffer>>();
+  private readonly buildDir: string | null;
+  private readonly maxBytes: number;
+
+  constructor(private readonly options: ResultCacheOptions) {
+    this.maxBytes = options.maxBytes ?? 32 * 1024 * 1024;
+    this.buildDir = options.dir ? path.join(options.dir, options.buildHash) : null;
+  }
+
+  get buildHash(): string {
+    return this.options.buildHash;
+  }
+
+  key(kind: string, params: unknown): string {
+    return createHash('sha256')
+      .update(`${this.options.buildHash}\n${kind}\n${canonicalJson(params)}`)
+      .digest('hex');
+  }
+
+  // Encoded result for (kind, params); compute() runs only on a miss in both tiers.
+  // Rejections are not cached, nor results that cacheable() turns down.
+  async get(
+    kind: string,
+    params: unknown,
+    compute: () => Promise<Buffer>,
+    cacheable: (body: Buffer) => boolean = () => true,
+  ): Promise<CachedResult> {
+    const key = this.key(kind, params);
+
+    const hit = this.memory.get(key);
+    if (hit !== undefined) {
+      this.memory.delete(key);
+      this.memory.set(key, hit);
+      return { body: hit, source: 'memory' };
+    }
+
+    const disk = await this.readDisk(key);
+    if (disk !== null) {
+      this.remember(key, disk);
+      return { body: disk, source: 'disk' };
+    }
+
+    // A concurrent request may have finished computing while the disk was read.
+    const late = this.memory.get(key);
+    if (late !== undefined) return { body: late, source: 'memory' };
+
+    let pending = this.inFlight.get(key);
+    if (!pending) {
+      pending = compute()
+        .then((body) => {
+          if (cacheable(body)) {
+            this.remember(key, body);
+            void this.writeDisk(key, body);
+          }
+          return body;
+        })
+        .finally(() => this.inFlight.delete(key));
+      this.inFlight.set(key, pending);
+    }
+    return { body: await pending, source: 'miss' };
+  }
+
+  // Stores a result computed elsewhere (precompute) in both tiers.
+  async put(kind: string, params: unknown, body: Buffer): Promise<void> {
+    const key = this.key(kind, params);
+    this.remember(key, body);
+    await this.writeDisk(key, body);
+  }
+
+  // Removes on-disk entries written by other builds; they can never hit again.
+  async pruneStaleBuilds(): Promise<void> {
+    if (!this.options.dir) return;
+    let entries: fs.Dirent[];
+    try {
+      entries = await fs.promises.readdir(this.options.dir, { withFileTypes: true });
+    } catch {
+      return;
+    }
+    await Promise.all(
+      entries
+        .filter((e) => e.isDirectory() && e.name !== this.options.buildHash)
+        .map((e) => fs.promises.rm(path.join(this.options.dir as string, e.name), { recursive: true, force: true })),
+    );
+  }
+
+  private remember(key: string, body: Buffer): void {
+    if (body.length > this.maxBytes) return;
+    const old = this.memory.get(key);
+    if (old !== undefined) {
+      this.memory.delete(key);
+      this.memoryBytes -= old.length;
+    }
+    this.memory.set(key, body);
+    this.memoryBytes += body.length;
+    // Map iteration order is insertion order, so the first key is the least recently used.
+    for (const [k, v] of this.memory) {
+      if (this.memoryBytes <= this.maxBytes) break;
+      this.memory.delete(k);
+      this.memoryBytes -= v.length;
+    }
+  }
+
+  private async readDisk(key: string): Promise<Buffer | null> {
+    if (!this.buildDir) return null;
+    try {
+      return await fs.promises.readFile(path.join(this.buildDir, key));
+    } catch {
+      return null;
+    }
+  }
+
+  private async writeDisk(key: string, body: Buffer): Promise<void> {
+    if (!this.buildDir) return;
+    const file = path.join(this.buildDir, key);
+    // Write-then-rename so a concurrent reader never sees a partial file.
+    const tmp = `${file}.${process.pid}.tmp`;
+    try {
+      await fs.promises.mkdir(this.buildDir, { recursive: true });
+      await fs.promises.writeFile(tmp, body);
+      await fs.promises.rename(tmp, file);
+    } catch {
+      // The disk tier is best-effort (read-only image, full disk, ...).
+      await fs.promises.rm(tmp, { force: true }).catch(() => undefined);
+    }
+  }
+}
+
+// Process-wide cache. SOLVER_CACHE_DIR moves the disk tier ("off" disables it),
+// SOLVER_CACHE_MB bounds the memory tier.
+let shared: Promise<ResultCache> | undefined;
+export function getResultCache(repoRoot: string): Promise<ResultCache> {
+  if (shared) return shared;
+  shared = (async () => {
+    const dirEnv = process.env.SOLVER_CACHE_DIR;
+    const dir = dirEnv === 'off' ? null : path.resolve(repoRoot, dirEnv || 'webapp/server/cache');
+    const mb = Number(process.env.SOLVER_CACHE_MB ?? '32');
+    const cache = new ResultCache({
+      buildHash: await hashFiles(solverArtifacts(repoRoot)),
+      dir,
+      maxBytes: (Number.isFinite(mb) && mb >= 0 ? mb : 32) * 1024 * 1024,
+    });
+    await cache.pruneStaleBuilds();
+    return cache;
+  })();
+  return shared;
+}
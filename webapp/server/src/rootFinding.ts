@@ -0,0 +1,262 @@
+import path from 'path';
+import fs from 'fs';
+import { execFile, spawn, type ChildProcessWithoutNullStreams } from 'node:child_process';
+import { promisify } from 'node:util';
+import { SolverError, SolverPool } from './solverPool.js';
+import { loadNativeSolver, NATIVE_SOLVER_ERROR, rootFindingPayload } from './nativeSolver.js';
+
+// Computes one rootfinding trace with the fastest backend available:
+// in-process addon, then the worker pool, then one driver process per request.
+// Solver-side rejections surface as SolverError (HTTP 400 in the API).
+
+const execFileAsync = promisify(execFile);
+
+export type RootFindingParams = Record<string, number | boolean | string>;
+
+// A solve is killed after SOLVE_TIMEOUT_MS; the solver itself is asked to stop a
+// second earlier so it can still answer with its best iterates (see
+// nm-lib/include/utils/Cancellation.h). Not part of the cache key.
+const SOLVE_TIMEOUT_MS = 15_000;
+export const SOLVE_DEADLINE_MS = SOLVE_TIMEOUT_MS - 1_000;
+
+// Whether a result had methods stopped by the deadline. Those are partial and
+// must not be cached; the NMTC container keeps the same JSON in its metadata.
+export function stoppedEarly(body: Buffer): boolean {
+  return body.includes('"status":"deadlineExceeded"') || body.includes('"status":"cancelled"');
+}
+
+// Thrown when no backend binary exists; carries the paths that were checked.
+export class SolverUnavailableError extends Error {
+  constructor(
+    message: string,
+    readonly lookedFor: string[],
+  ) {
+    super(message);
+  }
+}
+
+// tema1_rootfinding flags for the request parameters (everything but --json/--trace).
+function driverArgs(params: RootFindingParams): string[] {
+  const args: string[] = ['--eq', String(params.eq), '--interval', String(params.interval)];
+  if (params.a !== undefined && params.b !== undefined) {
+    args.push('--a', String(params.a), '--b', String(params.b));
+  }
+  if (params.x0 !== undefined) {
+    args.push('--x0', String(params.x0));
+  }
+  if (params.eps !== undefined) {
+    args.push('--eps', String(params.eps));
+  }
+  if (params.traceMode !== undefined) {
+    args.push('--trace-mode', String(params.traceMode));
+  }
+  if (params.traceLimit !== undefined) {
+    args.push('--trace-limit', String(params.traceLimit));
+  }
+  if (params.timeoutMs !== undefined) {
+    args.push('--timeout-ms', String(params.timeoutMs));
+  }
+  return args;
+}
+
+export function driverCandidates(repoRoot: string): string[] {
+  return [
+    path.resolve(repoRoot, 'nm-lib/bin/tests/tema1_rootfinding.exe'),
+    path.resolve(repoRoot, 'nm-lib/bin/tests/tema1_rootfinding'),
+  ];
+}
+
+export function workerCandidates(repoRoot: string): string[] {
+  return [
+    path.resolve(repoRoot, 'nm-lib/bin/apps/solver_worker.exe'),
+    path.resolve(repoRoot, 'nm-lib/bin/apps/solver_worker'),
+  ];
+}
+
+// Persistent solver workers (nm-lib/bin/apps/solver_worker). When the worker
+// binary is missing the driver is run once per request instead.
+let solverPool: SolverPool | null | undefined;
+export function getSolverPool(repoRoot: string): SolverPool | null {
+  if (solverPool !== undefined) return solverPool;
+  const exePath = workerCandidates(repoRoot).find((p) => fs.existsSync(p));
+  const size = Number(process.env.SOLVER_WORKERS ?? '4');
+  solverPool = exePath ? new SolverPool(exePath, repoRoot, Number.isFinite(size) && size > 0 ? size : 4) : null;
+  return solverPool;
+}
+
+export function closeSolverPool(): void {
+  solverPool?.close();
+  solverPool = undefined;
+}
+
+export async function computeRootFinding(repoRoot: string, request: RootFindingParams): Promise<unknown> {
+  const params = { ...request, timeoutMs: SOLVE_DEADLINE_MS };
+  const native = loadNativeSolver(repoRoot);
+  if (native) {
+    try {
+      return rootFindingPayload(await native.rootFinding(params));
+    } catch (e: unknown) {
+      const code = (e as { code?: unknown })?.code;
+      if (code === NATIVE_SOLVER_ERROR || e instanceof TypeError) {
+        throw new SolverError(e instanceof Error ? e.message : String(e));
+      }
+      throw e;
+    }
+  }
+
+  const pool = getSolverPool(repoRoot);
+  if (pool) return pool.request({ kind: 'rootfinding', params }, SOLVE_TIMEOUT_MS);
+
+  const candidates = driverCandidates(repoRoot);
+  const exePath = candidates.find((p) => fs.existsSync(p));
+  if (!exePath) {
+    throw new SolverUnavailableError(
+      'Rootfinding binary not found. Build the C++ tests (VS Code task: build (tests)) so nm-lib/bin/tests/tema1_rootfinding(.exe) exists.',
+      candidates,
+    );
+  }
+
+  const args: string[] = ['--json', '--trace', ...driverArgs(params)];
+  try {
+    const { stdout } = await execFileAsync(exePath, args, {
+      cwd: repoRoot,
+      timeout: SOLVE_TIMEOUT_MS,
+      maxBuffer: 64 * 1024 * 1024,
+      windowsHide: true,
+    });
+    return JSON.parse(String(stdout ?? '').trim());
+  } catch (e: unknown) {
+    const errObj = e as { stderr?: unknown; stdout?: unknown };
+    const stderr = typeof errObj?.stderr === 'string' ? errObj.stderr : '';
+    const stdout = typeof errObj?.stdout === 'string' ? errObj.stdout : '';
+
+    const cleaned = (stderr || stdout || '').toString().trim();
+    if (cleaned) {
+      // Treat as a user/config error (bad interval, invalid eq, etc.).
+      throw new SolverError(cleaned.split('\r\n').join('\n'));
+    }
+    throw e;
+  }
+}
+
+// One batch entry: the same payload as computeRootFinding, or why that entry failed.
+export type RootFindingBatchEntry = { ok: true; result: unknown } | { ok: false; error: string };
+
+// Solves several parameter sets in one backend call (RootFindingService::solveBatch):
+// one addon job, worker request or driver process, with the sets solved in parallel.
+// Entries come back in request order; a rejected set fails only its own entry,
+// invalid parameters reject the whole batch (SolverError).
+export async function computeRootFindingBatch(repoRoot: string, requests: RootFindingParams[]): Promise<RootFindingBatchEntry[]> {
+  const list = requests.map((r) => ({ ...r, timeoutMs: SOLVE_DEADLINE_MS }));
+  const native = loadNativeSolver(repoRoot);
+  if (native?.rootFindingBatch) {
+    try {
+      const entries = await native.rootFindingBatch(list);
+      return entries.map((e) => (e.ok ? { ok: true, result: rootFindingPayload(e.result) } : e));
+    } catch (e: unknown) {
+      const code = (e as { code?: unknown })?.code;
+      if (code === NATIVE_SOLVER_ERROR || e instanceof TypeError) {
+        throw new SolverError(e instanceof Error ? e.message : String(e));
+      }
+      throw e;
+    }
+  }
+
+  const pool = getSolverPool(repoRoot);
+  if (pool) return (await pool.request({ kind: 'rootfinding.batch', params: list }, SOLVE_TIMEOUT_MS)) as RootFindingBatchEntry[];
+
+  const candidates = driverCandidates(repoRoot);
+  const exePath = candidates.find((p) => fs.existsSync(p));
+  if (!exePath) {
+    throw new SolverUnavailableError('Batch solves need the addon, the solver worker or the tema1_rootfinding binary.', candidates);
+  }
+
+  // The parameter sets go to the driver's stdin (`--batch -`).
+  const run = execFileAsync(exePath, ['--batch', '-'], {
+    cwd: repoRoot,
+    timeout: SOLVE_TIMEOUT_MS,
+    maxBuffer: 256 * 1024 * 1024,
+    windowsHide: true,
+  });
+  run.child.stdin?.end(JSON.stringify(list));
+  try {
+    const { stdout } = await run;
+    return JSON.parse(String(stdout ?? '').trim()) as RootFindingBatchEntry[];
+  } catch (e: unknown) {
+    const stderr = (e as { stderr?: unknown })?.stderr;
+    const cleaned = typeof stderr === 'string' ? stderr.trim() : '';
+    if (cleaned) throw new SolverError(cleaned.split('\r\n').join('\n'));
+    throw e;
+  }
+}
+
+// Whether computeRootFindingColumnar has a backend: the addon or the driver's
+// --columnar output (the worker protocol is line-based JSON).
+export function columnarAvailable(repoRoot: string): boolean {
+  return !!loadNativeSolver(repoRoot)?.rootFindingColumnar || driverCandidates(repoRoot).some((p) => fs.existsSync(p));
+}
+
+// The same solve as an NMTC columnar container (see nm-lib/include/utils/ColumnarTrace.h).
+export async function computeRootFindingColumnar(repoRoot: string, request: RootFindingParams): Promise<Buffer> {
+  const params = { ...request, timeoutMs: SOLVE_DEADLINE_MS };
+  const native = loadNativeSolver(repoRoot);
+  if (native?.rootFindingColumnar) {
+    try {
+      return await native.rootFindingColumnar(params);
+    } catch (e: unknown) {
+      const code = (e as { code?: unknown })?.code;
+      if (code === NATIVE_SOLVER_ERROR || e instanceof TypeError) {
+        throw new SolverError(e instanceof Error ? e.message : String(e));
+      }
+      throw e;
+    }
+  }
+
+  const candidates = driverCandidates(repoRoot);
+  const exePath = candidates.find((p) => fs.existsSync(p));
+  if (!exePath) {
+    throw new SolverUnavailableError('Columnar traces need the addon or the tema1_rootfinding binary.', candidates);
+  }
+
+  const args: string[] = ['--trace', ...driverArgs(params), '--columnar', '-'];
+  try {
+    const { stdout } = await execFileAsync(exePath, args, {
+      cwd: repoRoot,
+      timeout: SOLVE_TIMEOUT_MS,
+      maxBuffer: 64 * 1024 * 1024,
+      windowsHide: true,
+      encoding: 'buffer',
+    });
+    return stdout;
+  } catch (e: unknown) {
+    const stderr = (e as { stderr?: unknown })?.stderr;
+    const cleaned = Buffer.isBuffer(stderr) ? stderr.toString('utf8').trim() : '';
+    if (cleaned) throw new SolverError(cleaned.split('\r\n').join('\n'));
+    throw e;
+  }
+}
+
+// Starts `tema1_rootfinding --stream`: newline-delimited JSON progress records
+// on stdout while the methods run (see RootFindingService::solveStream).
+// Only the driver streams; the addon and the workers answer when the solve is
+// done. The caller owns the process and kills it when the client goes away;
+// params.timeoutMs should end the solve before the caller's own kill timer.
+export function spawnRootFindingStream(repoRoot: string, params: RootFindingParams): ChildProcessWithoutNullStreams {
+  const candidates = driverCandidates(repoRoot);
+  const exePath = candidates.find((p) => fs.existsSync(p));
+  if (!exePath) {
+    throw new SolverUnavailableError('Streaming needs the tema1_rootfinding binary.', candidates);
+  }
+  const args = ['--stream', params.trace ? '--trace' : '--no-trace', ...driverArgs(params)];
+  return spawn(exePath, args, { cwd: repoRoot, windowsHide: true });
+}
+
+// Files whose contents decide the numbers a solve produces. Any rebuild of
+// nm-lib changes at least one of them and therefore every cache key.
+export function solverArtifacts(repoRoot: string): string[] {
+  return [
+    path.resolve(repoRoot, 'webapp/native/build/Release/nmlib.node'),
+    ...workerCandidates(repoRoot),
+    ...driverCandidates(repoRoot),
+  ].filter((p) => fs.existsSync(p));
+}
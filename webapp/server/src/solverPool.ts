@@ -0,0 +1,121 @@
+import { spawn, type ChildProcessWithoutNullStreams } from 'node:child_process';
+import readline from 'node:readline';
+
+// Pool of long-lived nm-lib solver workers (nm-lib/apps/solver_worker.cpp).
+// Each worker reads one JSON request per line on stdin and answers with one
+// JSON line on stdout, so a request costs a pipe round trip instead of a
+// fork/exec of a fresh driver process.
+
+export type SolverRequest = { kind: string; params?: Record<string, unknown> | Array<Record<string, unknown>> };
+
+type WorkerResponse = { id: number; ok: boolean; result?: unknown; error?: string };
+
+type Pending = {
+  resolve: (value: unknown) => void;
+  reject: (err: Error) => void;
+  timer: ReturnType<typeof setTimeout>;
+};
+
+// Rejection for requests the solver itself refused (bad params, no bracket, ...).
+export class SolverError extends Error {}
+
+class SolverWorker {
+  private child: ChildProcessWithoutNullStreams;
+  private pending = new Map<number, Pending>();
+  alive = true;
+
+  constructor(exePath: string, cwd: string, private onExit: (w: SolverWorker) => void) {
+    this.child = spawn(exePath, [], { cwd, stdio: ['pipe', 'pipe', 'pipe'], windowsHide: true });
+
+    const rl = readline.createInterface({ input: this.child.stdout });
+    rl.on('line', (line) => this.handleLine(line));
+
+    this.child.stdin.on('error', (e) => this.fail(e));
+    this.child.stderr.on('data', () => {
+      // The worker reports errors in-band; stderr is drained so it never blocks.
+    });
+    this.child.on('exit', () => this.fail(new Error('Solver worker exited.')));
+    this.child.on('error', (e) => this.fail(e));
+  }
+
+  get inFlight(): number {
+    return this.pending.size;
+  }
+
+  send(id: number, request: SolverRequest, timeoutMs: number): Promise<unknown> {
+    return new Promise((resolve, reject) => {
+      const timer = setTimeout(() => {
+        // A solve that overran its budget may never return; replace the worker.
+        this.kill(new Error('Solver timed out.'));
+      }, timeoutMs);
+      this.pending.set(id, { resolve, reject, timer });
+      this.child.stdin.write(`${JSON.stringify({ id, ...request })}\n`);
+    });
+  }
+
+  kill(reason: Error): void {
+    this.fail(reason);
+    this.child.kill();
+  }
+
+  private handleLine(line: string): void {
+    let msg: WorkerResponse;
+    try {
+      msg = JSON.parse(line) as WorkerResponse;
+    } catch {
+      return;
+    }
+    const p = this.pending.get(msg.id);
+    if (!p) return;
+    this.pending.delete(msg.id);
+    clearTimeout(p.timer);
+    if (msg.ok) p.resolve(msg.result);
+    else p.reject(new SolverError(msg.error ?? 'Solver error.'));
+  }
+
+  private fail(reason: Error): void {
+    if (!this.alive) return;
+    this.alive = false;
+    for (const p of this.pending.values()) {
+      clearTimeout(p.timer);
+      p.reject(reason);
+    }
+    this.pending.clear();
+    this.onExit(this);
+  }
+}
+
+export class SolverPool {
+  private workers: SolverWorker[] = [];
+  private nextId = 1;
+
+  constructor(
+    private exePath: string,
+    private cwd: string,
+    private size: number,
+  ) {}
+
+  request(request: SolverRequest, timeoutMs = 15_000): Promise<unknown> {
+    return this.pick().send(this.nextId++, request, timeoutMs);
+  }
+
+  close(): void {
+    for (const w of this.workers) w.kill(new Error('Solver pool closed.'));
+    this.workers = [];
+  }
+
+  // Least-loaded worker; new workers are started lazily up to `size`.
+  private pick(): SolverWorker {
+    let best: SolverWorker | undefined;
+    for (const w of this.workers) {
+      if (!best || w.inFlight < best.inFlight) best = w;
+    }
+    if (best && (best.inFlight === 0 || this.workers.length >= this.size)) return best;
+
+    const w = new SolverWorker(this.exePath, this.cwd, (dead) => {
+      this.workers = this.workers.filter((x) => x !== dead);
+    });
+    this.workers.push(w);
+    return w;
+  }
+}
@@ -0,0 +1,50 @@
+// Builds nm-lib + src/bindings.cpp into an ES module for the client:
+//   webapp/client/public/wasm/nmlib.mjs + nmlib.wasm
+// Requires the Emscripten SDK (em++ on PATH, e.g. after `source emsdk_env.sh`).
+import { spawnSync } from 'node:child_process';
+import fs from 'node:fs';
+import path from 'node:path';
+import { fileURLToPath } from 'node:url';
+
+const here = path.dirname(fileURLToPath(import.meta.url));
+const nmLib = path.resolve(here, '../../nm-lib');
+const outDir = path.resolve(here, '../client/public/wasm');
+
+const libDirs = ['core', 'linear', 'nonlinear', 'service', 'utils'];
+const sources = [path.join(here, 'src/bindings.cpp')];
+for (const dir of libDirs) {
+  const full = path.join(nmLib, 'src', dir);
+  for (const f of fs.readdirSync(full)) {
+    if (f.endsWith('.cpp')) sources.push(path.join(full, f));
+  }
+}
+
+fs.mkdirSync(outDir, { recursive: true });
+
+const args = [
+  '-std=c++17',
+  '-O3',
+  '-msimd128', // WebAssembly SIMD128: lets the compiler vectorize the matrix loops
+  '-fexceptions', // the library reports errors with exceptions
+  // No -pthread: the module is single-threaded, and bindings.cpp rejects the
+  // parallel/race root-finding modes that would need a ThreadPool.
+  `-I${path.join(nmLib, 'include')}`,
+  `-I${path.join(nmLib, 'src')}`,
+  '-lembind',
+  '-sMODULARIZE=1',
+  '-sEXPORT_ES6=1',
+  '-sEXPORT_NAME=createNmLib',
+  '-sENVIRONMENT=web,node',
+  '-sALLOW_MEMORY_GROWTH=1',
+  '-o',
+  path.join(outDir, 'nmlib.mjs'),
+  ...sources,
+];
+
+const em = process.platform === 'win32' ? 'em++.bat' : 'em++';
+const r = spawnSync(em, args, { stdio: 'inherit' });
+if (r.error) {
+  console.error(`Failed to run ${em}: ${r.error.message}. Is the Emscripten SDK activated?`);
+  process.exit(1);
+}
+process.exit(r.status ?? 1);
@@ -0,0 +1,68 @@
+// Node smoke test for the WASM build: runs the real solvers and compares them
+// with the native tema1 driver output when that binary is available.
+import { execFileSync } from 'node:child_process';
+import fs from 'node:fs';
+import path from 'node:path';
+import { fileURLToPath, pathToFileURL } from 'node:url';
+
+const here = path.dirname(fileURLToPath(import.meta.url));
+const modPath = path.resolve(here, '../client/public/wasm/nmlib.mjs');
+if (!fs.existsSync(modPath)) {
+  console.error('WASM module not built. Run `npm run build:wasm` first.');
+  process.exit(1);
+}
+
+const { default: createNmLib } = await import(pathToFileURL(modPath).href);
+const nm = await createNmLib();
+
+const driver = ['tema1_rootfinding', 'tema1_rootfinding.exe']
+  .map((n) => path.resolve(here, '../../nm-lib/bin/tests', n))
+  .find((p) => fs.existsSync(p));
+
+let failures = 0;
+for (const eq of [1, 2, 3, 4]) {
+  for (const interval of [1, 2]) {
+    const r = JSON.parse(nm.solveRootFinding(JSON.stringify({ eq, interval, trace: true })));
+    if (!r.ok) {
+      console.error(`FAIL: eq ${eq} interval ${interval}: ${r.error}`);
+      failures++;
+      continue;
+    }
+    if (driver) {
+      const expected = JSON.parse(
+        execFileSync(driver, ['--json', '--trace', '--eq', String(eq), '--interval', String(interval)]).toString(),
+      );
+      for (let i = 0; i < expected.methods.length; i++) {
+        // libm differs between glibc and the WASM runtime, so allow a few ulps.
+        const want = expected.methods[i].x;
+        const got = r.result.methods[i].x;
+        if (Math.abs(want - got) > 1e-12 * Math.max(1, Math.abs(want))) {
+          console.error(`FAIL: eq ${eq} interval ${interval} ${expected.methods[i].name}: ${got} != ${want}`);
+          failures++;
+        }
+      }
+    }
+    console.log(`OK: eq ${eq} interval ${interval}`);
+  }
+}
+
+const raced = JSON.parse(nm.solveRootFinding(JSON.stringify({ eq: 1, interval: 1, mode: 'race' })));
+if (raced.ok || !/sequential/.test(raced.error)) {
+  console.error('FAIL: race mode should be rejected by the single-threaded build');
+  failures++;
+}
+
+const ys = nm.evalEquation(3, new Float64Array([0, 1]));
+if (ys[0] !== 1 || Math.abs(ys[1] - (Math.E - 3)) > 1e-15) {
+  console.error('FAIL: evalEquation');
+  failures++;
+}
+
+const gs = nm.gaussSeidel(new Float64Array([4, 1, 1, 3]), new Float64Array([1, 2]), new Float64Array(2), 50);
+if (gs.error || Math.abs(4 * gs.x[0] + gs.x[1] - 1) > 1e-12) {
+  console.error('FAIL: gaussSeidel');
+  failures++;
+}
+
+if (failures) process.exit(1);
+console.log('All WASM checks passed.');
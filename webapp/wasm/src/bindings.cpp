@@ -0,0 +1,187 @@
+// Emscripten bindings for running nm-lib in the browser / Node.
+//
+// The module is built by webapp/wasm/build.mjs into webapp/client/public/wasm/
+// (nmlib.mjs + nmlib.wasm) and wrapped by client/src/features/rootfinding/wasm.ts.
+//
+//   solveRootFinding(paramsJson)     -> JSON string { ok, result | error }, same
+//                                       payload as /api/rootfinding/trace; only
+//                                       mode "sequential" (see below)
+//   evalEquation(eq, xs)             -> Float64Array of f(x) for course equation eq
+//   gaussianElimination(A, b, t)     -> { x } | { error }
+//   jacobi(A, b, x0, iterations)     -> { x } | { error }
+//   gaussSeidel(A, b, x0, iterations)-> { x } | { error }
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+
+#include "NumericalMethods.h"
+
+#include "service/RootFindingService.h"
+#include "utils/JsonWriter.h"
+
+#include "nlohmann/json.hpp"
+
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using emscripten::val;
+using nlohmann::json;
+
+static std::vector<double> toDoubles(const val& arr)
+{
+    return emscripten::convertJSArrayToNumberVector<double>(arr);
+}
+
+static val toFloat64Array(const std::vector<double>& v)
+{
+    val out = val::global("Float64Array").new_(v.size());
+    out.call<void>("set", val(emscripten::typed_memory_view(v.size(), v.data())));
+    return out;
+}
+
+static val toFloat64Array(const Vector& v)
+{
+    std::vector<double> tmp(v.size());
+    for (std::size_t i = 0; i < v.size(); i++)
+    {
+        tmp[i] = v[i];
+    }
+    return toFloat64Array(tmp);
+}
+
+static LinearSystem toLinearSystem(const std::vector<double>& a, const std::vector<double>& b)
+{
+    const std::size_t n = b.size();
+    if (n == 0 || a.size() != n * n)
+    {
+        throw std::invalid_argument("Invalid system. A must have length n*n where n = b.length > 0.");
+    }
+    Matrix A(n, n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        for (std::size_t j = 0; j < n; j++)
+        {
+            A(i, j) = a[i * n + j];
+        }
+    }
+    Vector rhs(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        rhs[i] = b[i];
+    }
+    return LinearSystem(A, rhs);
+}
+
+static val errorObject(const char* message)
+{
+    val out = val::object();
+    out.set("error", std::string(message));
+    return out;
+}
+
+static std::string solveRootFinding(const std::string& paramsJson)
+{
+    try
+    {
+        const json params = json::parse(paramsJson);
+        const RootFindingRequest request = RootFindingService::parseRequest(params);
+        // The module is built without -pthread, so the ThreadPool of the
+        // parallel and race modes could only fail when its first thread is
+        // created. Reject them up front; the server still offers both.
+        if (request.mode != RootFindingMode::Sequential)
+        {
+            throw std::invalid_argument("mode \"parallel\" and \"race\" need threads, which the WebAssembly build does not have; use mode \"sequential\"");
+        }
+
+        std::ostringstream out;
+        out << "{\"ok\":true,\"result\":";
+        {
+            JsonWriter w(out);
+            RootFindingService::solve(request, w);
+        }
+        out << "}";
+        return out.str();
+    }
+    catch (const std::exception& e)
+    {
+        return json{ { "ok", false }, { "error", e.what() } }.dump();
+    }
+}
+
+static val evalEquation(int eq, const val& xs)
+{
+    const RootFindingProblem problem = RootFindingService::problem(eq, 1);
+    std::vector<double> values = toDoubles(xs);
+    for (double& x : values)
+    {
+        x = problem.f(x);
+    }
+    return toFloat64Array(values);
+}
+
+static val gaussianElimination(const val& a, const val& b, int significantDigits)
+{
+    try
+    {
+        const Vector x = GaussianElimination::solve(toLinearSystem(toDoubles(a), toDoubles(b)), significantDigits);
+        val out = val::object();
+        out.set("x", toFloat64Array(x));
+        return out;
+    }
+    catch (const std::exception& e)
+    {
+        return errorObject(e.what());
+    }
+}
+
+static val jacobi(const val& a, const val& b, const val& x0, int iterations)
+{
+    try
+    {
+        const std::vector<double> start = toDoubles(x0);
+        Vector x(start.size());
+        for (std::size_t i = 0; i < start.size(); i++)
+        {
+            x[i] = start[i];
+        }
+        val out = val::object();
+        out.set("x", toFloat64Array(JacobiSolver::iterate(toLinearSystem(toDoubles(a), toDoubles(b)), x, static_cast<std::size_t>(iterations))));
+        return out;
+    }
+    catch (const std::exception& e)
+    {
+        return errorObject(e.what());
+    }
+}
+
+static val gaussSeidel(const val& a, const val& b, const val& x0, int iterations)
+{
+    try
+    {
+        const std::vector<double> start = toDoubles(x0);
+        Vector x(start.size());
+        for (std::size_t i = 0; i < start.size(); i++)
+        {
+            x[i] = start[i];
+        }
+        val out = val::object();
+        out.set("x", toFloat64Array(GaussSeidelSolver::iterate(toLinearSystem(toDoubles(a), toDoubles(b)), x, static_cast<std::size_t>(iterations))));
+        return out;
+    }
+    catch (const std::exception& e)
+    {
+        return errorObject(e.what());
+    }
+}
+
+EMSCRIPTEN_BINDINGS(nmlib)
+{
+    emscripten::function("solveRootFinding", &solveRootFinding);
+    emscripten::function("evalEquation", &evalEquation);
+    emscripten::function("gaussianElimination", &gaussianElimination);
+    emscripten::function("jacobi", &jacobi);
+    emscripten::function("gaussSeidel", &gaussSeidel);
+}